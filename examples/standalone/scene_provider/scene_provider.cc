@@ -16,17 +16,54 @@
 */
 
 #include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <string>
+#include <vector>
 #include <gz/math/Rand.hh>
+#include <gz/msgs/bytes.pb.h>
 #include <gz/msgs/pose_v.pb.h>
 #include <gz/msgs/scene.pb.h>
 #include <gz/msgs/scene.pb.h>
+#include <gz/msgs/uint32_v.pb.h>
 #include <gz/msgs/world_stats.pb.h>
 #include <gz/transport/Node.hh>
 
+#include <gz/gui/PackedPoses.hh>
+#include <gz/gui/PagedScene.hh>
+
 using namespace std::chrono_literals;
 
+/// \brief Number of box models in the scene
+static unsigned int modelCount{1u};
+
+/// \brief Whole scene, split into pages by the paged scene service
+static gz::msgs::Scene pagedScene;
+
+//////////////////////////////////////////////////
+/// \brief Publish poses in the packed format understood by the
+/// TransportSceneManager's <packed_pose_topic>.
+/// \param[in] _pub Publisher of msgs::Bytes
+/// \param[in] _ids Entity ids
+/// \param[in] _positions Positions, 3 values per entity
+/// \param[in] _orientations Orientations, 4 values (W, X, Y, Z) per entity
+/// \param[in] _stamp Time stamp
+/// \param[in, out] _msg Message reused across calls to avoid allocations
+template <typename T>
+void publishPackedPoses(gz::transport::Node::Publisher &_pub,
+    const std::vector<uint32_t> &_ids, const std::vector<T> &_positions,
+    const std::vector<T> &_orientations,
+    const std::chrono::steady_clock::duration &_stamp, gz::msgs::Bytes &_msg)
+{
+  auto s = std::chrono::duration_cast<std::chrono::seconds>(_stamp);
+  auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(_stamp - s);
+  gz::gui::PackedPoses::Encode(_ids.data(), _positions.data(),
+      _orientations.data(), static_cast<uint32_t>(_ids.size()), s.count(),
+      static_cast<int32_t>(ns.count()), *_msg.mutable_data());
+  _pub.Publish(_msg);
+}
+
 //////////////////////////////////////////////////
 bool sceneService(gz::msgs::Scene &_rep)
 {
@@ -66,17 +103,78 @@ bool sceneService(gz::msgs::Scene &_rep)
   boxSize->set_y(2.0);
   boxSize->set_z(3.0);
 
+  // Extra boxes for benchmarking, laid out on a grid
+  for (unsigned int i = 1; i < modelCount; ++i)
+  {
+    auto extraModelMsg = _rep.add_model();
+    extraModelMsg->set_id(1 + i * 3);
+    extraModelMsg->set_name("box_model_" + std::to_string(i));
+
+    auto extraPosMsg = extraModelMsg->mutable_pose()->mutable_position();
+    extraPosMsg->set_x(2.0 * (i % 100));
+    extraPosMsg->set_y(2.0 * (i / 100) + 5.0);
+
+    auto extraLinkMsg = extraModelMsg->add_link();
+    extraLinkMsg->set_id(2 + i * 3);
+    extraLinkMsg->set_name("box_link_" + std::to_string(i));
+
+    auto extraVisMsg = extraLinkMsg->add_visual();
+    extraVisMsg->set_id(3 + i * 3);
+    extraVisMsg->set_name("box_vis_" + std::to_string(i));
+    auto extraSize =
+        extraVisMsg->mutable_geometry()->mutable_box()->mutable_size();
+    extraSize->set_x(0.5);
+    extraSize->set_y(0.5);
+    extraSize->set_z(0.5);
+  }
+
   return true;
 }
 
+//////////////////////////////////////////////////
+bool pagedSceneService(const gz::msgs::UInt32_V &_req, gz::msgs::Scene &_rep)
+{
+  std::cout << "Returning scene page at offset "
+            << (_req.data_size() > 0 ? _req.data(0) : 0u) << std::endl;
+  return gz::gui::PagedScene::Page(pagedScene, _req, _rep);
+}
+
 //////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
+  // Usage: scene_provider [--packed] [--paged] [--models <count>]
+  bool packed{false};
+  bool paged{false};
+  for (int i = 1; i < argc; ++i)
+  {
+    if (std::strcmp(argv[i], "--packed") == 0)
+    {
+      packed = true;
+    }
+    else if (std::strcmp(argv[i], "--paged") == 0)
+    {
+      paged = true;
+    }
+    else if (std::strcmp(argv[i], "--models") == 0 && i + 1 < argc)
+    {
+      const int count = std::atoi(argv[++i]);
+      modelCount = count > 0 ? static_cast<unsigned int>(count) : 1u;
+    }
+  }
+
   gz::transport::Node node;
 
   // Scene service
   node.Advertise("/example/scene", sceneService);
 
+  // Same scene, served in pages
+  if (paged)
+  {
+    sceneService(pagedScene);
+    node.Advertise(gz::gui::PagedScene::Service("/example/scene"),
+        pagedSceneService);
+  }
+
   // Periodic pose updated
   auto statsPub =
     node.Advertise<gz::msgs::WorldStatistics>("/example/stats");
@@ -84,11 +182,26 @@ int main(int argc, char **argv)
   // Periodic pose updated
   auto posePub = node.Advertise<gz::msgs::Pose_V>("/example/pose");
 
+  // Same poses, packed into a single blob
+  auto packedPosePub =
+    node.Advertise<gz::msgs::Bytes>("/example/packed_pose");
+
   gz::msgs::Pose_V poseVMsg;
-  auto poseMsg = poseVMsg.add_pose();
-  poseMsg->set_id(1);
-  poseMsg->set_name("box_model");
-  auto positionMsg = poseMsg->mutable_position();
+  gz::msgs::Bytes packedMsg;
+  std::vector<uint32_t> ids;
+  std::vector<float> positions;
+  std::vector<float> orientations;
+  for (unsigned int i = 0; i < modelCount; ++i)
+  {
+    auto poseMsg = poseVMsg.add_pose();
+    poseMsg->set_id(1 + i * 3);
+    poseMsg->set_name(i == 0 ? "box_model" : "box_model_" + std::to_string(i));
+
+    ids.push_back(1 + i * 3);
+    positions.insert(positions.end(),
+        {2.0f * (i % 100), 2.0f * (i / 100) + 5.0f, 0.0f});
+    orientations.insert(orientations.end(), {1.0f, 0.0f, 0.0f, 0.0f});
+  }
 
   const double change{0.1};
 
@@ -108,12 +221,33 @@ int main(int argc, char **argv)
     y += gz::math::Rand::DblUniform(-change, change);
     z += gz::math::Rand::DblUniform(-change, change);
 
-    positionMsg->set_x(x);
-    positionMsg->set_y(y);
-    positionMsg->set_z(z);
-    posePub.Publish(poseVMsg);
+    // The first box wanders around, the others bob up and down
+    positions[0] = static_cast<float>(x);
+    positions[1] = static_cast<float>(y);
+    positions[2] = static_cast<float>(z);
+    for (unsigned int i = 1; i < modelCount; ++i)
+      positions[i * 3 + 2] = static_cast<float>(
+          z * (static_cast<int>(i % 7) - 3));
 
     timePoint += 100ms;
+
+    if (packed)
+    {
+      publishPackedPoses(packedPosePub, ids, positions, orientations,
+          timePoint, packedMsg);
+    }
+    else
+    {
+      for (unsigned int i = 0; i < modelCount; ++i)
+      {
+        auto positionMsg = poseVMsg.mutable_pose(i)->mutable_position();
+        positionMsg->set_x(positions[i * 3]);
+        positionMsg->set_y(positions[i * 3 + 1]);
+        positionMsg->set_z(positions[i * 3 + 2]);
+      }
+      posePub.Publish(poseVMsg);
+    }
+
     msgWorldStatistics.set_real_time_factor(1);
 
     auto s = std::chrono::duration_cast<std::chrono::seconds>(timePoint);
@@ -27,6 +27,7 @@
 #include <gz/common/MouseEvent.hh>
 #include <gz/math/Vector2.hh>
 #include <gz/math/Vector3.hh>
+#include <gz/msgs/marker.pb.h>
 #include <gz/msgs/world_control.pb.h>
 #include <gz/utils/ImplPtr.hh>
 
@@ -486,6 +487,39 @@ namespace ignition
         /// \brief Private data pointer
         IGN_UTILS_IMPL_PTR(dataPtr)
       };
+
+      /// \brief Event which hands a marker message to the MarkerManager
+      /// plugin of the same process, without serializing it and sending it
+      /// through the marker service. It should be sent to the main window.
+      ///
+      /// The event starts ignored, and is accepted by the MarkerManager
+      /// serving the event's topic, which queues the marker. Senders can check isAccepted() after
+      /// sending it, and fall back to the marker service when no
+      /// MarkerManager is loaded.
+      class IGNITION_GUI_VISIBLE MarkerRequest : public QEvent
+      {
+        /// \brief Constructor
+        /// \param[in] _marker Marker message, as sent to the marker service
+        /// \param[in] _topic Marker service the message is meant for, such
+        /// as "/marker"
+        public: MarkerRequest(const msgs::Marker &_marker,
+                              const std::string &_topic);
+
+        /// \brief Unique type for this event.
+        static const QEvent::Type kType = QEvent::Type(QEvent::MaxUser - 21);
+
+        /// \brief Get the marker message
+        /// \return The marker message
+        public: const msgs::Marker &Marker() const;
+
+        /// \brief Get the marker service the message is meant for
+        /// \return The marker service name
+        public: const std::string &Topic() const;
+
+        /// \internal
+        /// \brief Private data pointer
+        IGN_UTILS_IMPL_PTR(dataPtr)
+      };
     }
   }
 }
@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PACKEDPOSES_HH_
+#define GZ_GUI_PACKEDPOSES_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GZ_GUI_PACKEDPOSES_SSE2
+#endif
+
+#include "gz/gui/PoseFrame.hh"
+
+namespace ignition
+{
+namespace gui
+{
+  /// \brief Encoding of many entity poses into a single blob, which is
+  /// much cheaper to decode than a msgs::Pose_V with one submessage per
+  /// pose. The blob is sent as the data of a msgs::Bytes.
+  ///
+  /// All values are little endian, and big endian hosts swap their bytes
+  /// when encoding and decoding. The blob holds, in order:
+  ///
+  /// * A 32 byte header: the "GZPP" magic, a uint16 version, uint16 flags,
+  ///   a uint32 pose count, 4 reserved bytes, and the stamp as int64
+  ///   seconds and int32 nanoseconds followed by 4 padding bytes.
+  /// * The uint32 entity ids, padded with zeros to a multiple of 8 bytes.
+  /// * The positions, 3 values (X, Y, Z) per entity.
+  /// * The orientations, 4 values (W, X, Y, Z) per entity.
+  ///
+  /// Positions and orientations are float64 if the kDoublePrecision flag is
+  /// set, and float32 otherwise.
+  class PackedPoses
+  {
+    /// \brief Current format version.
+    public: static constexpr uint16_t kVersion = 1u;
+
+    /// \brief Flag set when values are float64.
+    public: static constexpr uint16_t kDoublePrecision = 0x1u;
+
+    /// \brief Size of the header in bytes.
+    public: static constexpr std::size_t kHeaderSize = 32u;
+
+    /// \brief Size of an encoded blob.
+    /// \param[in] _count Number of poses.
+    /// \param[in] _doublePrecision True for float64 values.
+    /// \return Size in bytes.
+    public: static std::size_t Size(const std::size_t _count,
+        const bool _doublePrecision)
+    {
+      return kHeaderSize + IdsSize(_count) +
+          _count * 7u * (_doublePrecision ? 8u : 4u);
+    }
+
+    /// \brief Encode poses.
+    /// \param[in] _ids Entity ids.
+    /// \param[in] _positions Positions, 3 values per entity.
+    /// \param[in] _orientations Orientations, 4 values (W, X, Y, Z) per
+    /// entity.
+    /// \param[in] _count Number of poses.
+    /// \param[in] _sec Stamp seconds.
+    /// \param[in] _nsec Stamp nanoseconds.
+    /// \param[out] _out Encoded blob.
+    /// \tparam T float or double.
+    public: template <typename T>
+    static void Encode(const uint32_t *_ids, const T *_positions,
+        const T *_orientations, const uint32_t _count, const int64_t _sec,
+        const int32_t _nsec, std::string &_out)
+    {
+      static_assert(std::is_same<T, float>::value ||
+          std::is_same<T, double>::value, "Values must be float or double");
+      const bool doublePrecision = std::is_same<T, double>::value;
+
+      _out.assign(Size(_count, doublePrecision), '\0');
+      char *data = &_out[0];
+
+      const uint16_t flags = doublePrecision ? kDoublePrecision : 0u;
+      std::memcpy(data, "GZPP", 4u);
+      Copy(data + 4, &kVersion, 1u, 2u);
+      Copy(data + 6, &flags, 1u, 2u);
+      Copy(data + 8, &_count, 1u, 4u);
+      Copy(data + 16, &_sec, 1u, 8u);
+      Copy(data + 24, &_nsec, 1u, 4u);
+      data += kHeaderSize;
+
+      Copy(data, _ids, _count, sizeof(uint32_t));
+      data += IdsSize(_count);
+
+      Copy(data, _positions, _count * 3u, sizeof(T));
+      data += _count * 3u * sizeof(T);
+
+      Copy(data, _orientations, _count * 4u, sizeof(T));
+    }
+
+    /// \brief Decode poses into a frame, replacing its contents.
+    /// \param[in] _data Encoded blob.
+    /// \param[in] _size Size of the blob in bytes.
+    /// \param[out] _frame Decoded poses.
+    /// \return False if the blob is malformed, in which case the frame is
+    /// left unchanged.
+    public: static bool Decode(const char *_data, const std::size_t _size,
+        PoseFrame &_frame)
+    {
+      if (_size < kHeaderSize || std::memcmp(_data, "GZPP", 4u) != 0)
+        return false;
+
+      uint16_t version;
+      uint16_t flags;
+      uint32_t count;
+      int64_t sec;
+      int32_t nsec;
+      Copy(&version, _data + 4, 1u, 2u);
+      Copy(&flags, _data + 6, 1u, 2u);
+      Copy(&count, _data + 8, 1u, 4u);
+      Copy(&sec, _data + 16, 1u, 8u);
+      Copy(&nsec, _data + 24, 1u, 4u);
+
+      const bool doublePrecision = (flags & kDoublePrecision) != 0u;
+      if (version != kVersion || _size != Size(count, doublePrecision))
+        return false;
+
+      _frame.Resize(count);
+      _frame.hasStamp = true;
+      _frame.stamp = std::chrono::seconds(sec) +
+          std::chrono::nanoseconds(nsec);
+      const char *data = _data + kHeaderSize;
+
+      Copy(_frame.ids.data(), data, count, sizeof(uint32_t));
+      data += IdsSize(count);
+
+      if (doublePrecision)
+      {
+        Copy(_frame.positions.data(), data, count * 3u, 8u);
+        data += count * 3u * 8u;
+        Copy(_frame.orientations.data(), data, count * 4u, 8u);
+      }
+      else
+      {
+        Widen(data, count * 3u, _frame.positions.data());
+        data += count * 3u * 4u;
+        Widen(data, count * 4u, _frame.orientations.data());
+      }
+      return true;
+    }
+
+    /// \brief Size of the id array, including padding.
+    /// \param[in] _count Number of poses.
+    /// \return Size in bytes.
+    private: static std::size_t IdsSize(const std::size_t _count)
+    {
+      return (_count * sizeof(uint32_t) + 7u) & ~std::size_t(7u);
+    }
+
+    /// \brief Check whether the host is little endian, like the blob.
+    /// \return True on little endian hosts.
+    private: static bool LittleEndianHost()
+    {
+      const uint16_t one = 1u;
+      unsigned char first;
+      std::memcpy(&first, &one, 1u);
+      return first == 1u;
+    }
+
+    /// \brief Copy values between the blob and the host, swapping the
+    /// bytes of each value on big endian hosts.
+    /// \param[out] _dst Destination.
+    /// \param[in] _src Source.
+    /// \param[in] _count Number of values.
+    /// \param[in] _width Size of each value in bytes.
+    private: static void Copy(void *_dst, const void *_src,
+        const std::size_t _count, const std::size_t _width)
+    {
+      // Empty arrays may be null
+      if (_count == 0u)
+        return;
+
+      std::memcpy(_dst, _src, _count * _width);
+      if (LittleEndianHost())
+        return;
+
+      auto bytes = static_cast<unsigned char *>(_dst);
+      for (std::size_t i = 0u; i < _count; ++i)
+        std::reverse(bytes + i * _width, bytes + (i + 1u) * _width);
+    }
+
+    /// \brief Convert float32 values to float64.
+    /// \param[in] _src Unaligned float32 values.
+    /// \param[in] _count Number of values.
+    /// \param[out] _dst Converted values.
+    private: static void Widen(const char *_src, const std::size_t _count,
+        double *_dst)
+    {
+      std::size_t i = 0u;
+#ifdef GZ_GUI_PACKEDPOSES_SSE2
+      // Four floats per iteration, two converted per instruction. SSE2
+      // hosts are little endian.
+      for (; i + 4u <= _count; i += 4u)
+      {
+        const __m128 values = _mm_loadu_ps(
+            reinterpret_cast<const float *>(_src + i * 4u));
+        _mm_storeu_pd(_dst + i, _mm_cvtps_pd(values));
+        _mm_storeu_pd(_dst + i + 2u,
+            _mm_cvtps_pd(_mm_movehl_ps(values, values)));
+      }
+#endif
+      for (; i < _count; ++i)
+      {
+        float value;
+        Copy(&value, _src + i * 4u, 1u, 4u);
+        _dst[i] = value;
+      }
+    }
+  };
+}
+}
+
+#endif
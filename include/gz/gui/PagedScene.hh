@@ -0,0 +1,284 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PAGEDSCENE_HH_
+#define GZ_GUI_PAGEDSCENE_HH_
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include <gz/msgs/empty.pb.h>
+#include <gz/msgs/scene.pb.h>
+#include <gz/msgs/uint32_v.pb.h>
+#include <gz/transport/Node.hh>
+
+namespace ignition
+{
+namespace gui
+{
+  /// \brief Protocol to fetch a scene in pages, so that huge worlds don't
+  /// have to fit in a single service reply, and clients can start loading
+  /// models as soon as the first page arrives.
+  ///
+  /// The paged service is advertised next to the regular scene service,
+  /// with the name returned by Service(). Its request is a msgs::UInt32_V
+  /// holding the offset of the first model and the maximum number of
+  /// models to return. Its reply is a msgs::Scene with those models. The
+  /// reply to the page at offset 0 also holds the lights and all other
+  /// scene properties. Every reply has the total number of models in the
+  /// header data, under kTotalKey.
+  class PagedScene
+  {
+    /// \brief Header data key holding the total number of models.
+    public: static constexpr const char *kTotalKey = "total_models";
+
+    /// \brief Get the paged service name for a scene service.
+    /// \param[in] _service Scene service name.
+    /// \return Paged scene service name.
+    public: static std::string Service(const std::string &_service)
+    {
+      return _service + "/paged";
+    }
+
+    /// \brief Fill the reply of the paged service, for servers.
+    /// \param[in] _scene Whole scene.
+    /// \param[in] _req Request holding the offset and count.
+    /// \param[out] _rep Requested page.
+    /// \return False if the request is malformed.
+    public: static bool Page(const msgs::Scene &_scene,
+        const msgs::UInt32_V &_req, msgs::Scene &_rep)
+    {
+      if (_req.data_size() != 2)
+        return false;
+
+      _rep.Clear();
+      const int total = _scene.model_size();
+      const int offset = static_cast<int>(
+          std::min<uint32_t>(_req.data(0), static_cast<uint32_t>(total)));
+      const int end = offset + static_cast<int>(std::min<uint32_t>(
+          _req.data(1), static_cast<uint32_t>(total - offset)));
+
+      // Everything but the models goes in the first page
+      if (offset == 0)
+      {
+        if (_scene.has_header())
+          *_rep.mutable_header() = _scene.header();
+        if (_scene.has_ambient())
+          *_rep.mutable_ambient() = _scene.ambient();
+        if (_scene.has_background())
+          *_rep.mutable_background() = _scene.background();
+        if (_scene.has_sky())
+          *_rep.mutable_sky() = _scene.sky();
+        if (_scene.has_fog())
+          *_rep.mutable_fog() = _scene.fog();
+        _rep.set_shadows(_scene.shadows());
+        _rep.set_grid(_scene.grid());
+        _rep.set_origin_visual(_scene.origin_visual());
+        *_rep.mutable_light() = _scene.light();
+        *_rep.mutable_joint() = _scene.joint();
+      }
+      _rep.set_name(_scene.name());
+
+      _rep.mutable_model()->Reserve(end - offset);
+      for (int i = offset; i < end; ++i)
+        *_rep.add_model() = _scene.model(i);
+
+      auto data = _rep.mutable_header()->add_data();
+      data->set_key(kTotalKey);
+      data->add_value(std::to_string(total));
+      return true;
+    }
+
+    /// \brief Get the total number of models from a page.
+    /// \param[in] _page Page received from the paged service.
+    /// \param[out] _total Total number of models.
+    /// \return False if the page doesn't hold the total.
+    public: static bool Total(const msgs::Scene &_page, uint32_t &_total)
+    {
+      for (const auto &data : _page.header().data())
+      {
+        if (data.key() != kTotalKey || data.value_size() != 1)
+          continue;
+        try
+        {
+          _total = static_cast<uint32_t>(std::stoul(data.value(0)));
+          return true;
+        }
+        catch (const std::exception &)
+        {
+          return false;
+        }
+      }
+      return false;
+    }
+
+    /// \brief Fetch all pages of a scene, for clients. Blocks until all
+    /// pages are received, a request fails or times out, the callback stops
+    /// it, or it's cancelled. Pages are requested asynchronously, so that
+    /// cancellation is noticed within kCancelPollInterval instead of after
+    /// the request timeout.
+    /// \param[in] _node Node used to make the requests.
+    /// \param[in] _service Paged scene service name.
+    /// \param[in] _pageSize Maximum number of models per page.
+    /// \param[in] _timeout Timeout of each request in milliseconds.
+    /// \param[in] _onPage Called with each page as soon as it's received,
+    /// and whether it's the last one. Returns false to stop fetching.
+    /// \param[in] _cancelled Polled while waiting for each page, returns
+    /// true to stop fetching. Optional.
+    /// \return True if all pages were received.
+    public: static bool Fetch(transport::Node &_node,
+        const std::string &_service, const uint32_t _pageSize,
+        const unsigned int _timeout,
+        const std::function<bool(msgs::Scene &&, bool)> &_onPage,
+        const std::function<bool()> &_cancelled = nullptr)
+    {
+      uint32_t offset{0u};
+      while (true)
+      {
+        msgs::UInt32_V req;
+        req.add_data(offset);
+        req.add_data(std::max(_pageSize, 1u));
+
+        auto page = std::make_shared<msgs::Scene>();
+        uint32_t total;
+        if (!Call(_node, _service, req, _timeout, _cancelled, page) ||
+            !Total(*page, total))
+        {
+          return false;
+        }
+
+        // An empty page ends the scene even if the total is off, e.g. if
+        // models were removed while paging
+        offset += static_cast<uint32_t>(page->model_size());
+        const bool last = offset >= total || page->model_size() == 0;
+        if (!_onPage(std::move(*page), last))
+          return false;
+        if (last)
+          return true;
+      }
+    }
+
+    /// \brief Fetch a whole scene from a regular scene service, for clients
+    /// of servers which don't advertise the paged one. Blocks like Fetch,
+    /// and is cancellable the same way.
+    /// \param[in] _node Node used to make the request.
+    /// \param[in] _service Scene service name.
+    /// \param[in] _timeout Timeout of the request in milliseconds.
+    /// \param[out] _scene Filled with the reply, e.g. a message allocated on
+    /// an arena. Only valid if true is returned.
+    /// \param[in] _cancelled Polled while waiting for the reply, returns
+    /// true to stop waiting. Optional.
+    /// \return True if the scene was received.
+    public: static bool FetchWhole(transport::Node &_node,
+        const std::string &_service, const unsigned int _timeout,
+        const std::shared_ptr<msgs::Scene> &_scene,
+        const std::function<bool()> &_cancelled = nullptr)
+    {
+      return Call(_node, _service, msgs::Empty(), _timeout, _cancelled,
+          _scene);
+    }
+
+    /// \brief Longest time Fetch and FetchWhole wait before checking for
+    /// cancellation.
+    public: static constexpr std::chrono::milliseconds
+        kCancelPollInterval{50};
+
+    /// \brief Request a scene asynchronously and wait for the reply,
+    /// checking for cancellation every kCancelPollInterval.
+    /// \param[in] _node Node used to make the request.
+    /// \param[in] _service Service name.
+    /// \param[in] _req Request.
+    /// \param[in] _timeout Timeout in milliseconds.
+    /// \param[in] _cancelled Returns true to stop waiting. Optional.
+    /// \param[out] _rep Filled with the reply.
+    /// \return True if a successful reply was received.
+    private: template <typename T>
+    static bool Call(transport::Node &_node, const std::string &_service,
+        const T &_req, const unsigned int _timeout,
+        const std::function<bool()> &_cancelled,
+        const std::shared_ptr<msgs::Scene> &_rep)
+    {
+      // The reply is shared with the callback, which may still run after
+      // a cancelled or timed out request returned
+      auto reply = std::make_shared<Reply>();
+      reply->rep = _rep;
+      std::function<void(const msgs::Scene &, const bool)> cb =
+          [reply](const msgs::Scene &_msg, const bool _result)
+          {
+            {
+              std::lock_guard<std::mutex> lock(reply->mutex);
+              if (_result)
+                reply->rep->CopyFrom(_msg);
+              reply->result = _result;
+              reply->done = true;
+            }
+            reply->cv.notify_all();
+          };
+      if (!_node.Request(_service, _req, cb))
+        return false;
+
+      const auto deadline = std::chrono::steady_clock::now() +
+          std::chrono::milliseconds(_timeout);
+      while (true)
+      {
+        {
+          std::unique_lock<std::mutex> lock(reply->mutex);
+          if (reply->cv.wait_for(lock, kCancelPollInterval,
+              [&reply] { return reply->done; }))
+          {
+            return reply->result;
+          }
+        }
+        if ((_cancelled && _cancelled()) ||
+            std::chrono::steady_clock::now() >= deadline)
+        {
+          return false;
+        }
+      }
+    }
+
+    /// \brief Reply to a request, filled by the request callback.
+    private: struct Reply
+    {
+      /// \brief Protects the other members.
+      std::mutex mutex;
+
+      /// \brief Notified once the reply is received.
+      std::condition_variable cv;
+
+      /// \brief True once the reply is received.
+      bool done{false};
+
+      /// \brief Result of the request.
+      bool result{false};
+
+      /// \brief Message the reply is copied into.
+      std::shared_ptr<msgs::Scene> rep;
+    };
+  };
+}
+}
+
+#endif
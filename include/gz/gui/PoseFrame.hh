@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_POSEFRAME_HH_
+#define GZ_GUI_POSEFRAME_HH_
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace ignition
+{
+namespace gui
+{
+  /// \brief Entity poses received in a single pose message, stored as flat
+  /// arrays. Frames are cleared and refilled without releasing memory, so
+  /// steady state pose streaming doesn't allocate.
+  class PoseFrame
+  {
+    /// \brief Remove all poses, keeping the allocated memory.
+    public: void Clear()
+    {
+      this->hasStamp = false;
+      this->stamp = std::chrono::nanoseconds::zero();
+      this->ids.clear();
+      this->positions.clear();
+      this->orientations.clear();
+    }
+
+    /// \brief Reserve memory for a number of poses.
+    /// \param[in] _count Number of poses.
+    public: void Reserve(const std::size_t _count)
+    {
+      this->ids.reserve(_count);
+      this->positions.reserve(_count * 3);
+      this->orientations.reserve(_count * 4);
+    }
+
+    /// \brief Set the number of poses, so that the arrays can be filled in
+    /// bulk. New poses are zeroed.
+    /// \param[in] _count Number of poses.
+    public: void Resize(const std::size_t _count)
+    {
+      this->ids.resize(_count);
+      this->positions.resize(_count * 3);
+      this->orientations.resize(_count * 4);
+    }
+
+    /// \brief Append an entity pose.
+    /// \param[in] _id Entity id.
+    /// \param[in] _x Position X.
+    /// \param[in] _y Position Y.
+    /// \param[in] _z Position Z.
+    /// \param[in] _qw Orientation W.
+    /// \param[in] _qx Orientation X.
+    /// \param[in] _qy Orientation Y.
+    /// \param[in] _qz Orientation Z.
+    public: void Add(const unsigned int _id,
+        const double _x, const double _y, const double _z,
+        const double _qw, const double _qx, const double _qy, const double _qz)
+    {
+      this->ids.push_back(_id);
+      this->positions.insert(this->positions.end(), {_x, _y, _z});
+      this->orientations.insert(this->orientations.end(),
+          {_qw, _qx, _qy, _qz});
+    }
+
+    /// \brief Number of poses in the frame.
+    /// \return Pose count.
+    public: std::size_t Size() const
+    {
+      return this->ids.size();
+    }
+
+    /// \brief True if the message carried a time stamp.
+    public: bool hasStamp{false};
+
+    /// \brief Time stamp of the message, usually sim time.
+    public: std::chrono::nanoseconds stamp{0};
+
+    /// \brief Local time when the frame was received.
+    public: std::chrono::steady_clock::time_point received;
+
+    /// \brief Entity ids.
+    public: std::vector<unsigned int> ids;
+
+    /// \brief Positions, 3 values (X, Y, Z) per entity.
+    public: std::vector<double> positions;
+
+    /// \brief Orientations, 4 values (W, X, Y, Z) per entity.
+    public: std::vector<double> orientations;
+  };
+}
+}
+
+#endif
@@ -146,6 +146,15 @@ class gz::gui::events::PreRender::Implementation
 {
 };
 
+class gz::gui::events::MarkerRequest::Implementation
+{
+  /// \brief Marker message.
+  public: msgs::Marker marker;
+
+  /// \brief Marker service name.
+  public: std::string topic;
+};
+
 using namespace gz;
 using namespace gui;
 using namespace events;
@@ -430,3 +439,25 @@ PreRender::PreRender()
   : QEvent(kType), dataPtr(utils::MakeImpl<Implementation>())
 {
 }
+
+/////////////////////////////////////////////////
+MarkerRequest::MarkerRequest(const msgs::Marker &_marker,
+    const std::string &_topic)
+  : QEvent(kType), dataPtr(utils::MakeImpl<Implementation>())
+{
+  this->dataPtr->marker = _marker;
+  this->dataPtr->topic = _topic;
+  this->ignore();
+}
+
+/////////////////////////////////////////////////
+const msgs::Marker &MarkerRequest::Marker() const
+{
+  return this->dataPtr->marker;
+}
+
+/////////////////////////////////////////////////
+const std::string &MarkerRequest::Topic() const
+{
+  return this->dataPtr->topic;
+}
@@ -291,3 +291,20 @@ TEST(GuiEventsTest, PreRender)
 
   EXPECT_LT(QEvent::User, event.type());
 }
+
+/////////////////////////////////////////////////
+TEST(GuiEventsTest, MarkerRequest)
+{
+  gz::msgs::Marker marker;
+  marker.set_ns("tape_measure");
+  marker.set_id(1u);
+  marker.set_action(gz::msgs::Marker::DELETE_MARKER);
+  events::MarkerRequest event(marker, "/marker");
+
+  EXPECT_LT(QEvent::User, event.type());
+  EXPECT_FALSE(event.isAccepted());
+  EXPECT_EQ("tape_measure", event.Marker().ns());
+  EXPECT_EQ(1u, event.Marker().id());
+  EXPECT_EQ(gz::msgs::Marker::DELETE_MARKER, event.Marker().action());
+  EXPECT_EQ("/marker", event.Topic());
+}
@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gz/gui/config.hh"
+#include "gz/gui/PagedScene.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(PagedSceneTest, Page)
+{
+  msgs::Scene scene;
+  scene.set_name("world");
+  scene.set_grid(true);
+  scene.add_light()->set_id(100);
+  for (unsigned int i = 0; i < 5; ++i)
+    scene.add_model()->set_id(i);
+
+  msgs::UInt32_V req;
+  req.add_data(0);
+  req.add_data(2);
+
+  // First page has everything but the models past the count
+  msgs::Scene page;
+  uint32_t total{0};
+  ASSERT_TRUE(PagedScene::Page(scene, req, page));
+  ASSERT_TRUE(PagedScene::Total(page, total));
+  EXPECT_EQ(5u, total);
+  EXPECT_EQ("world", page.name());
+  EXPECT_TRUE(page.grid());
+  ASSERT_EQ(1, page.light_size());
+  ASSERT_EQ(2, page.model_size());
+  EXPECT_EQ(0u, page.model(0).id());
+  EXPECT_EQ(1u, page.model(1).id());
+
+  // Last page is short and has no lights
+  req.set_data(0, 4);
+  ASSERT_TRUE(PagedScene::Page(scene, req, page));
+  EXPECT_EQ(0, page.light_size());
+  ASSERT_EQ(1, page.model_size());
+  EXPECT_EQ(4u, page.model(0).id());
+
+  // Past the end
+  req.set_data(0, 9);
+  ASSERT_TRUE(PagedScene::Page(scene, req, page));
+  EXPECT_EQ(0, page.model_size());
+  ASSERT_TRUE(PagedScene::Total(page, total));
+  EXPECT_EQ(5u, total);
+
+  // Malformed
+  req.add_data(3);
+  EXPECT_FALSE(PagedScene::Page(scene, req, page));
+  EXPECT_FALSE(PagedScene::Total(msgs::Scene(), total));
+}
+
+/////////////////////////////////////////////////
+TEST(PagedSceneTest, Fetch)
+{
+  msgs::Scene scene;
+  scene.add_light()->set_id(100);
+  for (unsigned int i = 0; i < 5; ++i)
+    scene.add_model()->set_id(i);
+
+  transport::Node node;
+  const std::string service = PagedScene::Service("/paged_scene_test");
+  std::function<bool(const msgs::UInt32_V &, msgs::Scene &)> cb =
+      [&scene](const msgs::UInt32_V &_req, msgs::Scene &_rep)
+      {
+        return PagedScene::Page(scene, _req, _rep);
+      };
+  ASSERT_TRUE(node.Advertise(service, cb));
+
+  std::vector<unsigned int> ids;
+  std::vector<bool> last;
+  EXPECT_TRUE(PagedScene::Fetch(node, service, 2u, 5000u,
+      [&](msgs::Scene &&_page, bool _last)
+      {
+        for (const auto &model : _page.model())
+          ids.push_back(model.id());
+        last.push_back(_last);
+        return true;
+      }));
+  EXPECT_EQ(std::vector<unsigned int>({0u, 1u, 2u, 3u, 4u}), ids);
+  EXPECT_EQ(std::vector<bool>({false, false, true}), last);
+
+  // The callback stops fetching
+  int pages{0};
+  EXPECT_FALSE(PagedScene::Fetch(node, service, 2u, 5000u,
+      [&](msgs::Scene &&, bool)
+      {
+        ++pages;
+        return false;
+      }));
+  EXPECT_EQ(1, pages);
+}
+
+/////////////////////////////////////////////////
+TEST(PagedSceneTest, FetchCancel)
+{
+  // The service replies long after the request is cancelled
+  transport::Node node;
+  const std::string service = PagedScene::Service("/paged_scene_slow");
+  std::function<bool(const msgs::UInt32_V &, msgs::Scene &)> cb =
+      [](const msgs::UInt32_V &, msgs::Scene &)
+      {
+        std::this_thread::sleep_for(std::chrono::seconds(2));
+        return false;
+      };
+  ASSERT_TRUE(node.Advertise(service, cb));
+
+  auto onPage = [](msgs::Scene &&, bool)
+  {
+    return true;
+  };
+
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(PagedScene::Fetch(node, service, 2u, 30000u, onPage,
+      [] { return true; }));
+  EXPECT_LT(std::chrono::steady_clock::now() - start,
+      std::chrono::seconds(1));
+
+  // Without cancellation, the request times out
+  EXPECT_FALSE(PagedScene::Fetch(node, service, 2u, 100u, onPage));
+}
+
+/////////////////////////////////////////////////
+TEST(PagedSceneTest, FetchWhole)
+{
+  transport::Node node;
+  const std::string service = "/paged_scene_whole";
+  std::function<bool(const msgs::Empty &, msgs::Scene &)> cb =
+      [](const msgs::Empty &, msgs::Scene &_rep)
+      {
+        _rep.set_name("world");
+        _rep.add_model()->set_id(3);
+        return true;
+      };
+  ASSERT_TRUE(node.Advertise(service, cb));
+
+  auto scene = std::make_shared<msgs::Scene>();
+  ASSERT_TRUE(PagedScene::FetchWhole(node, service, 5000u, scene));
+  EXPECT_EQ("world", scene->name());
+  ASSERT_EQ(1, scene->model_size());
+  EXPECT_EQ(3u, scene->model(0).id());
+
+  // A slow service is cancelled without waiting for the timeout
+  const std::string slowService = "/paged_scene_whole_slow";
+  std::function<bool(const msgs::Empty &, msgs::Scene &)> slowCb =
+      [](const msgs::Empty &, msgs::Scene &)
+      {
+        std::this_thread::sleep_for(std::chrono::seconds(2));
+        return true;
+      };
+  ASSERT_TRUE(node.Advertise(slowService, slowCb));
+
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(PagedScene::FetchWhole(node, slowService, 30000u,
+      std::make_shared<msgs::Scene>(), [] { return true; }));
+  EXPECT_LT(std::chrono::steady_clock::now() - start,
+      std::chrono::seconds(1));
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_INTERNAL_ARENAMESSAGE_HH_
+#define GZ_GUI_PLUGINS_INTERNAL_ARENAMESSAGE_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+
+#include <google/protobuf/arena.h>
+#include <google/protobuf/stubs/common.h>
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  /// \brief Creates protobuf messages on their own arena, for large nested
+  /// messages which are queued from a transport callback to the render
+  /// thread, such as scenes and marker arrays.
+  ///
+  /// All fields of the message are allocated in a few large arena blocks
+  /// instead of one allocation each. The returned pointer shares ownership
+  /// of the arena, which frees everything at once when the last reference
+  /// to the message is dropped. Copies of the pointer never copy the
+  /// message.
+  ///
+  /// Messages on an arena must not be moved or swapped into messages which
+  /// aren't on the same arena, since protobuf copies them instead.
+  ///
+  /// Before protobuf 3.14, only messages generated with `cc_enable_arenas`
+  /// can be created on an arena, which gz-msgs doesn't enable. Messages
+  /// are then allocated on the heap as usual, and only sharing them avoids
+  /// copies.
+  class ArenaMessage
+  {
+    /// \brief Largest first arena block, for huge messages.
+    public: static constexpr std::size_t kMaxStartBlock = 64u << 20u;
+
+    /// \brief Create an empty message on a new arena, if protobuf allows.
+    /// \param[in] _sizeHint Expected serialized size of the message, used
+    /// to size the first arena block so that parsing needs few blocks.
+    /// \return New message.
+    public: template <typename T>
+    static std::shared_ptr<T> Create(const std::size_t _sizeHint = 0u)
+    {
+#if GOOGLE_PROTOBUF_VERSION < 3014000
+      (void)_sizeHint;
+      return std::make_shared<T>();
+#else
+      // Parsed messages take about twice their serialized size
+      google::protobuf::ArenaOptions options;
+      options.start_block_size = std::clamp<std::size_t>(
+          _sizeHint * 2u, options.start_block_size, kMaxStartBlock);
+      options.max_block_size =
+          std::max(options.max_block_size, options.start_block_size);
+
+      auto arena = std::make_shared<google::protobuf::Arena>(options);
+      T *msg = google::protobuf::Arena::CreateMessage<T>(arena.get());
+      return std::shared_ptr<T>(arena, msg);
+#endif
+    }
+
+    /// \brief Parse a serialized message into a new arena.
+    /// \param[in] _data Serialized message.
+    /// \param[in] _size Size of the data in bytes.
+    /// \return Parsed message, null if the data is malformed.
+    public: template <typename T>
+    static std::shared_ptr<T> Parse(const char *_data,
+        const std::size_t _size)
+    {
+      if (_size > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+        return nullptr;
+
+      auto msg = Create<T>(_size);
+      if (!msg->ParseFromArray(_data, static_cast<int>(_size)))
+        return nullptr;
+      return msg;
+    }
+
+    /// \brief Copy a message into a new arena, for messages which are only
+    /// available as a reference, like service requests.
+    /// \param[in] _msg Message to copy.
+    /// \return Copy of the message.
+    public: template <typename T>
+    static std::shared_ptr<T> Copy(const T &_msg)
+    {
+      auto msg = Create<T>(_msg.ByteSizeLong());
+      msg->CopyFrom(_msg);
+      return msg;
+    }
+  };
+}
+}
+}
+
+#endif
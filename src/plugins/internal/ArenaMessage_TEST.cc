@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <gz/msgs/marker_v.pb.h>
+#include <gz/msgs/scene.pb.h>
+
+#include "gz/gui/config.hh"
+
+#include "ArenaMessage.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+TEST(ArenaMessageTest, Parse)
+{
+  msgs::Scene scene;
+  scene.set_name("world");
+  for (unsigned int i = 0; i < 100; ++i)
+  {
+    auto model = scene.add_model();
+    model->set_id(i);
+    model->set_name("model_" + std::to_string(i));
+    model->add_link()->add_visual()->set_id(1000 + i);
+  }
+  const std::string data = scene.SerializeAsString();
+
+  auto msg = ArenaMessage::Parse<msgs::Scene>(data.data(), data.size());
+  ASSERT_NE(nullptr, msg);
+  EXPECT_EQ("world", msg->name());
+  ASSERT_EQ(100, msg->model_size());
+  EXPECT_EQ("model_99", msg->model(99).name());
+  EXPECT_EQ(1099u, msg->model(99).link(0).visual(0).id());
+
+  // Copies of the pointer share the message, which outlives the original
+  std::shared_ptr<const msgs::Scene> shared = msg;
+  msg.reset();
+  EXPECT_EQ(100, shared->model_size());
+
+  // Malformed data
+  EXPECT_EQ(nullptr, ArenaMessage::Parse<msgs::Scene>("\xff\xff", 2u));
+}
+
+/////////////////////////////////////////////////
+TEST(ArenaMessageTest, Copy)
+{
+  msgs::Marker_V markers;
+  for (unsigned int i = 0; i < 10; ++i)
+  {
+    auto marker = markers.add_marker();
+    marker->set_ns("ns");
+    marker->set_id(i);
+  }
+
+  auto msg = ArenaMessage::Copy(markers);
+  ASSERT_NE(nullptr, msg);
+  ASSERT_EQ(10, msg->marker_size());
+  EXPECT_EQ(9u, msg->marker(9).id());
+
+  // The copy is independent
+  markers.clear_marker();
+  EXPECT_EQ(10, msg->marker_size());
+
+  auto empty = ArenaMessage::Create<msgs::Marker_V>();
+  ASSERT_NE(nullptr, empty);
+  EXPECT_EQ(0, empty->marker_size());
+}
@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_INTERNAL_MATERIALCACHE_HH_
+#define GZ_GUI_PLUGINS_INTERNAL_MATERIALCACHE_HH_
+
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+
+#include <gz/msgs/color.pb.h>
+
+#include <gz/rendering/Material.hh>
+#include <gz/rendering/Scene.hh>
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  /// \brief Key identifying the appearance of a material. Fields are
+  /// appended as raw bytes, so two keys are equal only if all fields are
+  /// bit-for-bit identical, and there are no false matches on hash
+  /// collisions.
+  class MaterialKey
+  {
+    /// \brief Append a color.
+    /// \param[in] _color Color to append.
+    /// \return Reference to this key.
+    public: MaterialKey &Add(const msgs::Color &_color)
+    {
+      return this->Add(_color.r()).Add(_color.g()).Add(_color.b())
+          .Add(_color.a());
+    }
+
+    /// \brief Append a value of a trivially copyable type.
+    /// \param[in] _value Value to append.
+    /// \return Reference to this key.
+    public: template <typename T>
+    MaterialKey &Add(const T _value)
+    {
+      static_assert(std::is_trivially_copyable<T>::value,
+          "Only trivially copyable values can be added to a key");
+      char bytes[sizeof(T)];
+      std::memcpy(bytes, &_value, sizeof(T));
+      this->data.append(bytes, sizeof(T));
+      return *this;
+    }
+
+    /// \brief Key bytes.
+    public: std::string data;
+  };
+
+  /// \brief Materials shared by all visuals with the same appearance.
+  ///
+  /// Materials handed out by the cache are shared and must not be modified
+  /// or destroyed by the caller. Pass them to SetMaterial with `_unique`
+  /// set to false so that geometries don't clone them.
+  ///
+  /// Users may hold references with Acquire() and Release(), and materials
+  /// are destroyed when their last reference is released. Materials which
+  /// are never acquired stay cached until Clear().
+  class MaterialCache
+  {
+    /// \brief Get the material for a key.
+    /// \param[in] _scene Scene which owns the materials.
+    /// \param[in] _key Appearance key.
+    /// \return Cached material, or null if there's none for this key.
+    public: rendering::MaterialPtr Find(const rendering::ScenePtr &_scene,
+        const MaterialKey &_key)
+    {
+      auto it = this->materials.find(_key.data);
+      if (it == this->materials.end())
+        return nullptr;
+
+      // The scene may have destroyed the material behind our back
+      if (!_scene->MaterialRegistered(it->second->Name()))
+      {
+        this->refs.erase(it->second->Name());
+        this->materials.erase(it);
+        return nullptr;
+      }
+      return it->second;
+    }
+
+    /// \brief Add a material to the cache.
+    /// \param[in] _key Appearance key.
+    /// \param[in] _material Material which will be shared by all visuals
+    /// with the same key.
+    public: void Insert(const MaterialKey &_key,
+        const rendering::MaterialPtr &_material)
+    {
+      this->materials[_key.data] = _material;
+      this->refs[_material->Name()] = {0u, _key.data};
+    }
+
+    /// \brief Add a reference to a cached material, which keeps it from
+    /// being destroyed by Release.
+    /// \param[in] _material Material returned by Find.
+    public: void Acquire(const rendering::MaterialPtr &_material)
+    {
+      auto it = this->refs.find(_material->Name());
+      if (it != this->refs.end())
+        ++it->second.count;
+    }
+
+    /// \brief Remove a reference added with Acquire, destroying the
+    /// material if it was the last one. Geometries using the material must
+    /// be destroyed first.
+    /// \param[in] _scene Scene which owns the materials.
+    /// \param[in] _material Material passed to Acquire.
+    public: void Release(const rendering::ScenePtr &_scene,
+        const rendering::MaterialPtr &_material)
+    {
+      auto it = this->refs.find(_material->Name());
+      if (it == this->refs.end() || it->second.count == 0u ||
+          --it->second.count > 0u)
+      {
+        return;
+      }
+
+      if (_scene->MaterialRegistered(_material->Name()))
+        _scene->DestroyMaterial(_material);
+      this->materials.erase(it->second.key);
+      this->refs.erase(it);
+    }
+
+    /// \brief Number of cached materials.
+    /// \return Number of materials.
+    public: std::size_t Size() const
+    {
+      return this->materials.size();
+    }
+
+    /// \brief Destroy all cached materials.
+    /// \param[in] _scene Scene which owns the materials.
+    public: void Clear(const rendering::ScenePtr &_scene)
+    {
+      for (auto &it : this->materials)
+      {
+        if (_scene->MaterialRegistered(it.second->Name()))
+          _scene->DestroyMaterial(it.second);
+      }
+      this->materials.clear();
+      this->refs.clear();
+    }
+
+    /// \brief References to a cached material.
+    private: struct References
+    {
+      /// \brief Number of references.
+      unsigned int count;
+
+      /// \brief Appearance key of the material.
+      std::string key;
+    };
+
+    /// \brief Cached materials keyed by appearance.
+    private: std::unordered_map<std::string, rendering::MaterialPtr>
+        materials;
+
+    /// \brief References to cached materials, keyed by material name.
+    private: std::unordered_map<std::string, References> refs;
+  };
+}
+}
+}
+
+#endif
@@ -0,0 +1,328 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_INTERNAL_POSEVDECODER_HH_
+#define GZ_GUI_PLUGINS_INTERNAL_POSEVDECODER_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "gz/gui/PoseFrame.hh"
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  /// \brief Decodes serialized msgs::Pose_V straight from the protobuf wire
+  /// format into a PoseFrame, without constructing any messages.
+  ///
+  /// Only the fields used for rendering are decoded: the stamp of the
+  /// header, and each pose's id, position and orientation. Pose headers,
+  /// header data and names are skipped. Payloads with any other field, or
+  /// with a field of an unexpected wire type, are rejected, so that the
+  /// caller can fall back to parsing a full msgs::Pose_V.
+  class PoseVDecoder
+  {
+    /// \brief Decode a serialized msgs::Pose_V.
+    /// \param[in] _data Serialized message.
+    /// \param[in] _size Size of the message in bytes.
+    /// \param[out] _frame Decoded poses. Its contents are unspecified if
+    /// decoding fails.
+    /// \return False if the payload is malformed or has unknown fields.
+    public: static bool Decode(const char *_data, const std::size_t _size,
+        PoseFrame &_frame)
+    {
+      _frame.Clear();
+
+      const char *p = _data;
+      const char *end = _data + _size;
+      while (p < end)
+      {
+        uint32_t field;
+        uint32_t wireType;
+        if (!ReadTag(p, end, field, wireType))
+          return false;
+
+        if (wireType != kLengthDelimited)
+          return false;
+
+        const char *sub;
+        const char *subEnd;
+        if (!ReadLength(p, end, sub, subEnd))
+          return false;
+
+        // header = 1, pose = 2
+        if (field == 2u)
+        {
+          if (!DecodePose(sub, subEnd, _frame))
+            return false;
+        }
+        else if (field == 1u)
+        {
+          if (!DecodeHeader(sub, subEnd, _frame))
+            return false;
+        }
+        else
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    /// \brief Decode the stamp of a msgs::Header into the frame.
+    /// \param[in] _p Start of the header.
+    /// \param[in] _end End of the header.
+    /// \param[out] _frame Frame to set the stamp on.
+    /// \return False if the header is malformed or has unknown fields.
+    private: static bool DecodeHeader(const char *_p, const char *_end,
+        PoseFrame &_frame)
+    {
+      while (_p < _end)
+      {
+        uint32_t field;
+        uint32_t wireType;
+        if (!ReadTag(_p, _end, field, wireType) ||
+            wireType != kLengthDelimited)
+        {
+          return false;
+        }
+
+        const char *sub;
+        const char *subEnd;
+        if (!ReadLength(_p, _end, sub, subEnd))
+          return false;
+
+        // stamp = 1, data = 2
+        if (field == 1u)
+        {
+          // Time: sec = 1, nsec = 2. Missing fields are zero.
+          uint64_t values[2] = {0u, 0u};
+          while (sub < subEnd)
+          {
+            if (!ReadTag(sub, subEnd, field, wireType) ||
+                wireType != kVarint || field < 1u || field > 2u ||
+                !ReadVarint(sub, subEnd, values[field - 1u]))
+            {
+              return false;
+            }
+          }
+          _frame.hasStamp = true;
+          _frame.stamp =
+              std::chrono::seconds(static_cast<int64_t>(values[0])) +
+              std::chrono::nanoseconds(static_cast<int32_t>(values[1]));
+        }
+        else if (field != 2u)
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    /// \brief Decode a msgs::Pose and append it to the frame.
+    /// \param[in] _p Start of the pose.
+    /// \param[in] _end End of the pose.
+    /// \param[out] _frame Frame to append to.
+    /// \return False if the pose is malformed or has unknown fields.
+    private: static bool DecodePose(const char *_p, const char *_end,
+        PoseFrame &_frame)
+    {
+      // Same defaults as msgs::Convert, a missing orientation is identity
+      uint64_t id{0u};
+      double position[3] = {0.0, 0.0, 0.0};
+      double orientation[4] = {1.0, 0.0, 0.0, 0.0};
+      bool hasOrientation{false};
+
+      while (_p < _end)
+      {
+        uint32_t field;
+        uint32_t wireType;
+        if (!ReadTag(_p, _end, field, wireType))
+          return false;
+
+        // id = 3
+        if (field == 3u && wireType == kVarint)
+        {
+          if (!ReadVarint(_p, _end, id))
+            return false;
+          continue;
+        }
+
+        if (wireType != kLengthDelimited)
+          return false;
+
+        const char *sub;
+        const char *subEnd;
+        if (!ReadLength(_p, _end, sub, subEnd))
+          return false;
+
+        // header = 1, name = 2, position = 4, orientation = 5
+        if (field == 4u)
+        {
+          // Vector3d: x = 2, y = 3, z = 4
+          if (!DecodeDoubles(sub, subEnd, 2u, 3u, position))
+            return false;
+        }
+        else if (field == 5u)
+        {
+          // A present orientation starts from zeros like the message does
+          if (!hasOrientation)
+          {
+            orientation[0] = 0.0;
+            hasOrientation = true;
+          }
+
+          // Quaternion: x = 2, y = 3, z = 4, w = 5. Stored as X, Y, Z in
+          // orientation[1..3] and W in orientation[0].
+          double xyzw[4] = {orientation[1], orientation[2], orientation[3],
+              orientation[0]};
+          if (!DecodeDoubles(sub, subEnd, 2u, 4u, xyzw))
+            return false;
+          orientation[0] = xyzw[3];
+          orientation[1] = xyzw[0];
+          orientation[2] = xyzw[1];
+          orientation[3] = xyzw[2];
+        }
+        else if (field != 1u && field != 2u)
+        {
+          return false;
+        }
+      }
+
+      _frame.Add(static_cast<uint32_t>(id),
+          position[0], position[1], position[2],
+          orientation[0], orientation[1], orientation[2], orientation[3]);
+      return true;
+    }
+
+    /// \brief Decode a message made of a header and double fields with
+    /// consecutive numbers, such as msgs::Vector3d and msgs::Quaternion.
+    /// Fields not present keep their current value.
+    /// \param[in] _p Start of the message.
+    /// \param[in] _end End of the message.
+    /// \param[in] _first Number of the first double field.
+    /// \param[in] _count Number of double fields.
+    /// \param[in,out] _values Values, in field number order.
+    /// \return False if the message is malformed or has unknown fields.
+    private: static bool DecodeDoubles(const char *_p, const char *_end,
+        const uint32_t _first, const uint32_t _count, double *_values)
+    {
+      while (_p < _end)
+      {
+        uint32_t field;
+        uint32_t wireType;
+        if (!ReadTag(_p, _end, field, wireType))
+          return false;
+
+        if (field >= _first && field < _first + _count &&
+            wireType == kFixed64)
+        {
+          if (_end - _p < 8)
+            return false;
+          std::memcpy(&_values[field - _first], _p, 8u);
+          _p += 8;
+        }
+        else if (field == 1u && wireType == kLengthDelimited)
+        {
+          const char *sub;
+          const char *subEnd;
+          if (!ReadLength(_p, _end, sub, subEnd))
+            return false;
+        }
+        else
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    /// \brief Read a field tag.
+    /// \param[in,out] _p Read position, advanced past the tag.
+    /// \param[in] _end End of the buffer.
+    /// \param[out] _field Field number.
+    /// \param[out] _wireType Wire type.
+    /// \return False if the buffer ends before the tag does.
+    private: static bool ReadTag(const char *&_p, const char *_end,
+        uint32_t &_field, uint32_t &_wireType)
+    {
+      uint64_t tag;
+      if (!ReadVarint(_p, _end, tag))
+        return false;
+      _field = static_cast<uint32_t>(tag >> 3);
+      _wireType = static_cast<uint32_t>(tag & 0x7u);
+      return true;
+    }
+
+    /// \brief Read a length delimited field.
+    /// \param[in,out] _p Read position, advanced past the field.
+    /// \param[in] _end End of the buffer.
+    /// \param[out] _sub Start of the field payload.
+    /// \param[out] _subEnd End of the field payload.
+    /// \return False if the buffer ends before the field does.
+    private: static bool ReadLength(const char *&_p, const char *_end,
+        const char *&_sub, const char *&_subEnd)
+    {
+      uint64_t length;
+      if (!ReadVarint(_p, _end, length) ||
+          length > static_cast<uint64_t>(_end - _p))
+      {
+        return false;
+      }
+      _sub = _p;
+      _subEnd = _p + length;
+      _p = _subEnd;
+      return true;
+    }
+
+    /// \brief Read a base 128 varint.
+    /// \param[in,out] _p Read position, advanced past the varint.
+    /// \param[in] _end End of the buffer.
+    /// \param[out] _value Decoded value.
+    /// \return False if the varint is truncated or longer than 10 bytes.
+    private: static bool ReadVarint(const char *&_p, const char *_end,
+        uint64_t &_value)
+    {
+      _value = 0u;
+      for (unsigned int shift = 0u; shift < 64u && _p < _end; shift += 7u)
+      {
+        const uint8_t byte = static_cast<uint8_t>(*_p++);
+        _value |= static_cast<uint64_t>(byte & 0x7Fu) << shift;
+        if ((byte & 0x80u) == 0u)
+          return true;
+      }
+      return false;
+    }
+
+    /// \brief Varint wire type.
+    private: static constexpr uint32_t kVarint = 0u;
+
+    /// \brief 64 bit wire type, used by doubles.
+    private: static constexpr uint32_t kFixed64 = 1u;
+
+    /// \brief Length delimited wire type, used by messages and strings.
+    private: static constexpr uint32_t kLengthDelimited = 2u;
+  };
+}
+}
+}
+
+#endif
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <gz/msgs/pose_v.pb.h>
+
+#include "gz/gui/config.hh"
+
+#include "PoseVDecoder.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+TEST(PoseVDecoderTest, MatchesProtobuf)
+{
+  msgs::Pose_V msg;
+  msg.mutable_header()->mutable_stamp()->set_sec(3);
+
+  // Full pose with name
+  auto pose = msg.add_pose();
+  pose->set_id(1);
+  pose->set_name("box");
+  pose->mutable_position()->set_x(1.5);
+  pose->mutable_position()->set_y(-2.0);
+  pose->mutable_position()->set_z(3.25);
+  pose->mutable_orientation()->set_w(0.5);
+  pose->mutable_orientation()->set_x(0.5);
+  pose->mutable_orientation()->set_y(-0.5);
+  pose->mutable_orientation()->set_z(0.5);
+
+  // Missing orientation is identity
+  pose = msg.add_pose();
+  pose->set_id(4000000000u);
+  pose->mutable_position()->set_z(7.0);
+
+  // Present orientation with zero fields omitted from the wire
+  pose = msg.add_pose();
+  pose->set_id(0);
+  pose->mutable_orientation()->set_w(1.0);
+
+  std::string data;
+  ASSERT_TRUE(msg.SerializeToString(&data));
+
+  PoseFrame frame;
+  ASSERT_TRUE(PoseVDecoder::Decode(data.data(), data.size(), frame));
+  ASSERT_EQ(3u, frame.Size());
+  EXPECT_TRUE(frame.hasStamp);
+  EXPECT_EQ(std::chrono::seconds(3), frame.stamp);
+
+  EXPECT_EQ(1u, frame.ids[0]);
+  EXPECT_DOUBLE_EQ(1.5, frame.positions[0]);
+  EXPECT_DOUBLE_EQ(-2.0, frame.positions[1]);
+  EXPECT_DOUBLE_EQ(3.25, frame.positions[2]);
+  EXPECT_DOUBLE_EQ(0.5, frame.orientations[0]);
+  EXPECT_DOUBLE_EQ(0.5, frame.orientations[1]);
+  EXPECT_DOUBLE_EQ(-0.5, frame.orientations[2]);
+  EXPECT_DOUBLE_EQ(0.5, frame.orientations[3]);
+
+  EXPECT_EQ(4000000000u, frame.ids[1]);
+  EXPECT_DOUBLE_EQ(0.0, frame.positions[3]);
+  EXPECT_DOUBLE_EQ(7.0, frame.positions[5]);
+  EXPECT_DOUBLE_EQ(1.0, frame.orientations[4]);
+  EXPECT_DOUBLE_EQ(0.0, frame.orientations[5]);
+
+  EXPECT_EQ(0u, frame.ids[2]);
+  EXPECT_DOUBLE_EQ(1.0, frame.orientations[8]);
+  EXPECT_DOUBLE_EQ(0.0, frame.orientations[9]);
+}
+
+/////////////////////////////////////////////////
+TEST(PoseVDecoderTest, Rejects)
+{
+  msgs::Pose_V msg;
+  msg.add_pose()->set_id(1);
+  std::string data;
+  ASSERT_TRUE(msg.SerializeToString(&data));
+
+  PoseFrame frame;
+  EXPECT_TRUE(PoseVDecoder::Decode(data.data(), data.size(), frame));
+  EXPECT_FALSE(frame.hasStamp);
+  EXPECT_TRUE(PoseVDecoder::Decode(data.data(), 0u, frame));
+  EXPECT_EQ(0u, frame.Size());
+
+  // Truncated
+  EXPECT_FALSE(PoseVDecoder::Decode(data.data(), data.size() - 1, frame));
+
+  // Unknown field, number 9 as a varint, must fall back to protobuf
+  std::string unknown = data + std::string("\x48\x01", 2);
+  EXPECT_FALSE(PoseVDecoder::Decode(unknown.data(), unknown.size(), frame));
+}
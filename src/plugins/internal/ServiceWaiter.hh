@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_INTERNAL_SERVICEWAITER_HH_
+#define GZ_GUI_PLUGINS_INTERNAL_SERVICEWAITER_HH_
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  /// \brief Waits for a condition, such as a service being advertised, to
+  /// become true, while staying cancellable from another thread.
+  ///
+  /// The condition is polled with a backoff which starts short, so that
+  /// services which are already up, or come up right away, are found within
+  /// a few milliseconds, and grows up to a bound which keeps the reaction
+  /// time well under 100 ms. Waiting happens on a condition variable, so
+  /// Cancel() wakes the waiter immediately instead of after a sleep.
+  class ServiceWaiter
+  {
+    /// \brief First polling interval.
+    public: static constexpr std::chrono::milliseconds kMinBackoff{5};
+
+    /// \brief Longest polling interval.
+    public: static constexpr std::chrono::milliseconds kMaxBackoff{50};
+
+    /// \brief Default time to wait before giving up.
+    public: static constexpr std::chrono::milliseconds kDefaultTimeout{30000};
+
+    /// \brief Wait until the condition holds.
+    /// \param[in] _ready Condition to poll. Called without any lock held.
+    /// \param[in] _timeout Time to wait before giving up.
+    /// \return True if the condition holds, false if the wait timed out or
+    /// was cancelled.
+    public: bool Wait(const std::function<bool()> &_ready,
+        const std::chrono::milliseconds _timeout = kDefaultTimeout)
+    {
+      const auto deadline = std::chrono::steady_clock::now() + _timeout;
+      auto backoff = kMinBackoff;
+      while (true)
+      {
+        if (this->Cancelled())
+          return false;
+
+        if (_ready())
+          return true;
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= deadline)
+          return false;
+
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->cv.wait_for(lock,
+            std::min<std::chrono::steady_clock::duration>(backoff,
+            deadline - now), [this] { return this->cancelled; });
+        backoff = std::min(backoff * 2, kMaxBackoff);
+      }
+    }
+
+    /// \brief Cancel current and future waits, which return false right
+    /// away. Safe to call from any thread.
+    public: void Cancel()
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->cancelled = true;
+      }
+      this->cv.notify_all();
+    }
+
+    /// \brief Get whether waits were cancelled.
+    /// \return True if Cancel() was called.
+    public: bool Cancelled() const
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      return this->cancelled;
+    }
+
+    /// \brief Protects cancelled.
+    private: mutable std::mutex mutex;
+
+    /// \brief Notified on cancellation.
+    private: std::condition_variable cv;
+
+    /// \brief True once Cancel() was called.
+    private: bool cancelled{false};
+  };
+}
+}
+}
+
+#endif
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "gz/gui/config.hh"
+
+#include "ServiceWaiter.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+using namespace std::chrono_literals;
+
+/////////////////////////////////////////////////
+TEST(ServiceWaiterTest, Ready)
+{
+  ServiceWaiter waiter;
+
+  int calls{0};
+  EXPECT_TRUE(waiter.Wait([&calls] { return ++calls > 0; }));
+  EXPECT_EQ(1, calls);
+
+  // Becomes ready after a few polls
+  const auto start = std::chrono::steady_clock::now();
+  calls = 0;
+  EXPECT_TRUE(waiter.Wait([&calls] { return ++calls == 5; }));
+  EXPECT_EQ(5, calls);
+  EXPECT_LT(std::chrono::steady_clock::now() - start, 1s);
+}
+
+/////////////////////////////////////////////////
+TEST(ServiceWaiterTest, Timeout)
+{
+  ServiceWaiter waiter;
+
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(waiter.Wait([] { return false; }, 100ms));
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_GE(elapsed, 100ms);
+  EXPECT_LT(elapsed, 1s);
+  EXPECT_FALSE(waiter.Cancelled());
+}
+
+/////////////////////////////////////////////////
+TEST(ServiceWaiterTest, Cancel)
+{
+  ServiceWaiter waiter;
+
+  std::atomic<bool> result{true};
+  const auto start = std::chrono::steady_clock::now();
+  std::thread thread([&waiter, &result]
+  {
+    result = waiter.Wait([] { return false; });
+  });
+
+  std::this_thread::sleep_for(20ms);
+  waiter.Cancel();
+  thread.join();
+
+  EXPECT_FALSE(result);
+  EXPECT_LT(std::chrono::steady_clock::now() - start, 1s);
+  EXPECT_TRUE(waiter.Cancelled());
+
+  // Later waits return right away
+  EXPECT_FALSE(waiter.Wait([] { return true; }));
+}
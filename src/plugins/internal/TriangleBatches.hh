@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_INTERNAL_TRIANGLEBATCHES_HH_
+#define GZ_GUI_PLUGINS_INTERNAL_TRIANGLEBATCHES_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <gz/common/Mesh.hh>
+#include <gz/common/MeshManager.hh>
+#include <gz/common/SubMesh.hh>
+#include <gz/math/Color.hh>
+#include <gz/math/Pose3.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/rendering/Marker.hh>
+#include <gz/rendering/Material.hh>
+#include <gz/rendering/Scene.hh>
+#include <gz/rendering/Visual.hh>
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  /// \brief Bookkeeping shared by the plugins which draw many primitives as
+  /// a few dynamic triangle lists, such as the instance batcher of the
+  /// TransportSceneManager and the marker batcher of the MarkerManager.
+  ///
+  /// The batches themselves are stored by their owner, which refers to
+  /// them by index. Here, they are looked up by a key, such as a mesh or a
+  /// namespace and a material. The vertices of each primitive are the
+  /// triangles of a unit mesh, scaled and posed in the world.
+  class TriangleBatches
+  {
+    /// \brief Maximum number of vertices in a batch. Bounds the memory of a
+    /// single triangle list, and the cost of rewriting all of it.
+    public: static constexpr std::size_t kMaxVertices = 1u << 18;
+
+    /// \brief Get the triangles of a unit mesh.
+    /// \param[in] _meshName Unit mesh name in common::MeshManager.
+    /// \return Triangle vertices, three per triangle, null if the mesh
+    /// doesn't exist. Valid as long as this object.
+    public: const std::vector<math::Vector3d> *Triangles(
+        const std::string &_meshName)
+    {
+      auto it = this->triangles.find(_meshName);
+      if (it != this->triangles.end())
+        return &it->second;
+
+      const common::Mesh *mesh =
+          common::MeshManager::Instance()->MeshByName(_meshName);
+      if (nullptr == mesh)
+        return nullptr;
+
+      std::vector<math::Vector3d> vertices;
+      for (unsigned int i = 0; i < mesh->SubMeshCount(); ++i)
+      {
+        auto subMesh = mesh->SubMeshByIndex(i).lock();
+        if (!subMesh)
+          continue;
+
+        for (unsigned int j = 0; j < subMesh->IndexCount(); ++j)
+          vertices.push_back(subMesh->Vertex(subMesh->Index(j)));
+      }
+
+      return &(this->triangles[_meshName] = std::move(vertices));
+    }
+
+    /// \brief Find a batch with room for one more primitive, creating it if
+    /// needed.
+    /// \param[in] _key Key of the batch.
+    /// \param[in] _fits Called with the index of each batch with that key,
+    /// returns true if it has room.
+    /// \param[in] _create Called if no batch has room, creates one and
+    /// returns its index.
+    /// \return Index of the batch.
+    public: template <typename Fits, typename Create>
+    std::size_t Find(const std::string &_key, const Fits &_fits,
+        const Create &_create)
+    {
+      auto &indices = this->batchesByKey[_key];
+      for (const auto index : indices)
+      {
+        if (_fits(index))
+          return index;
+      }
+
+      const std::size_t index = _create();
+      indices.push_back(index);
+      return index;
+    }
+
+    /// \brief Stop finding a batch, before it's destroyed.
+    /// \param[in] _key Key of the batch.
+    /// \param[in] _index Index of the batch.
+    public: void Remove(const std::string &_key, const std::size_t _index)
+    {
+      auto it = this->batchesByKey.find(_key);
+      if (it == this->batchesByKey.end())
+        return;
+
+      it->second.erase(std::remove(it->second.begin(), it->second.end(),
+          _index), it->second.end());
+      if (it->second.empty())
+        this->batchesByKey.erase(it);
+    }
+
+    /// \brief Create the triangle list of a new batch, in a visual attached
+    /// to the root visual.
+    /// \param[in] _scene Scene where the batch is created.
+    /// \param[in] _material Material of all primitives of the batch, which
+    /// isn't cloned.
+    /// \param[out] _marker Triangle list.
+    /// \return Visual holding the triangle list.
+    public: static rendering::VisualPtr CreateVisual(
+        const rendering::ScenePtr &_scene,
+        const rendering::MaterialPtr &_material,
+        rendering::MarkerPtr &_marker)
+    {
+      _marker = _scene->CreateMarker();
+      _marker->SetType(rendering::MT_TRIANGLE_LIST);
+      _marker->SetMaterial(_material, false);
+      auto visual = _scene->CreateVisual();
+      visual->AddGeometry(_marker);
+      _scene->RootVisual()->AddChild(visual);
+      return visual;
+    }
+
+    /// \brief Append the vertices of a primitive to a triangle list.
+    /// \param[in] _marker Triangle list.
+    /// \param[in] _triangles Unit mesh triangles.
+    /// \param[in] _pose World pose of the primitive.
+    /// \param[in] _scale World scale of the primitive.
+    /// \param[in] _color Vertex color.
+    public: static void Add(const rendering::MarkerPtr &_marker,
+        const std::vector<math::Vector3d> &_triangles,
+        const math::Pose3d &_pose, const math::Vector3d &_scale,
+        const math::Color &_color)
+    {
+      for (const auto &vertex : _triangles)
+      {
+        _marker->AddPoint(_pose.Rot() * (vertex * _scale) + _pose.Pos(),
+            _color);
+      }
+    }
+
+    /// \brief Overwrite the vertices of a primitive in a triangle list.
+    /// \param[in] _marker Triangle list.
+    /// \param[in] _offset Index of the first vertex of the primitive.
+    /// \param[in] _triangles Unit mesh triangles.
+    /// \param[in] _pose World pose of the primitive.
+    /// \param[in] _scale World scale of the primitive. A zero scale at the
+    /// origin collapses the primitive to a point.
+    public: static void Set(const rendering::MarkerPtr &_marker,
+        const std::size_t _offset,
+        const std::vector<math::Vector3d> &_triangles,
+        const math::Pose3d &_pose, const math::Vector3d &_scale)
+    {
+      for (std::size_t i = 0u; i < _triangles.size(); ++i)
+      {
+        _marker->SetPoint(static_cast<unsigned int>(_offset + i),
+            _pose.Rot() * (_triangles[i] * _scale) + _pose.Pos());
+      }
+    }
+
+    /// \brief Indices of batches, by key.
+    private: std::unordered_map<std::string, std::vector<std::size_t>>
+        batchesByKey;
+
+    /// \brief Triangles of the unit meshes, by mesh name.
+    private: std::unordered_map<std::string, std::vector<math::Vector3d>>
+        triangles;
+  };
+}
+}
+}
+
+#endif
@@ -0,0 +1,440 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/math/Pose3.hh>
+#include <gz/rendering/Marker.hh>
+
+#include "MarkerBatcher.hh"
+#include "TriangleBatches.hh"
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  /// \brief Marker drawn by a batch.
+  struct BatchMember
+  {
+    /// \brief Visual of the marker, which has no geometry of its own.
+    rendering::VisualPtr::weak_type visual;
+
+    /// \brief Marker type.
+    msgs::Marker::Type type{msgs::Marker::NONE};
+
+    /// \brief Unit mesh triangles, three vertices per triangle.
+    const std::vector<math::Vector3d> *triangles{nullptr};
+
+    /// \brief Index of the first vertex of the marker in the batch.
+    std::size_t offset{0u};
+
+    /// \brief True once the vertices of the marker are in the batch.
+    bool drawn{false};
+  };
+
+  /// \brief Markers of a namespace sharing a material, drawn as one
+  /// triangle list.
+  struct MarkerBatch
+  {
+    /// \brief Shared material of all markers.
+    rendering::MaterialPtr material;
+
+    /// \brief Visual holding the triangle list.
+    rendering::VisualPtr visual;
+
+    /// \brief Triangle list with the vertices of all markers.
+    rendering::MarkerPtr marker;
+
+    /// \brief Markers in the batch, by id.
+    std::map<uint64_t, BatchMember> members;
+
+    /// \brief Number of vertices of all markers, including the ones which
+    /// aren't drawn yet.
+    std::size_t vertexCount{0u};
+
+    /// \brief Ids of the markers to write on the next update, in the order
+    /// they were set.
+    std::vector<uint64_t> changed;
+
+    /// \brief True if all vertices must be regenerated on the next update.
+    bool rebuild{false};
+
+    /// \brief True if the batch is in the list of batches to update.
+    bool dirty{false};
+  };
+}
+}
+}
+
+/// \brief Private data class for MarkerBatcher
+class ignition::gui::plugins::MarkerBatcherPrivate
+{
+  /// \brief Find a batch with room for more vertices, creating it if
+  /// needed.
+  /// \param[in] _ns Marker namespace.
+  /// \param[in] _material Shared material.
+  /// \param[in] _vertexCount Number of vertices to add.
+  /// \return Index of the batch.
+  public: std::size_t FindBatch(const std::string &_ns,
+      const rendering::MaterialPtr &_material,
+      const std::size_t _vertexCount);
+
+  /// \brief Remove a marker from a batch, which is rebuilt on the next
+  /// update. The marker's location must be erased by the caller.
+  /// \param[in] _index Index of the batch.
+  /// \param[in] _id Marker id.
+  public: void RemoveMember(const std::size_t _index, const uint64_t _id);
+
+  /// \brief Schedule a batch for the next update.
+  /// \param[in] _index Index of the batch.
+  public: void MarkDirty(const std::size_t _index);
+
+  /// \brief Write the vertices of the markers which changed in place, and
+  /// append the new ones.
+  /// \param[in] _batch Batch to write.
+  public: void Write(MarkerBatch &_batch);
+
+  /// \brief Regenerate all vertices of a batch.
+  /// \param[in] _batch Batch to rebuild.
+  public: void Rebuild(MarkerBatch &_batch);
+
+  /// \brief Scene where batches are created.
+  public: rendering::ScenePtr scene;
+
+  /// \brief All batches. Batches are never removed, empty batches are
+  /// hidden and reused.
+  public: std::vector<MarkerBatch> batches;
+
+  /// \brief Batches by namespace and material, and unit mesh triangles.
+  public: TriangleBatches lookup;
+
+  /// \brief Index of the batch of each marker, by namespace and id.
+  public: std::unordered_map<std::string,
+      std::unordered_map<uint64_t, std::size_t>> locations;
+
+  /// \brief Indices of batches to update.
+  public: std::vector<std::size_t> dirtyBatches;
+};
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+MarkerBatcher::MarkerBatcher(const rendering::ScenePtr &_scene)
+  : dataPtr(new MarkerBatcherPrivate)
+{
+  this->dataPtr->scene = _scene;
+}
+
+/////////////////////////////////////////////////
+MarkerBatcher::~MarkerBatcher() = default;
+
+/////////////////////////////////////////////////
+bool MarkerBatcher::Supports(const msgs::Marker &_msg,
+    const msgs::Marker::Type _current)
+{
+  if (!_msg.parent().empty())
+    return false;
+
+  const auto type =
+      _msg.type() == msgs::Marker::NONE ? _current : _msg.type();
+  return type == msgs::Marker::BOX || type == msgs::Marker::CYLINDER ||
+      type == msgs::Marker::SPHERE;
+}
+
+/////////////////////////////////////////////////
+void MarkerBatcher::Set(const std::string &_ns, const uint64_t _id,
+    const msgs::Marker::Type _type, const rendering::VisualPtr &_visual,
+    const rendering::MaterialPtr &_material)
+{
+  const auto type =
+      _type == msgs::Marker::NONE ? this->Type(_ns, _id) : _type;
+
+  // Unit meshes have the same size as the marker primitives
+  std::string meshName = "unit_box";
+  if (type == msgs::Marker::CYLINDER)
+    meshName = "unit_cylinder";
+  else if (type == msgs::Marker::SPHERE)
+    meshName = "unit_sphere";
+
+  auto triangles = this->dataPtr->lookup.Triangles(meshName);
+  if (nullptr == triangles)
+  {
+    ignerr << "Failed to find mesh [" << meshName << "] for marker with id["
+           << _id << "] in namespace[" << _ns << "]" << std::endl;
+    return;
+  }
+
+  auto &ids = this->dataPtr->locations[_ns];
+  auto it = ids.find(_id);
+  if (it != ids.end())
+  {
+    // Same batch, rewrite the marker's vertices in place if it has the
+    // same shape
+    auto &batch = this->dataPtr->batches[it->second];
+    if (batch.material == _material)
+    {
+      auto &member = batch.members[_id];
+      member.visual = _visual;
+      member.type = type;
+      if (member.triangles == triangles)
+      {
+        batch.changed.push_back(_id);
+      }
+      else
+      {
+        member.triangles = triangles;
+        batch.rebuild = true;
+      }
+      this->dataPtr->MarkDirty(it->second);
+      return;
+    }
+
+    // The material changed, move to another batch
+    this->dataPtr->RemoveMember(it->second, _id);
+    ids.erase(it);
+  }
+
+  const std::size_t index = this->dataPtr->FindBatch(_ns, _material,
+      triangles->size());
+  auto &batch = this->dataPtr->batches[index];
+
+  BatchMember member;
+  member.visual = _visual;
+  member.type = type;
+  member.triangles = triangles;
+  member.offset = batch.vertexCount;
+  batch.vertexCount += triangles->size();
+  batch.members[_id] = std::move(member);
+  batch.changed.push_back(_id);
+
+  ids[_id] = index;
+  this->dataPtr->MarkDirty(index);
+}
+
+/////////////////////////////////////////////////
+msgs::Marker::Type MarkerBatcher::Type(const std::string &_ns,
+    const uint64_t _id) const
+{
+  auto nsIt = this->dataPtr->locations.find(_ns);
+  if (nsIt == this->dataPtr->locations.end())
+    return msgs::Marker::NONE;
+
+  auto it = nsIt->second.find(_id);
+  if (it == nsIt->second.end())
+    return msgs::Marker::NONE;
+
+  const auto &members = this->dataPtr->batches[it->second].members;
+  auto member = members.find(_id);
+  return member == members.end() ? msgs::Marker::NONE : member->second.type;
+}
+
+/////////////////////////////////////////////////
+rendering::MaterialPtr MarkerBatcher::Material(const std::string &_ns,
+    const uint64_t _id) const
+{
+  auto nsIt = this->dataPtr->locations.find(_ns);
+  if (nsIt == this->dataPtr->locations.end())
+    return nullptr;
+
+  auto it = nsIt->second.find(_id);
+  if (it == nsIt->second.end())
+    return nullptr;
+
+  return this->dataPtr->batches[it->second].material;
+}
+
+/////////////////////////////////////////////////
+bool MarkerBatcher::Remove(const std::string &_ns, const uint64_t _id)
+{
+  auto nsIt = this->dataPtr->locations.find(_ns);
+  if (nsIt == this->dataPtr->locations.end())
+    return false;
+
+  auto it = nsIt->second.find(_id);
+  if (it == nsIt->second.end())
+    return false;
+
+  this->dataPtr->RemoveMember(it->second, _id);
+  nsIt->second.erase(it);
+  if (nsIt->second.empty())
+    this->dataPtr->locations.erase(nsIt);
+  return true;
+}
+
+/////////////////////////////////////////////////
+void MarkerBatcher::RemoveNamespace(const std::string &_ns)
+{
+  auto nsIt = this->dataPtr->locations.find(_ns);
+  if (nsIt == this->dataPtr->locations.end())
+    return;
+
+  for (const auto &location : nsIt->second)
+    this->dataPtr->RemoveMember(location.second, location.first);
+  this->dataPtr->locations.erase(nsIt);
+}
+
+/////////////////////////////////////////////////
+void MarkerBatcher::Clear()
+{
+  for (std::size_t i = 0u; i < this->dataPtr->batches.size(); ++i)
+  {
+    auto &batch = this->dataPtr->batches[i];
+    if (batch.members.empty())
+      continue;
+
+    batch.members.clear();
+    batch.rebuild = true;
+    this->dataPtr->MarkDirty(i);
+  }
+  this->dataPtr->locations.clear();
+}
+
+/////////////////////////////////////////////////
+void MarkerBatcher::Update()
+{
+  for (const auto index : this->dataPtr->dirtyBatches)
+  {
+    auto &batch = this->dataPtr->batches[index];
+    if (batch.rebuild)
+      this->dataPtr->Rebuild(batch);
+    else
+      this->dataPtr->Write(batch);
+
+    batch.changed.clear();
+    batch.rebuild = false;
+    batch.dirty = false;
+    batch.visual->SetVisible(!batch.members.empty());
+  }
+  this->dataPtr->dirtyBatches.clear();
+}
+
+/////////////////////////////////////////////////
+std::size_t MarkerBatcherPrivate::FindBatch(const std::string &_ns,
+    const rendering::MaterialPtr &_material, const std::size_t _vertexCount)
+{
+  // Material names are unique, and cached materials are shared by all
+  // markers with the same appearance
+  auto fits = [&](const std::size_t _index)
+  {
+    return this->batches[_index].vertexCount + _vertexCount <=
+        TriangleBatches::kMaxVertices;
+  };
+  auto create = [&]
+  {
+    MarkerBatch batch;
+    batch.material = _material;
+    batch.visual = TriangleBatches::CreateVisual(this->scene, _material,
+        batch.marker);
+    this->batches.push_back(std::move(batch));
+    return this->batches.size() - 1;
+  };
+  return this->lookup.Find(_ns + "::" + _material->Name(), fits, create);
+}
+
+/////////////////////////////////////////////////
+void MarkerBatcherPrivate::RemoveMember(const std::size_t _index,
+    const uint64_t _id)
+{
+  auto &batch = this->batches[_index];
+  batch.members.erase(_id);
+  batch.rebuild = true;
+  this->MarkDirty(_index);
+}
+
+/////////////////////////////////////////////////
+void MarkerBatcherPrivate::MarkDirty(const std::size_t _index)
+{
+  auto &batch = this->batches[_index];
+  if (!batch.dirty)
+  {
+    batch.dirty = true;
+    this->dirtyBatches.push_back(_index);
+  }
+}
+
+/////////////////////////////////////////////////
+void MarkerBatcherPrivate::Write(MarkerBatch &_batch)
+{
+  const math::Color color = _batch.material->Diffuse();
+  for (const auto id : _batch.changed)
+  {
+    auto it = _batch.members.find(id);
+    if (it == _batch.members.end())
+      continue;
+
+    auto &member = it->second;
+    auto visual = member.visual.lock();
+    if (!visual)
+    {
+      this->Rebuild(_batch);
+      return;
+    }
+
+    const math::Pose3d pose = visual->WorldPose();
+    const math::Vector3d scale = visual->WorldScale();
+    if (member.drawn)
+    {
+      // Only this marker's range of the buffer changes
+      TriangleBatches::Set(_batch.marker, member.offset, *member.triangles,
+          pose, scale);
+    }
+    else
+    {
+      // New markers are appended in the order of their offsets
+      TriangleBatches::Add(_batch.marker, *member.triangles, pose, scale,
+          color);
+      member.drawn = true;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void MarkerBatcherPrivate::Rebuild(MarkerBatch &_batch)
+{
+  _batch.marker->ClearPoints();
+
+  const math::Color color = _batch.material->Diffuse();
+  std::size_t offset = 0u;
+  for (auto it = _batch.members.begin(); it != _batch.members.end();)
+  {
+    auto &member = it->second;
+    auto visual = member.visual.lock();
+    if (!visual)
+    {
+      // The visual was deleted without removing the marker
+      it = _batch.members.erase(it);
+      continue;
+    }
+
+    TriangleBatches::Add(_batch.marker, *member.triangles,
+        visual->WorldPose(), visual->WorldScale(), color);
+
+    member.offset = offset;
+    member.drawn = true;
+    offset += member.triangles->size();
+    ++it;
+  }
+  _batch.vertexCount = offset;
+}
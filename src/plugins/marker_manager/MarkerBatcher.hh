@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_MARKERMANAGER_MARKERBATCHER_HH_
+#define GZ_GUI_PLUGINS_MARKERMANAGER_MARKERBATCHER_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <gz/msgs/marker.pb.h>
+#include <gz/rendering/Material.hh>
+#include <gz/rendering/Scene.hh>
+#include <gz/rendering/Visual.hh>
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  class MarkerBatcherPrivate;
+
+  /// \brief Draws the box, cylinder and sphere markers of a namespace which
+  /// share a material as one dynamic triangle list, with one draw call per
+  /// batch instead of one per marker.
+  ///
+  /// Each marker keeps its own visual, without geometry, which holds its
+  /// pose and scale and can still be looked up, listed and deleted. The
+  /// vertices of each marker are a sub-range of its batch's vertex buffer:
+  /// a modified marker only rewrites its own range, and new markers are
+  /// appended. The buffer is only rebuilt when a marker is removed or
+  /// changes shape.
+  ///
+  /// Markers are treated as static: their vertices are computed from the
+  /// world pose of their visual when they're set, so markers attached to a
+  /// parent visual aren't supported.
+  class MarkerBatcher
+  {
+    /// \brief Constructor
+    /// \param[in] _scene Scene where batches are created.
+    public: explicit MarkerBatcher(const rendering::ScenePtr &_scene);
+
+    /// \brief Destructor
+    public: ~MarkerBatcher();
+
+    /// \brief Check whether a marker can be drawn by a batch.
+    /// \param[in] _msg Marker msg adding or modifying the marker.
+    /// \param[in] _current Type of the marker if it's batched already, see
+    /// Type. Messages with type NONE keep it.
+    /// \return True for boxes, cylinders and spheres without parent.
+    public: static bool Supports(const msgs::Marker &_msg,
+        const msgs::Marker::Type _current = msgs::Marker::NONE);
+
+    /// \brief Add a marker to a batch, or update it. It is drawn from the
+    /// next call to Update.
+    /// \param[in] _ns Marker namespace.
+    /// \param[in] _id Marker id.
+    /// \param[in] _type Marker type, which Supports accepted. NONE keeps
+    /// the type of a batched marker.
+    /// \param[in] _visual Visual of the marker, without geometry, already
+    /// posed and scaled.
+    /// \param[in] _material Shared material, see MaterialCache.
+    public: void Set(const std::string &_ns, const uint64_t _id,
+        const msgs::Marker::Type _type, const rendering::VisualPtr &_visual,
+        const rendering::MaterialPtr &_material);
+
+    /// \brief Get the type of a batched marker.
+    /// \param[in] _ns Marker namespace.
+    /// \param[in] _id Marker id.
+    /// \return Type, NONE if the marker isn't batched.
+    public: msgs::Marker::Type Type(const std::string &_ns,
+        const uint64_t _id) const;
+
+    /// \brief Get the material of a batched marker.
+    /// \param[in] _ns Marker namespace.
+    /// \param[in] _id Marker id.
+    /// \return Material, null if the marker isn't batched.
+    public: rendering::MaterialPtr Material(const std::string &_ns,
+        const uint64_t _id) const;
+
+    /// \brief Remove a marker from its batch.
+    /// \param[in] _ns Marker namespace.
+    /// \param[in] _id Marker id.
+    /// \return True if the marker was batched.
+    public: bool Remove(const std::string &_ns, const uint64_t _id);
+
+    /// \brief Remove all markers of a namespace.
+    /// \param[in] _ns Marker namespace.
+    public: void RemoveNamespace(const std::string &_ns);
+
+    /// \brief Remove all markers.
+    public: void Clear();
+
+    /// \brief Write the vertices of the markers which were set, and rebuild
+    /// the batches whose markers were removed.
+    public: void Update();
+
+    /// \internal
+    /// \brief Pointer to private data.
+    private: std::unique_ptr<MarkerBatcherPrivate> dataPtr;
+  };
+}
+}
+}
+
+#endif
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <gz/msgs/marker.pb.h>
+
+#include "gz/gui/config.hh"
+
+#include "MarkerBatcher.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+TEST(MarkerBatcherTest, Supports)
+{
+  msgs::Marker msg;
+  msg.set_action(msgs::Marker::ADD_MODIFY);
+
+  for (const auto type : {msgs::Marker::BOX, msgs::Marker::CYLINDER,
+      msgs::Marker::SPHERE})
+  {
+    msg.set_type(type);
+    EXPECT_TRUE(MarkerBatcher::Supports(msg)) << type;
+  }
+
+  for (const auto type : {msgs::Marker::NONE, msgs::Marker::LINE_LIST,
+      msgs::Marker::POINTS, msgs::Marker::TEXT, msgs::Marker::CAPSULE,
+      msgs::Marker::TRIANGLE_LIST})
+  {
+    msg.set_type(type);
+    EXPECT_FALSE(MarkerBatcher::Supports(msg)) << type;
+  }
+
+  // Markers attached to a parent move with it, so they aren't batched
+  msg.set_type(msgs::Marker::BOX);
+  msg.set_parent("link");
+  EXPECT_FALSE(MarkerBatcher::Supports(msg));
+}
+
+/////////////////////////////////////////////////
+TEST(MarkerBatcherTest, SupportsUpdateWithoutType)
+{
+  // A pose-only update of a batched marker keeps it batched
+  msgs::Marker msg;
+  msg.set_action(msgs::Marker::ADD_MODIFY);
+  msg.set_type(msgs::Marker::NONE);
+  msg.mutable_pose()->mutable_position()->set_x(1.0);
+  EXPECT_TRUE(MarkerBatcher::Supports(msg, msgs::Marker::SPHERE));
+  EXPECT_TRUE(MarkerBatcher::Supports(msg, msgs::Marker::BOX));
+
+  // Unless the marker isn't batched
+  EXPECT_FALSE(MarkerBatcher::Supports(msg, msgs::Marker::NONE));
+  EXPECT_FALSE(MarkerBatcher::Supports(msg));
+
+  // A new type replaces the batched one
+  msg.set_type(msgs::Marker::LINE_STRIP);
+  EXPECT_FALSE(MarkerBatcher::Supports(msg, msgs::Marker::SPHERE));
+  msg.set_type(msgs::Marker::CYLINDER);
+  EXPECT_TRUE(MarkerBatcher::Supports(msg, msgs::Marker::SPHERE));
+
+  // Attaching a batched marker to a parent takes it out of its batch
+  msg.set_type(msgs::Marker::NONE);
+  msg.set_parent("link");
+  EXPECT_FALSE(MarkerBatcher::Supports(msg, msgs::Marker::SPHERE));
+}
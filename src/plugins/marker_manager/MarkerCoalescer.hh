@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_MARKERMANAGER_MARKERCOALESCER_HH_
+#define GZ_GUI_PLUGINS_MARKERMANAGER_MARKERCOALESCER_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gz/msgs/marker.pb.h>
+#include <gz/msgs/marker_v.pb.h>
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  /// \brief Drops queued marker updates which are overwritten by a later
+  /// update of the same marker before they are drawn, so that the work of a
+  /// frame depends on the number of markers touched instead of the number
+  /// of messages received.
+  ///
+  /// An ADD_MODIFY is dropped if a later ADD_MODIFY of the same namespace
+  /// and id follows with no delete of that marker in between, and the later
+  /// one sets every optional field that the earlier one sets. Updates which
+  /// only set some fields are all kept, since each of them changes part of
+  /// the marker. Deletes are always kept, in order.
+  ///
+  /// An update without type takes the type of the last typed update the
+  /// manager processed, of any marker. So a typed update is also kept if an
+  /// update without type of any marker follows it before it's overwritten.
+  class MarkerCoalescer
+  {
+    /// \brief Get the marker messages of a queue which must be processed.
+    /// \param[in] _batches Queued batches of marker messages, oldest first.
+    /// \return Messages to process, in order. They point into the batches.
+    public: static std::vector<const msgs::Marker *> Coalesce(
+        const std::vector<std::shared_ptr<const msgs::Marker_V>> &_batches)
+    {
+      std::vector<const msgs::Marker *> result;
+
+      // Last ADD_MODIFY of each marker since it was last deleted
+      std::unordered_map<std::string,
+          std::unordered_map<uint64_t, Pending>> pending;
+
+      // Number of ADD_MODIFY without type so far
+      std::size_t untyped{0u};
+
+      for (const auto &batch : _batches)
+      {
+        for (const auto &marker : batch->marker())
+        {
+          if (marker.action() == msgs::Marker::ADD_MODIFY)
+          {
+            // Markers without id get a new random id each time
+            if (marker.id() != 0u)
+            {
+              auto &ids = pending[marker.ns()];
+              auto it = ids.find(marker.id());
+              if (it == ids.end())
+              {
+                ids.emplace(marker.id(), Pending{result.size(), untyped});
+              }
+              else
+              {
+                const msgs::Marker &earlier = *result[it->second.index];
+                if (Supersedes(marker, earlier) &&
+                    (earlier.type() == msgs::Marker::NONE ||
+                     it->second.untyped == untyped))
+                {
+                  result[it->second.index] = nullptr;
+                }
+                it->second = Pending{result.size(), untyped};
+              }
+            }
+            if (marker.type() == msgs::Marker::NONE)
+              ++untyped;
+          }
+          else if (marker.action() == msgs::Marker::DELETE_MARKER)
+          {
+            auto nsIt = pending.find(marker.ns());
+            if (nsIt != pending.end())
+              nsIt->second.erase(marker.id());
+          }
+          else if (marker.action() == msgs::Marker::DELETE_ALL &&
+              !marker.ns().empty())
+          {
+            pending.erase(marker.ns());
+          }
+          else
+          {
+            pending.clear();
+          }
+          result.push_back(&marker);
+        }
+      }
+
+      result.erase(std::remove(result.begin(), result.end(), nullptr),
+          result.end());
+      return result;
+    }
+
+    /// \brief Check whether an update overwrites all that an earlier update
+    /// of the same marker sets.
+    /// \param[in] _later Later update.
+    /// \param[in] _earlier Earlier update.
+    /// \return True if the earlier update can be dropped.
+    public: static bool Supersedes(const msgs::Marker &_later,
+        const msgs::Marker &_earlier)
+    {
+      // Type NONE keeps the current type, which may be the earlier one
+      return (_earlier.type() == msgs::Marker::NONE ||
+              _later.type() != msgs::Marker::NONE) &&
+          (!_earlier.has_pose() || _later.has_pose()) &&
+          (!_earlier.has_scale() || _later.has_scale()) &&
+          (!_earlier.has_material() || _later.has_material()) &&
+          (_earlier.point_size() == 0 || _later.point_size() > 0) &&
+          (_earlier.parent().empty() || !_later.parent().empty());
+    }
+
+    /// \brief Last ADD_MODIFY of a marker.
+    private: struct Pending
+    {
+      /// \brief Index in the result.
+      std::size_t index;
+
+      /// \brief Number of ADD_MODIFY without type before it.
+      std::size_t untyped;
+    };
+  };
+}
+}
+}
+
+#endif
@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gz/msgs/marker.pb.h>
+#include <gz/msgs/marker_v.pb.h>
+
+#include "gz/gui/config.hh"
+
+#include "MarkerCoalescer.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+/// \brief Add a marker message to a batch.
+msgs::Marker *AddMarker(msgs::Marker_V &_batch, const std::string &_ns,
+    uint64_t _id, msgs::Marker::Action _action = msgs::Marker::ADD_MODIFY)
+{
+  auto marker = _batch.add_marker();
+  marker->set_ns(_ns);
+  marker->set_id(_id);
+  marker->set_action(_action);
+  return marker;
+}
+
+/////////////////////////////////////////////////
+TEST(MarkerCoalescerTest, LastUpdateWins)
+{
+  auto first = std::make_shared<msgs::Marker_V>();
+  auto second = std::make_shared<msgs::Marker_V>();
+  for (unsigned int i = 0; i < 50; ++i)
+  {
+    AddMarker(*first, "path", 1u)->mutable_pose()->mutable_position()->set_x(
+        i);
+    AddMarker(*first, "path", 2u);
+  }
+  AddMarker(*second, "path", 1u)->mutable_pose()->mutable_position()->set_x(
+      50);
+  AddMarker(*second, "other", 1u);
+
+  auto result = MarkerCoalescer::Coalesce({first, second});
+  ASSERT_EQ(3u, result.size());
+  EXPECT_EQ(2u, result[0]->id());
+  EXPECT_EQ(1u, result[1]->id());
+  EXPECT_DOUBLE_EQ(50.0, result[1]->pose().position().x());
+  EXPECT_EQ("other", result[2]->ns());
+
+  // Markers without id are all new markers
+  auto anonymous = std::make_shared<msgs::Marker_V>();
+  AddMarker(*anonymous, "path", 0u);
+  AddMarker(*anonymous, "path", 0u);
+  EXPECT_EQ(2u, MarkerCoalescer::Coalesce({anonymous}).size());
+}
+
+/////////////////////////////////////////////////
+TEST(MarkerCoalescerTest, PartialUpdates)
+{
+  auto batch = std::make_shared<msgs::Marker_V>();
+
+  // The second update doesn't set the points of the first
+  auto marker = AddMarker(*batch, "ns", 1u);
+  marker->add_point()->set_x(1.0);
+  AddMarker(*batch, "ns", 1u)->mutable_scale()->set_x(2.0);
+
+  // This one sets everything the second one does
+  marker = AddMarker(*batch, "ns", 1u);
+  marker->mutable_scale()->set_x(3.0);
+  marker->set_parent("link");
+
+  auto result = MarkerCoalescer::Coalesce({batch});
+  ASSERT_EQ(2u, result.size());
+  EXPECT_EQ(1, result[0]->point_size());
+  EXPECT_EQ("link", result[1]->parent());
+
+  // An update without type keeps the type of the first one
+  batch = std::make_shared<msgs::Marker_V>();
+  marker = AddMarker(*batch, "ns", 2u);
+  marker->set_type(msgs::Marker::SPHERE);
+  marker->mutable_pose()->mutable_position()->set_x(1.0);
+  AddMarker(*batch, "ns", 2u)->mutable_pose()->mutable_position()->set_x(
+      2.0);
+
+  result = MarkerCoalescer::Coalesce({batch});
+  ASSERT_EQ(2u, result.size());
+  EXPECT_EQ(msgs::Marker::SPHERE, result[0]->type());
+  EXPECT_DOUBLE_EQ(2.0, result[1]->pose().position().x());
+
+  // An update with a type drops the one without type
+  marker = AddMarker(*batch, "ns", 2u);
+  marker->set_type(msgs::Marker::BOX);
+  marker->mutable_pose()->mutable_position()->set_x(3.0);
+
+  result = MarkerCoalescer::Coalesce({batch});
+  ASSERT_EQ(2u, result.size());
+  EXPECT_EQ(msgs::Marker::SPHERE, result[0]->type());
+  EXPECT_EQ(msgs::Marker::BOX, result[1]->type());
+  EXPECT_DOUBLE_EQ(3.0, result[1]->pose().position().x());
+}
+
+/////////////////////////////////////////////////
+TEST(MarkerCoalescerTest, Deletes)
+{
+  auto batch = std::make_shared<msgs::Marker_V>();
+  AddMarker(*batch, "ns", 1u);
+  AddMarker(*batch, "ns", 1u, msgs::Marker::DELETE_MARKER);
+  AddMarker(*batch, "ns", 1u);
+  AddMarker(*batch, "ns", 2u);
+  AddMarker(*batch, "ns", 0u, msgs::Marker::DELETE_ALL);
+  AddMarker(*batch, "ns", 2u);
+  AddMarker(*batch, "", 0u, msgs::Marker::DELETE_ALL);
+  AddMarker(*batch, "ns", 2u);
+  AddMarker(*batch, "ns", 2u);
+
+  // Only the last update is dropped, the others are separated by deletes
+  auto result = MarkerCoalescer::Coalesce({batch});
+  ASSERT_EQ(8u, result.size());
+  EXPECT_EQ(msgs::Marker::DELETE_MARKER, result[1]->action());
+  EXPECT_EQ(msgs::Marker::DELETE_ALL, result[4]->action());
+  EXPECT_EQ(msgs::Marker::DELETE_ALL, result[6]->action());
+  EXPECT_EQ(msgs::Marker::ADD_MODIFY, result[7]->action());
+}
+
+/////////////////////////////////////////////////
+TEST(MarkerCoalescerTest, UntypedUpdates)
+{
+  // B has no type, so it's drawn with the type of the last typed update,
+  // which is A's sphere. A's sphere must be kept for that.
+  auto batch = std::make_shared<msgs::Marker_V>();
+  AddMarker(*batch, "ns", 1u)->set_type(msgs::Marker::SPHERE);
+  AddMarker(*batch, "ns", 2u);
+  AddMarker(*batch, "ns", 1u)->set_type(msgs::Marker::BOX);
+
+  auto result = MarkerCoalescer::Coalesce({batch});
+  ASSERT_EQ(3u, result.size());
+  EXPECT_EQ(msgs::Marker::SPHERE, result[0]->type());
+  EXPECT_EQ(2u, result[1]->id());
+  EXPECT_EQ(msgs::Marker::BOX, result[2]->type());
+
+  // Without the untyped update in between, the sphere is overwritten
+  auto typed = std::make_shared<msgs::Marker_V>();
+  AddMarker(*typed, "ns", 1u)->set_type(msgs::Marker::SPHERE);
+  AddMarker(*typed, "ns", 2u)->set_type(msgs::Marker::CYLINDER);
+  AddMarker(*typed, "ns", 1u)->set_type(msgs::Marker::BOX);
+
+  result = MarkerCoalescer::Coalesce({typed});
+  ASSERT_EQ(2u, result.size());
+  EXPECT_EQ(2u, result[0]->id());
+  EXPECT_EQ(msgs::Marker::BOX, result[1]->type());
+}
@@ -0,0 +1,235 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_MARKERMANAGER_MARKERLIFETIMES_HH_
+#define GZ_GUI_PLUGINS_MARKERMANAGER_MARKERLIFETIMES_HH_
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  /// \brief Expiry times of the markers which have a lifetime, ordered in
+  /// a min-heap so that expired markers are found without visiting the
+  /// others. Markers without a lifetime aren't tracked at all.
+  ///
+  /// Changing or removing an expiry leaves a stale heap entry, which is
+  /// skipped when it reaches the top. The heap is rebuilt once it holds
+  /// more than twice as many entries as tracked markers, so its size stays
+  /// linear in the number of markers.
+  class MarkerLifetimes
+  {
+    /// \brief Sim time type.
+    public: using Duration = std::chrono::steady_clock::duration;
+
+    /// \brief Marker namespace and id.
+    public: using Marker = std::pair<std::string, uint64_t>;
+
+    /// \brief Set when a marker expires, replacing its previous expiry.
+    /// \param[in] _ns Marker namespace.
+    /// \param[in] _id Marker id.
+    /// \param[in] _expiry Sim time at which the marker expires.
+    public: void Set(const std::string &_ns, const uint64_t _id,
+        const Duration _expiry)
+    {
+      auto &ids = this->expiries[_ns];
+      auto inserted = ids.emplace(_id, Entry());
+      if (inserted.second)
+        ++this->size;
+      inserted.first->second.expiry = _expiry;
+      inserted.first->second.generation = ++this->generation;
+
+      this->heap.push_back({_expiry, this->generation, _ns, _id});
+      std::push_heap(this->heap.begin(), this->heap.end(), Later);
+      this->Compact();
+    }
+
+    /// \brief Stop tracking a marker, e.g. if it's deleted or its lifetime
+    /// is removed.
+    /// \param[in] _ns Marker namespace.
+    /// \param[in] _id Marker id.
+    public: void Remove(const std::string &_ns, const uint64_t _id)
+    {
+      auto nsIt = this->expiries.find(_ns);
+      if (nsIt == this->expiries.end() || nsIt->second.erase(_id) == 0u)
+        return;
+
+      --this->size;
+      if (nsIt->second.empty())
+        this->expiries.erase(nsIt);
+      this->Compact();
+    }
+
+    /// \brief Stop tracking all markers of a namespace.
+    /// \param[in] _ns Marker namespace.
+    public: void RemoveNamespace(const std::string &_ns)
+    {
+      auto nsIt = this->expiries.find(_ns);
+      if (nsIt == this->expiries.end())
+        return;
+
+      this->size -= nsIt->second.size();
+      this->expiries.erase(nsIt);
+      this->Compact();
+    }
+
+    /// \brief Stop tracking all markers.
+    public: void Clear()
+    {
+      this->expiries.clear();
+      this->heap.clear();
+      this->size = 0u;
+    }
+
+    /// \brief Stop tracking the markers which expired, and get them.
+    /// \param[in] _now Current sim time.
+    /// \return Markers whose expiry is at or before the current time,
+    /// earliest first.
+    public: std::vector<Marker> PopExpired(const Duration _now)
+    {
+      std::vector<Marker> result;
+      while (!this->heap.empty() && this->heap.front().expiry <= _now)
+      {
+        std::pop_heap(this->heap.begin(), this->heap.end(), Later);
+        Item item = std::move(this->heap.back());
+        this->heap.pop_back();
+
+        // Skip entries which were replaced or removed since
+        auto nsIt = this->expiries.find(item.ns);
+        if (nsIt == this->expiries.end())
+          continue;
+        auto idIt = nsIt->second.find(item.id);
+        if (idIt == nsIt->second.end() ||
+            idIt->second.generation != item.generation)
+        {
+          continue;
+        }
+
+        nsIt->second.erase(idIt);
+        if (nsIt->second.empty())
+          this->expiries.erase(nsIt);
+        --this->size;
+        result.emplace_back(std::move(item.ns), item.id);
+      }
+      return result;
+    }
+
+    /// \brief Stop tracking all markers, and get them, e.g. to remove all
+    /// markers with a lifetime when sim time goes backwards.
+    /// \return All tracked markers.
+    public: std::vector<Marker> TakeAll()
+    {
+      std::vector<Marker> result;
+      result.reserve(this->size);
+      for (const auto &ns : this->expiries)
+      {
+        for (const auto &id : ns.second)
+          result.emplace_back(ns.first, id.first);
+      }
+      this->Clear();
+      return result;
+    }
+
+    /// \brief Get the number of tracked markers.
+    /// \return Number of markers with a lifetime.
+    public: std::size_t Size() const
+    {
+      return this->size;
+    }
+
+    /// \brief Expiry of a tracked marker.
+    private: struct Entry
+    {
+      /// \brief Sim time at which the marker expires.
+      Duration expiry{0};
+
+      /// \brief Generation of the heap entry which is current.
+      uint64_t generation{0u};
+    };
+
+    /// \brief Heap entry.
+    private: struct Item
+    {
+      /// \brief Sim time at which the marker expires.
+      Duration expiry;
+
+      /// \brief Generation when the entry was pushed.
+      uint64_t generation;
+
+      /// \brief Marker namespace.
+      std::string ns;
+
+      /// \brief Marker id.
+      uint64_t id;
+    };
+
+    /// \brief Heap order, earliest expiry on top.
+    /// \param[in] _a First entry.
+    /// \param[in] _b Second entry.
+    /// \return True if the first entry expires later.
+    private: static bool Later(const Item &_a, const Item &_b)
+    {
+      return _a.expiry > _b.expiry;
+    }
+
+    /// \brief Rebuild the heap without its stale entries, once they are
+    /// the majority.
+    private: void Compact()
+    {
+      if (this->heap.size() <= 2u * this->size + 64u)
+        return;
+
+      this->heap.clear();
+      for (const auto &ns : this->expiries)
+      {
+        for (const auto &id : ns.second)
+        {
+          this->heap.push_back(
+              {id.second.expiry, id.second.generation, ns.first, id.first});
+        }
+      }
+      std::make_heap(this->heap.begin(), this->heap.end(), Later);
+    }
+
+    /// \brief Current expiry of each tracked marker, by namespace and id.
+    private: std::unordered_map<std::string,
+        std::unordered_map<uint64_t, Entry>> expiries;
+
+    /// \brief Min-heap of expiries, which may hold stale entries.
+    private: std::vector<Item> heap;
+
+    /// \brief Number of tracked markers.
+    private: std::size_t size{0u};
+
+    /// \brief Last generation handed out.
+    private: uint64_t generation{0u};
+  };
+}
+}
+}
+
+#endif
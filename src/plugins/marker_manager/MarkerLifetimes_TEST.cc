@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+
+#include "gz/gui/config.hh"
+
+#include "MarkerLifetimes.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+using namespace std::chrono_literals;
+
+/////////////////////////////////////////////////
+TEST(MarkerLifetimesTest, PopExpired)
+{
+  MarkerLifetimes lifetimes;
+  lifetimes.Set("a", 1u, 3s);
+  lifetimes.Set("a", 2u, 1s);
+  lifetimes.Set("b", 1u, 2s);
+  EXPECT_EQ(3u, lifetimes.Size());
+
+  EXPECT_TRUE(lifetimes.PopExpired(500ms).empty());
+
+  // Earliest first, up to and including the current time
+  auto expired = lifetimes.PopExpired(2s);
+  ASSERT_EQ(2u, expired.size());
+  EXPECT_EQ(MarkerLifetimes::Marker("a", 2u), expired[0]);
+  EXPECT_EQ(MarkerLifetimes::Marker("b", 1u), expired[1]);
+  EXPECT_EQ(1u, lifetimes.Size());
+
+  // Popped markers aren't returned again
+  expired = lifetimes.PopExpired(10s);
+  ASSERT_EQ(1u, expired.size());
+  EXPECT_EQ(MarkerLifetimes::Marker("a", 1u), expired[0]);
+  EXPECT_EQ(0u, lifetimes.Size());
+  EXPECT_TRUE(lifetimes.PopExpired(20s).empty());
+}
+
+/////////////////////////////////////////////////
+TEST(MarkerLifetimesTest, Modify)
+{
+  MarkerLifetimes lifetimes;
+  lifetimes.Set("a", 1u, 1s);
+  lifetimes.Set("a", 2u, 1s);
+  lifetimes.Set("a", 3u, 1s);
+
+  // Extended, removed, and the whole namespace of another one
+  lifetimes.Set("a", 1u, 5s);
+  lifetimes.Remove("a", 2u);
+  lifetimes.Set("b", 1u, 1s);
+  lifetimes.RemoveNamespace("b");
+  EXPECT_EQ(2u, lifetimes.Size());
+
+  auto expired = lifetimes.PopExpired(2s);
+  ASSERT_EQ(1u, expired.size());
+  EXPECT_EQ(MarkerLifetimes::Marker("a", 3u), expired[0]);
+
+  expired = lifetimes.PopExpired(5s);
+  ASSERT_EQ(1u, expired.size());
+  EXPECT_EQ(MarkerLifetimes::Marker("a", 1u), expired[0]);
+
+  // Removing untracked markers is fine
+  lifetimes.Remove("a", 1u);
+  lifetimes.RemoveNamespace("c");
+  EXPECT_EQ(0u, lifetimes.Size());
+}
+
+/////////////////////////////////////////////////
+TEST(MarkerLifetimesTest, ManyUpdates)
+{
+  // Stale entries are compacted away without losing current ones
+  MarkerLifetimes lifetimes;
+  for (unsigned int i = 0; i < 1000; ++i)
+    lifetimes.Set("a", i % 10u, std::chrono::seconds(i));
+  EXPECT_EQ(10u, lifetimes.Size());
+
+  EXPECT_TRUE(lifetimes.PopExpired(989s).empty());
+  auto expired = lifetimes.PopExpired(1000s);
+  ASSERT_EQ(10u, expired.size());
+  for (unsigned int i = 0; i < 10; ++i)
+    EXPECT_EQ(i, expired[i].second);
+}
+
+/////////////////////////////////////////////////
+TEST(MarkerLifetimesTest, TakeAll)
+{
+  MarkerLifetimes lifetimes;
+  lifetimes.Set("a", 1u, 1s);
+  lifetimes.Set("b", 2u, 2s);
+
+  auto all = lifetimes.TakeAll();
+  std::sort(all.begin(), all.end());
+  ASSERT_EQ(2u, all.size());
+  EXPECT_EQ(MarkerLifetimes::Marker("a", 1u), all[0]);
+  EXPECT_EQ(MarkerLifetimes::Marker("b", 2u), all[1]);
+  EXPECT_EQ(0u, lifetimes.Size());
+  EXPECT_TRUE(lifetimes.PopExpired(10s).empty());
+}
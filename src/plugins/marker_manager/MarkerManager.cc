@@ -16,9 +16,16 @@
 */
 
 #include <algorithm>
-#include <list>
+#include <atomic>
+#include <chrono>
+#include <cmath>
 #include <map>
+#include <memory>
+#include <set>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include <QQmlProperty>
 
@@ -38,6 +45,7 @@
 
 #include <gz/plugin/Register.hh>
 
+#include <gz/rendering/Camera.hh>
 #include "gz/rendering/Marker.hh"
 #include <gz/rendering/RenderingIface.hh>
 #include <gz/rendering/Scene.hh>
@@ -49,7 +57,15 @@
 #include "gz/gui/Helpers.hh"
 #include "gz/gui/MainWindow.hh"
 
+#include "ArenaMessage.hh"
+#include "MarkerBatcher.hh"
+#include "MarkerCoalescer.hh"
+#include "MarkerLifetimes.hh"
 #include "MarkerManager.hh"
+#include "MarkerPoints.hh"
+#include "MaterialCache.hh"
+#include "PointLodBuilder.hh"
+#include "SubmissionQueue.hh"
 
 /// \brief Private data class for MarkerManager
 class ignition::gui::plugins::MarkerManagerPrivate
@@ -81,6 +97,17 @@ class ignition::gui::plugins::MarkerManagerPrivate
   public: bool OnMarkerMsgArray(const gz::msgs::Marker_V &_req,
               gz::msgs::Boolean &_res);
 
+  /// \brief Callback that receives the points of a marker, serialized.
+  /// \param[in] _data Serialized point cloud message.
+  /// \param[in] _size Size of the message in bytes.
+  /// \param[in] _info Message information.
+  public: void OnPointsRaw(const char *_data, const std::size_t _size,
+              const transport::MessageInfo &_info);
+
+  /// \brief Adds or modifies a marker and sets all of its points.
+  /// \param[in] _msg Point cloud, see MarkerPoints.
+  public: void ProcessPointsMsg(const gz::msgs::PointCloudPacked &_msg);
+
   /// \brief Subscriber callback when new world statistics are received
   public: void OnWorldStatsMsg(const gz::msgs::WorldStatistics &_msg);
 
@@ -97,31 +124,207 @@ class ignition::gui::plugins::MarkerManagerPrivate
                          const rendering::MarkerPtr &_markerPtr);
 
   /// \brief Converts a Gazebo msg material to Gazebo Rendering
-  //         material.
+  //         material. Markers with the same material share it, and
+  //         hold a reference in materialCache while they use it.
   //  \param[in] _msg The message data.
-  //  \return Converted rendering material, if any.
+  //  \return Shared rendering material, which must not be modified.
   public: rendering::MaterialPtr MsgToMaterial(
     const gz::msgs::Marker &_msg);
 
+  /// \brief Destroy the visual of a marker, and release the material of
+  /// its marker geometry
+  /// \param[in] _visualPtr Marker visual
+  public: void DestroyMarkerVisual(const rendering::VisualPtr &_visualPtr);
+
   /// \brief Converts a Gazebo msg render type to Gazebo Rendering
   /// \param[in] _msg The message data
   /// \return Converted rendering type, if any.
   public: gz::rendering::MarkerType MsgToType(
                     const gz::msgs::Marker &_msg);
 
+  /// \brief Adds or modifies a marker drawn by a batch.
+  /// \param[in] _ns Marker namespace.
+  /// \param[in] _id Marker id.
+  /// \param[in] _msg The message data, which the batcher supports.
+  public: void SetBatchedMarker(const std::string &_ns, const uint64_t _id,
+                                const gz::msgs::Marker &_msg);
+
+  /// \brief Track when a marker expires, or stop tracking it if the
+  /// message has no lifetime.
+  /// \param[in] _ns Marker namespace.
+  /// \param[in] _id Marker id.
+  /// \param[in] _msg The message data.
+  public: void SetLifetime(const std::string &_ns, const uint64_t _id,
+                           const gz::msgs::Marker &_msg);
+
+  /// \brief Check whether the points of a marker message are drawn with
+  /// levels of detail.
+  /// \param[in] _msg The message data.
+  /// \return True for points markers with more points than the budget.
+  public: bool UsesPointLod(const gz::msgs::Marker &_msg) const;
+
+  /// \brief Draws the points of a marker message with levels of detail if
+  /// there are too many, or stops doing so if the message sets other points.
+  /// \param[in] _ns Marker namespace.
+  /// \param[in] _id Marker id.
+  /// \param[in] _msg The message data.
+  /// \param[in] _visualPtr Visual of the marker.
+  /// \param[in] _markerPtr Marker, whose points SetMarker skipped if they
+  /// are drawn with levels of detail.
+  public: void SetPointLod(const std::string &_ns, const uint64_t _id,
+                           const gz::msgs::Marker &_msg,
+                           const rendering::VisualPtr &_visualPtr,
+                           const rendering::MarkerPtr &_markerPtr);
+
+  /// \brief Draws an even subset of the points of a marker within the
+  /// budget, and queues the points to build their levels of detail.
+  /// \param[in] _ns Marker namespace.
+  /// \param[in] _id Marker id.
+  /// \param[in] _visualPtr Visual of the marker.
+  /// \param[in] _markerPtr Marker whose points are set.
+  /// \param[in] _positions Points.
+  /// \param[in] _colors Color of each point, or empty.
+  /// \param[in] _color Color of the points if they have none.
+  public: void DrawPointLod(const std::string &_ns, const uint64_t _id,
+                            const rendering::VisualPtr &_visualPtr,
+                            const rendering::MarkerPtr &_markerPtr,
+                            std::vector<math::Vector3d> _positions,
+                            std::vector<math::Color> _colors,
+                            const math::Color &_color);
+
+  /// \brief Stop drawing a marker with levels of detail.
+  /// \param[in] _ns Marker namespace.
+  /// \param[in] _id Marker id.
+  public: void RemovePointLod(const std::string &_ns, const uint64_t _id);
+
+  /// \brief Take the levels of detail which were built, and draw each
+  /// marker with the level for its distance to the camera.
+  public: void UpdatePointLods();
+
+  /// \brief Find the camera of the user, which the levels of detail are
+  /// chosen for
+  /// \return Camera, null if there is none
+  public: rendering::CameraPtr UserCamera();
+
   //// \brief Pointer to the rendering scene
   public: rendering::ScenePtr scene{nullptr};
 
+  /// \brief Materials shared by markers with the same appearance
+  public: MaterialCache materialCache;
+
+  /// \brief Material of each marker drawn on its own, keyed by the name of
+  /// its geometry. Each holds a reference in materialCache, so materials
+  /// are destroyed once no marker uses them.
+  public: std::unordered_map<std::string, rendering::MaterialPtr>
+      markerMaterials;
+
+  /// \brief Names of the materials used by batches of markers. Batches are
+  /// hidden and reused instead of destroyed, so each material keeps a
+  /// single reference for them.
+  public: std::unordered_set<std::string> batchMaterials;
+
   /// \brief Mutex to protect message list.
   public: std::mutex mutex;
 
-  /// \brief List of marker message to process.
-  public: std::list<gz::msgs::Marker> markerMsgs;
+  /// \brief Batches of marker messages to process. Each batch is on its own
+  /// arena, which is freed at once after the batch is processed.
+  public: std::vector<std::shared_ptr<const gz::msgs::Marker_V>>
+      markerBatches;
+
+  /// \brief Marker messages submitted by plugins of this process through
+  /// events::MarkerRequest, which don't need the mutex.
+  public: SubmissionQueue<std::unique_ptr<gz::msgs::Marker>> submitted;
+
+  /// \brief Batches whose messages are being processed, kept alive until
+  /// all of them are.
+  public: std::vector<std::shared_ptr<const gz::msgs::Marker_V>>
+      pendingBatches;
+
+  /// \brief Messages of the pending batches left after coalescing.
+  public: std::vector<const gz::msgs::Marker *> pendingMarkers;
+
+  /// \brief Index of the next pending message to process.
+  public: std::size_t pendingIndex{0u};
+
+  /// \brief Time spent processing marker messages per frame. Zero or
+  /// negative processes everything in one frame.
+  public: std::chrono::duration<double, std::milli> budget{10.0};
+
+  /// \brief Number of marker messages and point clouds waiting to be
+  /// processed, updated on every frame.
+  public: std::atomic<int> backlog{0};
+
+  /// \brief Backlog last notified to QML.
+  public: int notifiedBacklog{0};
+
+  /// \brief Point clouds of markers to process.
+  public: std::vector<std::shared_ptr<const gz::msgs::PointCloudPacked>>
+      pointClouds;
+
+  /// \brief Decoded points, reused across clouds.
+  public: MarkerPoints points;
 
   /// \brief Map of visuals
   public: std::map<std::string,
       std::map<uint64_t, gz::rendering::VisualPtr>> visuals;
 
+  /// \brief Expiry of the markers which have a lifetime
+  public: MarkerLifetimes lifetimes;
+
+  /// \brief Namespaces whose markers are batched.
+  public: std::set<std::string> batchNamespaces;
+
+  /// \brief Draws the markers of batched namespaces, null if there are
+  /// none.
+  public: std::unique_ptr<MarkerBatcher> batcher;
+
+  /// \brief Points marker drawn with levels of detail
+  public: struct PointLodState
+  {
+    /// \brief Visual of the marker
+    rendering::VisualPtr::weak_type visual;
+
+    /// \brief Marker whose points are drawn
+    rendering::MarkerPtr::weak_type marker;
+
+    /// \brief Color of the points if the levels have no colors
+    math::Color color;
+
+    /// \brief Generation of the points being built, see
+    /// PointLodBuilder::Build
+    uint64_t generation{0u};
+
+    /// \brief Levels of detail, empty until they're built
+    std::vector<PointLodLevel> levels;
+
+    /// \brief Drawn level, the number of levels if none is
+    std::size_t level{0u};
+
+    /// \brief Center of the points, in the frame of the visual
+    math::Vector3d center;
+
+    /// \brief Radius of a sphere around the points
+    double radius{0.0};
+  };
+
+  /// \brief Points markers drawn with levels of detail
+  public: std::map<std::string, std::map<uint64_t, PointLodState>>
+      pointLods;
+
+  /// \brief Most points drawn for each points marker, zero to draw all
+  /// points.
+  public: std::size_t pointBudget{0u};
+
+  /// \brief Builds the levels of detail of points markers, null if there
+  /// is no point budget.
+  public: std::unique_ptr<PointLodBuilder> pointLodBuilder;
+
+  /// \brief Camera of the user, see UserCamera
+  public: rendering::CameraPtr::weak_type camera;
+
+  /// \brief Pixels a voxel of a level of detail may span on screen.
+  public: static constexpr double kPointLodPixels{2.0};
+
   /// \brief Gazebo node
   public: gz::transport::Node node;
 
@@ -129,10 +332,10 @@ class ignition::gui::plugins::MarkerManagerPrivate
   public: std::string topicName = "/marker";
 
   /// \brief Sim time according to world stats message
-  public: std::chrono::steady_clock::duration simTime;
+  public: std::chrono::steady_clock::duration simTime{0};
 
   /// \brief Previous sim time received
-  public: std::chrono::steady_clock::duration lastSimTime;
+  public: std::chrono::steady_clock::duration lastSimTime{0};
 
   /// \brief The last marker message received
   public: gz::msgs::Marker msg;
@@ -191,6 +394,28 @@ void MarkerManagerPrivate::Initialize()
   }
 
   igndbg << "Advertise " << this->topicName << "_array.\n";
+
+  if (!this->batchNamespaces.empty())
+    this->batcher = std::make_unique<MarkerBatcher>(this->scene);
+
+  if (this->pointBudget > 0u)
+    this->pointLodBuilder = std::make_unique<PointLodBuilder>(
+        this->pointBudget);
+
+  // Subscribe to the bulk points topic
+  auto pointsCb = [this](const char *_data, const std::size_t _size,
+      const transport::MessageInfo &_info)
+  {
+    this->OnPointsRaw(_data, _size, _info);
+  };
+  if (!this->node.SubscribeRaw(this->topicName + "/points", pointsCb,
+      gz::msgs::PointCloudPacked().GetTypeName()))
+  {
+    ignerr << "Unable to subscribe to the " << this->topicName
+           << "/points topic.\n";
+  }
+
+  igndbg << "Subscribe to " << this->topicName << "/points.\n";
 }
 
 /////////////////////////////////////////////////
@@ -205,48 +430,96 @@ void MarkerManagerPrivate::OnRender()
     this->Initialize();
   }
 
+  const auto start = std::chrono::steady_clock::now();
+  auto withinBudget = [&]()
+  {
+    return this->budget.count() <= 0.0 ||
+        std::chrono::steady_clock::now() - start < this->budget;
+  };
+
+  // Markers submitted in process go after the ones queued before them
+  auto submittedMarkers = this->submitted.TakeAll();
+
   std::lock_guard<std::mutex> lock(this->mutex);
-  // Process the marker messages.
-  for (auto markerIter = this->markerMsgs.begin();
-       markerIter != this->markerMsgs.end();)
+  if (!submittedMarkers.empty())
   {
-    this->ProcessMarkerMsg(*markerIter);
-    this->markerMsgs.erase(markerIter++);
+    auto batch = std::make_shared<gz::msgs::Marker_V>();
+    batch->mutable_marker()->Reserve(
+        static_cast<int>(submittedMarkers.size()));
+    for (auto &marker : submittedMarkers)
+      batch->mutable_marker()->AddAllocated(marker.release());
+    this->markerBatches.push_back(std::move(batch));
   }
 
-  // Erase any markers that have a lifetime.
-  for (auto mit = this->visuals.begin();
-       mit != this->visuals.end();)
+  // Process the marker messages within the frame budget, leaving the rest
+  // for the next frames. Queued batches are only taken once the previous
+  // ones are done, so that messages are processed in order. Updates which
+  // are overwritten by later ones are skipped.
+  while (true)
   {
-    for (auto it = mit->second.cbegin();
-         it != mit->second.cend(); ++it)
+    if (this->pendingIndex == this->pendingMarkers.size())
     {
-      if (it->second->GeometryCount() == 0u)
-        continue;
-
-      gz::rendering::MarkerPtr markerPtr =
-            std::dynamic_pointer_cast<gz::rendering::Marker>
-            (it->second->GeometryByIndex(0u));
-      if (markerPtr != nullptr)
-      {
-        if (markerPtr->Lifetime().count() != 0 &&
-            (markerPtr->Lifetime() <= this->simTime ||
-            this->simTime < this->lastSimTime))
-        {
-          this->scene->DestroyVisual(it->second);
-          it = mit->second.erase(it);
-          break;
-        }
-      }
+      this->pendingMarkers.clear();
+      this->pendingBatches.clear();
+      this->pendingIndex = 0u;
+      if (this->markerBatches.empty())
+        break;
+
+      this->pendingMarkers = MarkerCoalescer::Coalesce(this->markerBatches);
+      this->pendingBatches.swap(this->markerBatches);
+      continue;
     }
 
+    this->ProcessMarkerMsg(*this->pendingMarkers[this->pendingIndex++]);
+    if (!withinBudget())
+      break;
+  }
+
+  // Process the point clouds, at least one per frame
+  std::size_t clouds = 0u;
+  while (clouds < this->pointClouds.size() &&
+      (clouds == 0u || withinBudget()))
+  {
+    this->ProcessPointsMsg(*this->pointClouds[clouds++]);
+  }
+  this->pointClouds.erase(this->pointClouds.begin(),
+      this->pointClouds.begin() + clouds);
+
+  std::size_t backlogSize = this->pendingMarkers.size() - this->pendingIndex +
+      this->pointClouds.size();
+  for (const auto &batch : this->markerBatches)
+    backlogSize += batch->marker_size();
+  this->backlog = static_cast<int>(backlogSize);
+
+  // Erase the markers whose lifetime is over, or all markers that have a
+  // lifetime if sim time went backwards.
+  auto expired = this->simTime < this->lastSimTime ?
+      this->lifetimes.TakeAll() : this->lifetimes.PopExpired(this->simTime);
+  for (const auto &marker : expired)
+  {
+    auto nsIter = this->visuals.find(marker.first);
+    if (nsIter == this->visuals.end())
+      continue;
+
+    auto visualIter = nsIter->second.find(marker.second);
+    if (visualIter == nsIter->second.end())
+      continue;
+
+    if (this->batcher)
+      this->batcher->Remove(marker.first, marker.second);
+    this->DestroyMarkerVisual(visualIter->second);
+    nsIter->second.erase(visualIter);
+
     // Erase a namespace if it's empty
-    if (mit->second.empty())
-      mit = this->visuals.erase(mit);
-    else
-      ++mit;
+    if (nsIter->second.empty())
+      this->visuals.erase(nsIter);
   }
   this->lastSimTime = this->simTime;
+
+  this->UpdatePointLods();
+
+  if (this->batcher)
+    this->batcher->Update();
 }
 
 /////////////////////////////////////////////////
@@ -272,21 +545,109 @@ bool MarkerManagerPrivate::OnList(gz::msgs::Marker_V &_rep)
 /////////////////////////////////////////////////
 void MarkerManagerPrivate::OnMarkerMsg(const gz::msgs::Marker &_req)
 {
+  auto batch = ArenaMessage::Create<gz::msgs::Marker_V>(_req.ByteSizeLong());
+  batch->add_marker()->CopyFrom(_req);
+
   std::lock_guard<std::mutex> lock(this->mutex);
-  this->markerMsgs.push_back(_req);
+  this->markerBatches.push_back(std::move(batch));
 }
 
 /////////////////////////////////////////////////
 bool MarkerManagerPrivate::OnMarkerMsgArray(
     const gz::msgs::Marker_V&_req, gz::msgs::Boolean &_res)
 {
+  // The request is only copied once, into an arena
+  auto batch = ArenaMessage::Copy(_req);
+
   std::lock_guard<std::mutex> lock(this->mutex);
-  std::copy(_req.marker().begin(), _req.marker().end(),
-            std::back_inserter(this->markerMsgs));
+  this->markerBatches.push_back(std::move(batch));
   _res.set_data(true);
   return true;
 }
 
+/////////////////////////////////////////////////
+void MarkerManagerPrivate::OnPointsRaw(const char *_data,
+    const std::size_t _size, const transport::MessageInfo &/*_info*/)
+{
+  auto msg = ArenaMessage::Parse<gz::msgs::PointCloudPacked>(_data, _size);
+  if (nullptr == msg)
+  {
+    ignerr << "Dropping malformed point cloud of [" << _size
+           << "] bytes on [" << this->topicName << "/points]" << std::endl;
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->pointClouds.push_back(std::move(msg));
+}
+
+/////////////////////////////////////////////////
+void MarkerManagerPrivate::ProcessPointsMsg(
+    const gz::msgs::PointCloudPacked &_msg)
+{
+  gz::msgs::Marker markerMsg;
+  if (!MarkerPoints::Describe(_msg, markerMsg))
+  {
+    ignerr << "Point cloud on [" << this->topicName << "/points] doesn't "
+           << "describe a marker, its header needs a valid [id]" << std::endl;
+    return;
+  }
+
+  if (!this->points.Decode(_msg))
+  {
+    ignerr << "Unable to decode the points of marker with id["
+           << markerMsg.id() << "] in namespace[" << markerMsg.ns() << "]"
+           << std::endl;
+    return;
+  }
+
+  // Add or modify the marker without points
+  if (!this->ProcessMarkerMsg(markerMsg))
+    return;
+
+  auto nsIter = this->visuals.find(markerMsg.ns());
+  if (nsIter == this->visuals.end())
+    return;
+  auto visualIter = nsIter->second.find(markerMsg.id());
+  if (visualIter == nsIter->second.end() ||
+      visualIter->second->GeometryCount() == 0u)
+  {
+    return;
+  }
+
+  rendering::MarkerPtr markerPtr =
+      std::dynamic_pointer_cast<rendering::Marker>(
+      visualIter->second->GeometryByIndex(0u));
+  if (nullptr == markerPtr)
+    return;
+
+  // Too many points are drawn with levels of detail
+  if (this->pointLodBuilder && markerMsg.type() == gz::msgs::Marker::POINTS &&
+      this->points.positions.size() > this->pointBudget)
+  {
+    this->DrawPointLod(markerMsg.ns(), markerMsg.id(), visualIter->second,
+        markerPtr, this->points.positions, this->points.colors,
+        math::Color::White);
+    return;
+  }
+  this->RemovePointLod(markerMsg.ns(), markerMsg.id());
+
+  // Then set all points at once, from the decoded buffers
+  markerPtr->ClearPoints();
+  const auto &positions = this->points.positions;
+  const auto &colors = this->points.colors;
+  if (colors.empty())
+  {
+    for (const auto &position : positions)
+      markerPtr->AddPoint(position, math::Color::White);
+  }
+  else
+  {
+    for (std::size_t i = 0; i < positions.size(); ++i)
+      markerPtr->AddPoint(positions[i], colors[i]);
+  }
+}
+
 //////////////////////////////////////////////////
 bool MarkerManagerPrivate::ProcessMarkerMsg(const gz::msgs::Marker &_msg)
 {
@@ -327,6 +688,24 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const gz::msgs::Marker &_msg)
   // Add/modify a marker
   if (_msg.action() == gz::msgs::Marker::ADD_MODIFY)
   {
+    // Markers of batched namespaces are drawn by shared triangle lists.
+    // Updates without type keep the type of batched markers.
+    if (this->batcher && this->batchNamespaces.count(ns) > 0u &&
+        MarkerBatcher::Supports(_msg, this->batcher->Type(ns, id)))
+    {
+      this->SetBatchedMarker(ns, id, _msg);
+      return true;
+    }
+
+    // A batched marker which can't be batched anymore is created again
+    if (this->batcher && this->batcher->Remove(ns, id) &&
+        nsIter != this->visuals.end() && visualIter != nsIter->second.end())
+    {
+      this->DestroyMarkerVisual(visualIter->second);
+      nsIter->second.erase(visualIter);
+      visualIter = nsIter->second.end();
+    }
+
     // Modify an existing marker, identified by namespace and id
     if (nsIter != this->visuals.end() &&
         visualIter != nsIter->second.end())
@@ -346,6 +725,8 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const gz::msgs::Marker &_msg)
 
         // Set the marker values from the Marker Message
         this->SetMarker(_msg, markerPtr);
+        this->SetPointLod(ns, id, _msg, visualIter->second, markerPtr);
+        this->SetLifetime(ns, id, _msg);
 
         visualIter->second->AddGeometry(markerPtr);
       }
@@ -368,6 +749,7 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const gz::msgs::Marker &_msg)
 
       // Set the marker values from the Marker Message
       this->SetMarker(_msg, markerPtr);
+      this->SetPointLod(ns, id, _msg, visualPtr, markerPtr);
 
       // Add populated marker to the visual
       visualPtr->AddGeometry(markerPtr);
@@ -380,6 +762,7 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const gz::msgs::Marker &_msg)
 
       // Store the visual
       this->visuals[ns][id] = visualPtr;
+      this->SetLifetime(ns, id, _msg);
     }
   }
   // Remove a single marker
@@ -389,8 +772,11 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const gz::msgs::Marker &_msg)
     if (nsIter != this->visuals.end() &&
         visualIter != nsIter->second.end())
     {
-      this->scene->DestroyVisual(visualIter->second);
+      this->DestroyMarkerVisual(visualIter->second);
       this->visuals[ns].erase(visualIter);
+      this->lifetimes.Remove(ns, id);
+      if (this->batcher)
+        this->batcher->Remove(ns, id);
 
       // Remove namespace if empty
       if (this->visuals[ns].empty())
@@ -424,10 +810,13 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const gz::msgs::Marker &_msg)
     {
       for (auto it : nsIter->second)
       {
-        this->scene->DestroyVisual(it.second);
+        this->DestroyMarkerVisual(it.second);
       }
       nsIter->second.clear();
       this->visuals.erase(nsIter);
+      this->lifetimes.RemoveNamespace(ns);
+      if (this->batcher)
+        this->batcher->RemoveNamespace(ns);
     }
     // Remove all markers in all namespaces.
     else
@@ -437,10 +826,13 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const gz::msgs::Marker &_msg)
       {
         for (auto it : nsIter->second)
         {
-          this->scene->DestroyVisual(it.second);
+          this->DestroyMarkerVisual(it.second);
         }
       }
       this->visuals.clear();
+      this->lifetimes.Clear();
+      if (this->batcher)
+        this->batcher->Clear();
     }
   }
   else
@@ -452,6 +844,280 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const gz::msgs::Marker &_msg)
   return true;
 }
 
+/////////////////////////////////////////////////
+void MarkerManagerPrivate::SetBatchedMarker(const std::string &_ns,
+    const uint64_t _id, const gz::msgs::Marker &_msg)
+{
+  rendering::VisualPtr visualPtr;
+  auto nsIter = this->visuals.find(_ns);
+  if (nsIter != this->visuals.end())
+  {
+    auto visualIter = nsIter->second.find(_id);
+    if (visualIter != nsIter->second.end())
+      visualPtr = visualIter->second;
+  }
+
+  // A marker which was drawn on its own is created again without geometry
+  if (visualPtr && visualPtr->GeometryCount() > 0u)
+  {
+    this->DestroyMarkerVisual(visualPtr);
+    visualPtr.reset();
+  }
+
+  if (!visualPtr)
+  {
+    visualPtr = this->scene->CreateVisual("__IGN_MARKER_VISUAL_" + _ns +
+        "_" + std::to_string(_id));
+    this->scene->RootVisual()->AddChild(visualPtr);
+    this->visuals[_ns][_id] = visualPtr;
+  }
+
+  // The visual holds the pose and scale of the marker
+  this->SetVisual(_msg, visualPtr);
+
+  // Keep the current material if the message doesn't set one
+  rendering::MaterialPtr material;
+  if (!_msg.has_material())
+    material = this->batcher->Material(_ns, _id);
+  if (!material)
+    material = this->MsgToMaterial(_msg);
+
+  this->batcher->Set(_ns, _id, _msg.type(), visualPtr, material);
+  if (this->batchMaterials.insert(material->Name()).second)
+    this->materialCache.Acquire(material);
+  this->SetLifetime(_ns, _id, _msg);
+}
+
+/////////////////////////////////////////////////
+void MarkerManagerPrivate::SetLifetime(const std::string &_ns,
+    const uint64_t _id, const gz::msgs::Marker &_msg)
+{
+  std::chrono::steady_clock::duration lifetime =
+    std::chrono::seconds(_msg.lifetime().sec()) +
+    std::chrono::nanoseconds(_msg.lifetime().nsec());
+
+  if (lifetime.count() != 0)
+    this->lifetimes.Set(_ns, _id, lifetime + this->simTime);
+  else
+    this->lifetimes.Remove(_ns, _id);
+}
+
+/////////////////////////////////////////////////
+bool MarkerManagerPrivate::UsesPointLod(const gz::msgs::Marker &_msg) const
+{
+  return this->pointLodBuilder &&
+      _msg.type() == gz::msgs::Marker::POINTS &&
+      static_cast<std::size_t>(_msg.point_size()) > this->pointBudget;
+}
+
+/////////////////////////////////////////////////
+void MarkerManagerPrivate::SetPointLod(const std::string &_ns,
+    const uint64_t _id, const gz::msgs::Marker &_msg,
+    const rendering::VisualPtr &_visualPtr,
+    const rendering::MarkerPtr &_markerPtr)
+{
+  if (!this->pointLodBuilder)
+    return;
+
+  if (!this->UsesPointLod(_msg))
+  {
+    // Messages without points keep the current ones
+    if (_msg.point_size() > 0 || (_msg.type() != gz::msgs::Marker::NONE &&
+        _msg.type() != gz::msgs::Marker::POINTS))
+    {
+      this->RemovePointLod(_ns, _id);
+    }
+    return;
+  }
+
+  std::vector<math::Vector3d> positions;
+  positions.reserve(_msg.point_size());
+  for (const auto &point : _msg.point())
+    positions.emplace_back(point.x(), point.y(), point.z());
+
+  math::Color color(
+      _msg.material().diffuse().r(),
+      _msg.material().diffuse().g(),
+      _msg.material().diffuse().b(),
+      _msg.material().diffuse().a());
+
+  this->DrawPointLod(_ns, _id, _visualPtr, _markerPtr, std::move(positions),
+      {}, color);
+}
+
+/////////////////////////////////////////////////
+void MarkerManagerPrivate::DrawPointLod(const std::string &_ns,
+    const uint64_t _id, const rendering::VisualPtr &_visualPtr,
+    const rendering::MarkerPtr &_markerPtr,
+    std::vector<math::Vector3d> _positions, std::vector<math::Color> _colors,
+    const math::Color &_color)
+{
+  // Until the levels are built, draw every n-th point
+  const std::size_t stride =
+      (_positions.size() + this->pointBudget - 1u) / this->pointBudget;
+  const bool hasColors = _colors.size() == _positions.size();
+  _markerPtr->ClearPoints();
+  for (std::size_t i = 0; i < _positions.size(); i += stride)
+    _markerPtr->AddPoint(_positions[i], hasColors ? _colors[i] : _color);
+
+  auto &state = this->pointLods[_ns][_id];
+  state = PointLodState();
+  state.visual = _visualPtr;
+  state.marker = _markerPtr;
+  state.color = _color;
+
+  state.generation = this->pointLodBuilder->Build(_ns, _id,
+      std::move(_positions), std::move(_colors));
+}
+
+/////////////////////////////////////////////////
+void MarkerManagerPrivate::RemovePointLod(const std::string &_ns,
+    const uint64_t _id)
+{
+  auto nsIter = this->pointLods.find(_ns);
+  if (nsIter == this->pointLods.end())
+    return;
+
+  nsIter->second.erase(_id);
+  if (nsIter->second.empty())
+    this->pointLods.erase(nsIter);
+}
+
+/////////////////////////////////////////////////
+void MarkerManagerPrivate::UpdatePointLods()
+{
+  if (!this->pointLodBuilder)
+    return;
+
+  // Levels of markers which aren't drawn with levels of detail anymore, or
+  // whose points were replaced since, are dropped
+  for (auto &result : this->pointLodBuilder->TakeFinished())
+  {
+    auto nsIter = this->pointLods.find(result.ns);
+    if (nsIter == this->pointLods.end())
+      continue;
+    auto stateIter = nsIter->second.find(result.id);
+    if (stateIter == nsIter->second.end() || result.levels.empty() ||
+        stateIter->second.generation != result.generation)
+    {
+      continue;
+    }
+
+    auto &state = stateIter->second;
+    state.levels = std::move(result.levels);
+    state.level = state.levels.size();
+
+    // Bounds of the finest level, which are within a voxel of the points'
+    math::Vector3d min = state.levels[0].positions.front();
+    math::Vector3d max = min;
+    for (const auto &position : state.levels[0].positions)
+    {
+      min.X() = std::min(min.X(), position.X());
+      min.Y() = std::min(min.Y(), position.Y());
+      min.Z() = std::min(min.Z(), position.Z());
+      max.X() = std::max(max.X(), position.X());
+      max.Y() = std::max(max.Y(), position.Y());
+      max.Z() = std::max(max.Z(), position.Z());
+    }
+    state.center = (min + max) * 0.5;
+    state.radius = (max - min).Length() * 0.5 + state.levels[0].voxel;
+  }
+
+  if (this->pointLods.empty())
+    return;
+
+  // Angle of a pixel, or the finest levels without camera
+  auto cam = this->UserCamera();
+  math::Vector3d eye;
+  double maxAngle{0.0};
+  if (cam && cam->ImageWidth() > 0u)
+  {
+    eye = cam->WorldPosition();
+    maxAngle = kPointLodPixels * 2.0 * std::tan(cam->HFOV().Radian() * 0.5) /
+        cam->ImageWidth();
+  }
+
+  auto nsIter = this->pointLods.begin();
+  while (nsIter != this->pointLods.end())
+  {
+    auto visualsIter = this->visuals.find(nsIter->first);
+    auto stateIter = nsIter->second.begin();
+    while (stateIter != nsIter->second.end())
+    {
+      auto &state = stateIter->second;
+
+      // Markers which were deleted or created again are dropped
+      auto visual = state.visual.lock();
+      auto marker = state.marker.lock();
+      bool valid = visual && marker && visualsIter != this->visuals.end();
+      if (valid)
+      {
+        auto visualIter = visualsIter->second.find(stateIter->first);
+        valid = visualIter != visualsIter->second.end() &&
+            visualIter->second == visual && visual->GeometryCount() > 0u &&
+            visual->GeometryByIndex(0u) == marker;
+      }
+      if (!valid)
+      {
+        stateIter = nsIter->second.erase(stateIter);
+        continue;
+      }
+      ++stateIter;
+
+      if (state.levels.empty())
+        continue;
+
+      std::size_t level{0u};
+      if (maxAngle > 0.0)
+      {
+        const math::Pose3d pose = visual->WorldPose();
+        const math::Vector3d center = pose.Pos() + pose.Rot() * state.center;
+        const double distance =
+            std::max((center - eye).Length() - state.radius, 1e-6);
+        level = PointLod::Select(state.levels, distance, maxAngle,
+            state.level);
+      }
+      if (level == state.level)
+        continue;
+
+      const auto &lod = state.levels[level];
+      const bool hasColors = lod.colors.size() == lod.positions.size();
+      marker->ClearPoints();
+      for (std::size_t i = 0; i < lod.positions.size(); ++i)
+      {
+        marker->AddPoint(lod.positions[i],
+            hasColors ? lod.colors[i] : state.color);
+      }
+      state.level = level;
+    }
+
+    if (nsIter->second.empty())
+      nsIter = this->pointLods.erase(nsIter);
+    else
+      ++nsIter;
+  }
+}
+
+/////////////////////////////////////////////////
+rendering::CameraPtr MarkerManagerPrivate::UserCamera()
+{
+  auto cam = this->camera.lock();
+  if (cam)
+    return cam;
+
+  for (unsigned int i = 0; i < this->scene->NodeCount(); ++i)
+  {
+    cam = std::dynamic_pointer_cast<rendering::Camera>(
+        this->scene->NodeByIndex(i));
+    if (cam)
+    {
+      this->camera = cam;
+      break;
+    }
+  }
+  return cam;
+}
+
 /////////////////////////////////////////////////
 void MarkerManagerPrivate::SetVisual(const gz::msgs::Marker &_msg,
                            const rendering::VisualPtr &_visualPtr)
@@ -529,10 +1195,15 @@ void MarkerManagerPrivate::SetMarker(const gz::msgs::Marker &_msg,
   if (_msg.has_material())
   {
     rendering::MaterialPtr materialPtr = MsgToMaterial(_msg);
-    _markerPtr->SetMaterial(materialPtr, true /* clone */);
-
-    // clean up material after clone
-    this->scene->DestroyMaterial(materialPtr);
+    _markerPtr->SetMaterial(materialPtr, false /* shared */);
+
+    // Acquire before releasing the previous material, which may be the
+    // same one
+    this->materialCache.Acquire(materialPtr);
+    auto &held = this->markerMaterials[_markerPtr->Name()];
+    if (held)
+      this->materialCache.Release(this->scene, held);
+    held = materialPtr;
   }
 
   // Assume the presence of points means we clear old ones
@@ -541,6 +1212,14 @@ void MarkerManagerPrivate::SetMarker(const gz::msgs::Marker &_msg,
     _markerPtr->ClearPoints();
   }
 
+  // Too many points are set by SetPointLod
+  if (this->UsesPointLod(_msg))
+  {
+    if (_msg.has_scale())
+      _markerPtr->SetSize(_msg.scale().x());
+    return;
+  }
+
   math::Color color(
       _msg.material().diffuse().r(),
       _msg.material().diffuse().g(),
@@ -563,11 +1242,45 @@ void MarkerManagerPrivate::SetMarker(const gz::msgs::Marker &_msg,
   }
 }
 
+/////////////////////////////////////////////////
+void MarkerManagerPrivate::DestroyMarkerVisual(
+    const rendering::VisualPtr &_visualPtr)
+{
+  rendering::MaterialPtr material;
+  if (_visualPtr->GeometryCount() > 0u)
+  {
+    auto it = this->markerMaterials.find(
+        _visualPtr->GeometryByIndex(0)->Name());
+    if (it != this->markerMaterials.end())
+    {
+      material = it->second;
+      this->markerMaterials.erase(it);
+    }
+  }
+
+  // The marker is destroyed with its visual, before its material
+  this->scene->DestroyVisual(_visualPtr);
+  if (material)
+    this->materialCache.Release(this->scene, material);
+}
+
 /////////////////////////////////////////////////
 rendering::MaterialPtr MarkerManagerPrivate::MsgToMaterial(
                               const gz::msgs::Marker &_msg)
 {
-  rendering::MaterialPtr material = this->scene->CreateMaterial();
+  MaterialKey key;
+  key.Add(_msg.material().ambient())
+     .Add(_msg.material().diffuse())
+     .Add(_msg.material().specular())
+     .Add(_msg.material().emissive())
+     .Add(_msg.material().lighting());
+
+  rendering::MaterialPtr material = this->materialCache.Find(this->scene,
+      key);
+  if (material)
+    return material;
+
+  material = this->scene->CreateMaterial();
 
   material->SetAmbient(
       _msg.material().ambient().r(),
@@ -595,6 +1308,7 @@ rendering::MaterialPtr MarkerManagerPrivate::MsgToMaterial(
 
   material->SetLightingEnabled(_msg.material().lighting());
 
+  this->materialCache.Insert(key, material);
   return material;
 }
 
@@ -707,6 +1421,45 @@ void MarkerManager::LoadConfig(const tinyxml2::XMLElement * _pluginElem)
       }
     }
 
+    for (elem = _pluginElem->FirstChildElement("batch_namespace");
+         elem != nullptr;
+         elem = elem->NextSiblingElement("batch_namespace"))
+    {
+      this->dataPtr->batchNamespaces.insert(
+          nullptr == elem->GetText() ? "" : elem->GetText());
+    }
+
+    elem = _pluginElem->FirstChildElement("budget_ms");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      double budget;
+      if (elem->QueryDoubleText(&budget) == tinyxml2::XML_SUCCESS)
+      {
+        this->dataPtr->budget =
+            std::chrono::duration<double, std::milli>(budget);
+      }
+      else
+      {
+        ignerr << "Failed to parse <budget_ms> value: "
+               << elem->GetText() << std::endl;
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("point_budget");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      unsigned int budget;
+      if (elem->QueryUnsignedText(&budget) == tinyxml2::XML_SUCCESS)
+      {
+        this->dataPtr->pointBudget = budget;
+      }
+      else
+      {
+        ignerr << "Failed to parse <point_budget> value: "
+               << elem->GetText() << std::endl;
+      }
+    }
+
     // Stats topic
     auto statsTopicElem = _pluginElem->FirstChildElement("stats_topic");
     if (nullptr != statsTopicElem && nullptr != statsTopicElem->GetText())
@@ -769,12 +1522,39 @@ void MarkerManager::LoadConfig(const tinyxml2::XMLElement * _pluginElem)
   App()->findChild<MainWindow *>()->installEventFilter(this);
 }
 
+/////////////////////////////////////////////////
+int MarkerManager::Backlog() const
+{
+  return this->dataPtr->backlog;
+}
+
 /////////////////////////////////////////////////
 bool MarkerManager::eventFilter(QObject *_obj, QEvent *_event)
 {
   if (_event->type() == events::Render::kType)
   {
     this->dataPtr->OnRender();
+
+    if (this->dataPtr->backlog != this->dataPtr->notifiedBacklog)
+    {
+      this->dataPtr->notifiedBacklog = this->dataPtr->backlog;
+      QMetaObject::invokeMethod(this, "BacklogChanged");
+    }
+  }
+  else if (_event->type() == events::MarkerRequest::kType)
+  {
+    // Markers for other marker services are left to their managers, or to
+    // the sender's fallback
+    auto markerEvent = static_cast<events::MarkerRequest *>(_event);
+    if (markerEvent->Topic() != this->dataPtr->topicName)
+      return QObject::eventFilter(_obj, _event);
+
+    this->dataPtr->submitted.Push(
+        std::make_unique<gz::msgs::Marker>(markerEvent->Marker()));
+
+    // Let the sender know that the marker was queued
+    markerEvent->accept();
+    return true;
   }
   // Standard event processing
   return QObject::eventFilter(_obj, _event);
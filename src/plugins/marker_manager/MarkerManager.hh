@@ -33,6 +33,20 @@ namespace plugins
   /// \brief This plugin will be in charge of handling the markers in the
   /// scene. It will allow to add, modify or remove markers.
   ///
+  /// Plugins in the same process can send an events::MarkerRequest for this
+  /// plugin's `<topic_name>` to the main window instead of calling the
+  /// marker service. The marker is then queued without being serialized or
+  /// going through transport.
+  ///
+  /// Markers with many points, such as point clouds and costmaps, can also
+  /// be published as a msgs::PointCloudPacked on the `<topic_name>/points`
+  /// topic, which sets all points of a marker at once. The cloud needs
+  /// float32 `x`, `y` and `z` fields, and optionally an `rgb` or `rgba`
+  /// field. Its header data holds the marker's `id` and optionally its
+  /// `ns`, `type` (`points`, `line_list`, `line_strip`, `triangle_list`,
+  /// `triangle_strip` or `triangle_fan`), point `size`, `layer` and
+  /// `parent`.
+  ///
   /// ## Parameters
   ///
   /// * `<topic_name>`: Optional. Name of topic for marker service. Defaults
@@ -41,10 +55,35 @@ namespace plugins
   /// Defaults to `/world/[world name]/stats`.
   /// * `<warn_on_action_failure>`: True to display warnings if the user
   /// attempts to perform an invalid action. Defaults to true.
+  /// * `<batch_namespace>`: Optional, repeatable. Namespace whose box,
+  /// cylinder and sphere markers without parent are merged into one
+  /// triangle list per material, to draw many small markers with few draw
+  /// calls. Other markers of the namespace are drawn on their own. Batched
+  /// markers can still be modified and deleted individually, but are
+  /// assumed to be static. Empty for the global namespace.
+  /// * `<budget_ms>`: Time in milliseconds spent processing marker messages
+  /// on each frame. Messages left over are processed on the following
+  /// frames, so large bursts of markers appear gradually instead of
+  /// stalling the GUI. Zero or negative processes everything at once.
+  /// Defaults to 10.
+  /// * `<point_budget>`: Most points drawn for each points marker. Markers
+  /// with more points, such as large point clouds, are decimated on a voxel
+  /// grid on a worker thread into levels of detail, and drawn with the
+  /// level whose voxels cover about two pixels at their distance from the
+  /// camera. An even subset of the points is drawn until the levels are
+  /// built. Zero draws all points. Defaults to 0.
   class MarkerManager : public Plugin
   {
     Q_OBJECT
 
+    /// \brief Number of marker messages and point clouds waiting to be
+    /// processed
+    Q_PROPERTY(
+      int backlog
+      READ Backlog
+      NOTIFY BacklogChanged
+    )
+
     /// \brief Constructor
     public: MarkerManager();
 
@@ -55,6 +94,14 @@ namespace plugins
     public: virtual void LoadConfig(const tinyxml2::XMLElement *_pluginElem)
         override;
 
+    /// \brief Get the number of marker messages and point clouds waiting to
+    /// be processed
+    /// \return Number of queued messages
+    public: Q_INVOKABLE int Backlog() const;
+
+    /// \brief Notify that the backlog has changed
+    signals: void BacklogChanged();
+
     // Documentation inherited
     private: bool eventFilter(QObject *_obj, QEvent *_event) override;
 
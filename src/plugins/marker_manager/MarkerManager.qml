@@ -32,6 +32,7 @@ ColumnLayout {
       '<li>' + topicName + '</li>' +
       '<li>' + topicName + '_array</li>' +
       '<li>' + topicName + '/list</li></ul><br>Topics subscribed:<br><ul>' +
+      '<li>' + topicName + '/points</li>' +
       '<li>' + statsTopic + '</li></ul>'
 
   Label {
@@ -40,6 +41,11 @@ ColumnLayout {
     text: message
   }
 
+  Label {
+    Layout.fillWidth: true
+    text: 'Backlog: ' + MarkerManager.backlog + ' messages'
+  }
+
   Item {
     width: 10
     Layout.fillHeight: true
@@ -0,0 +1,241 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_MARKERMANAGER_MARKERPOINTS_HH_
+#define GZ_GUI_PLUGINS_MARKERMANAGER_MARKERPOINTS_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <gz/math/Color.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/msgs/marker.pb.h>
+#include <gz/msgs/pointcloud_packed.pb.h>
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  /// \brief Points of a marker sent as a msgs::PointCloudPacked, which is
+  /// much cheaper to send and decode than a msgs::Marker with one
+  /// submessage per point.
+  ///
+  /// The cloud must have FLOAT32 `x`, `y` and `z` fields and be little
+  /// endian. Points are coloured by an optional `rgb` or `rgba` field,
+  /// FLOAT32 or UINT32, packed as 0xAARRGGBB; the alpha byte is only used
+  /// for `rgba`. Points are white otherwise.
+  ///
+  /// The marker is described by the key / value pairs of the header data:
+  ///
+  /// * `id`: Required, non zero marker id.
+  /// * `ns`: Marker namespace. Defaults to the global namespace.
+  /// * `type`: One of `points`, `line_list`, `line_strip`, `triangle_list`,
+  ///   `triangle_strip` or `triangle_fan`. Defaults to `points`.
+  /// * `size`: Size of the points.
+  /// * `layer`: Marker layer.
+  /// * `parent`: Name of the parent visual.
+  class MarkerPoints
+  {
+    /// \brief Fill a marker message from the header of a cloud. The marker
+    /// has an unlit white material and no points.
+    /// \param[in] _msg Cloud.
+    /// \param[out] _marker Marker message to add or modify the marker.
+    /// \return False if the header doesn't describe a valid marker.
+    public: static bool Describe(const msgs::PointCloudPacked &_msg,
+        msgs::Marker &_marker)
+    {
+      _marker.Clear();
+      _marker.set_action(msgs::Marker::ADD_MODIFY);
+      _marker.set_type(msgs::Marker::POINTS);
+
+      for (const auto &data : _msg.header().data())
+      {
+        if (data.value_size() == 0)
+          continue;
+
+        const std::string &value = data.value(0);
+        char *end = nullptr;
+        if (data.key() == "id")
+        {
+          _marker.set_id(std::strtoull(value.c_str(), &end, 10));
+          if (value.empty() || *end != '\0')
+            return false;
+        }
+        else if (data.key() == "ns")
+        {
+          _marker.set_ns(value);
+        }
+        else if (data.key() == "type")
+        {
+          if (value == "points")
+            _marker.set_type(msgs::Marker::POINTS);
+          else if (value == "line_list")
+            _marker.set_type(msgs::Marker::LINE_LIST);
+          else if (value == "line_strip")
+            _marker.set_type(msgs::Marker::LINE_STRIP);
+          else if (value == "triangle_list")
+            _marker.set_type(msgs::Marker::TRIANGLE_LIST);
+          else if (value == "triangle_strip")
+            _marker.set_type(msgs::Marker::TRIANGLE_STRIP);
+          else if (value == "triangle_fan")
+            _marker.set_type(msgs::Marker::TRIANGLE_FAN);
+          else
+            return false;
+        }
+        else if (data.key() == "size")
+        {
+          const double size = std::strtod(value.c_str(), &end);
+          if (value.empty() || *end != '\0')
+            return false;
+          _marker.mutable_scale()->set_x(size);
+          _marker.mutable_scale()->set_y(size);
+          _marker.mutable_scale()->set_z(size);
+        }
+        else if (data.key() == "layer")
+        {
+          _marker.set_layer(
+              static_cast<int32_t>(std::strtol(value.c_str(), &end, 10)));
+          if (value.empty() || *end != '\0')
+            return false;
+        }
+        else if (data.key() == "parent")
+        {
+          _marker.set_parent(value);
+        }
+      }
+
+      auto material = _marker.mutable_material();
+      for (auto color : {material->mutable_ambient(),
+          material->mutable_diffuse()})
+      {
+        color->set_r(1.0f);
+        color->set_g(1.0f);
+        color->set_b(1.0f);
+        color->set_a(1.0f);
+      }
+      material->set_lighting(false);
+
+      return _marker.id() != 0u;
+    }
+
+    /// \brief Decode the points of a cloud in a single pass, replacing the
+    /// current points.
+    /// \param[in] _msg Cloud.
+    /// \return False if the cloud is malformed, in which case the points
+    /// are left unchanged.
+    public: bool Decode(const msgs::PointCloudPacked &_msg)
+    {
+      if (_msg.is_bigendian())
+        return false;
+
+      uint32_t offsets[3];
+      bool found[3] = {false, false, false};
+      uint32_t colorOffset = 0u;
+      bool hasColor = false;
+      bool hasAlpha = false;
+      for (const auto &field : _msg.field())
+      {
+        const auto type = field.datatype();
+        const int axis = field.name() == "x" ? 0 :
+            field.name() == "y" ? 1 : field.name() == "z" ? 2 : -1;
+        if (axis >= 0 && type == msgs::PointCloudPacked::Field::FLOAT32)
+        {
+          offsets[axis] = field.offset();
+          found[axis] = true;
+        }
+        else if ((field.name() == "rgb" || field.name() == "rgba") &&
+            (type == msgs::PointCloudPacked::Field::FLOAT32 ||
+             type == msgs::PointCloudPacked::Field::UINT32))
+        {
+          colorOffset = field.offset();
+          hasColor = true;
+          hasAlpha = field.name() == "rgba";
+        }
+      }
+      if (!found[0] || !found[1] || !found[2])
+        return false;
+
+      // All fields must be within a point, and all points within the data
+      const std::size_t step = _msg.point_step();
+      for (const uint32_t offset : offsets)
+      {
+        if (std::size_t(offset) + 4u > step)
+          return false;
+      }
+      if (hasColor && std::size_t(colorOffset) + 4u > step)
+        return false;
+
+      const std::size_t width = _msg.width();
+      const std::size_t height = _msg.height();
+      const std::size_t rowStep = height > 1u ? _msg.row_step() : 0u;
+      if (width > 0u && height > 0u)
+      {
+        if (height > 1u && rowStep < width * step)
+          return false;
+        if (_msg.data().size() < (height - 1u) * rowStep + width * step)
+          return false;
+      }
+
+      const std::size_t count = width * height;
+      this->positions.resize(count);
+      this->colors.resize(hasColor ? count : 0u);
+
+      const char *data = _msg.data().data();
+      std::size_t i = 0u;
+      for (std::size_t row = 0u; row < height; ++row)
+      {
+        const char *point = data + row * rowStep;
+        for (std::size_t col = 0u; col < width; ++col, ++i, point += step)
+        {
+          float x, y, z;
+          std::memcpy(&x, point + offsets[0], 4u);
+          std::memcpy(&y, point + offsets[1], 4u);
+          std::memcpy(&z, point + offsets[2], 4u);
+          this->positions[i] = math::Vector3d(x, y, z);
+
+          if (hasColor)
+          {
+            uint32_t rgba;
+            std::memcpy(&rgba, point + colorOffset, 4u);
+            this->colors[i] = math::Color(
+                ((rgba >> 16u) & 0xffu) / 255.0f,
+                ((rgba >> 8u) & 0xffu) / 255.0f,
+                (rgba & 0xffu) / 255.0f,
+                hasAlpha ? ((rgba >> 24u) & 0xffu) / 255.0f : 1.0f);
+          }
+        }
+      }
+      return true;
+    }
+
+    /// \brief Point positions.
+    public: std::vector<math::Vector3d> positions;
+
+    /// \brief Point colors, empty if the cloud has no colors.
+    public: std::vector<math::Color> colors;
+  };
+}
+}
+}
+
+#endif
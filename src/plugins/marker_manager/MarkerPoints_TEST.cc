@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include <gz/msgs/marker.pb.h>
+#include <gz/msgs/pointcloud_packed.pb.h>
+
+#include "gz/gui/config.hh"
+
+#include "MarkerPoints.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+/// \brief Add a field to a cloud.
+void AddField(msgs::PointCloudPacked &_msg, const std::string &_name,
+    uint32_t _offset, msgs::PointCloudPacked::Field::DataType _type =
+    msgs::PointCloudPacked::Field::FLOAT32)
+{
+  auto field = _msg.add_field();
+  field->set_name(_name);
+  field->set_offset(_offset);
+  field->set_datatype(_type);
+  field->set_count(1u);
+}
+
+/////////////////////////////////////////////////
+/// \brief Add a header value to a cloud.
+void AddData(msgs::PointCloudPacked &_msg, const std::string &_key,
+    const std::string &_value)
+{
+  auto data = _msg.mutable_header()->add_data();
+  data->set_key(_key);
+  data->add_value(_value);
+}
+
+/////////////////////////////////////////////////
+/// \brief Create a cloud of points with x, y, z and rgba fields. Rows are
+/// padded with 4 bytes.
+msgs::PointCloudPacked Cloud(uint32_t _width, uint32_t _height)
+{
+  msgs::PointCloudPacked msg;
+  AddField(msg, "x", 0u);
+  AddField(msg, "y", 4u);
+  AddField(msg, "z", 8u);
+  AddField(msg, "rgba", 12u, msgs::PointCloudPacked::Field::UINT32);
+  msg.set_width(_width);
+  msg.set_height(_height);
+  msg.set_point_step(16u);
+  msg.set_row_step(_width * 16u + 4u);
+
+  std::string data(_height * msg.row_step(), '\0');
+  for (uint32_t row = 0u; row < _height; ++row)
+  {
+    for (uint32_t col = 0u; col < _width; ++col)
+    {
+      char *point = &data[row * msg.row_step() + col * 16u];
+      const float xyz[3] = {static_cast<float>(col),
+          static_cast<float>(row), 0.5f};
+      const uint32_t rgba = 0x80ff0000u;
+      std::memcpy(point, xyz, sizeof(xyz));
+      std::memcpy(point + 12, &rgba, 4u);
+    }
+  }
+  msg.set_data(data);
+  return msg;
+}
+
+/////////////////////////////////////////////////
+TEST(MarkerPointsTest, Describe)
+{
+  msgs::PointCloudPacked msg;
+  msgs::Marker marker;
+
+  // An id is required
+  AddData(msg, "ns", "costmap");
+  EXPECT_FALSE(MarkerPoints::Describe(msg, marker));
+
+  AddData(msg, "id", "12");
+  AddData(msg, "type", "triangle_list");
+  AddData(msg, "size", "0.25");
+  AddData(msg, "layer", "2");
+  AddData(msg, "parent", "base_link");
+  ASSERT_TRUE(MarkerPoints::Describe(msg, marker));
+  EXPECT_EQ("costmap", marker.ns());
+  EXPECT_EQ(12u, marker.id());
+  EXPECT_EQ(msgs::Marker::ADD_MODIFY, marker.action());
+  EXPECT_EQ(msgs::Marker::TRIANGLE_LIST, marker.type());
+  EXPECT_DOUBLE_EQ(0.25, marker.scale().x());
+  EXPECT_EQ(2, marker.layer());
+  EXPECT_EQ("base_link", marker.parent());
+  EXPECT_FLOAT_EQ(1.0f, marker.material().diffuse().r());
+  EXPECT_FALSE(marker.material().lighting());
+  EXPECT_EQ(0, marker.point_size());
+
+  // Defaults to points
+  msgs::PointCloudPacked minimal;
+  AddData(minimal, "id", "1");
+  ASSERT_TRUE(MarkerPoints::Describe(minimal, marker));
+  EXPECT_EQ(msgs::Marker::POINTS, marker.type());
+  EXPECT_TRUE(marker.ns().empty());
+
+  // Malformed values
+  for (const auto &[key, value] : {std::make_pair("id", "1x"),
+      std::make_pair("type", "sphere"), std::make_pair("size", "")})
+  {
+    msgs::PointCloudPacked bad = minimal;
+    AddData(bad, key, value);
+    EXPECT_FALSE(MarkerPoints::Describe(bad, marker)) << key;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(MarkerPointsTest, Decode)
+{
+  MarkerPoints points;
+  ASSERT_TRUE(points.Decode(Cloud(3u, 2u)));
+  ASSERT_EQ(6u, points.positions.size());
+  ASSERT_EQ(6u, points.colors.size());
+  EXPECT_DOUBLE_EQ(2.0, points.positions[5].X());
+  EXPECT_DOUBLE_EQ(1.0, points.positions[5].Y());
+  EXPECT_DOUBLE_EQ(0.5, points.positions[5].Z());
+  EXPECT_FLOAT_EQ(1.0f, points.colors[5].R());
+  EXPECT_FLOAT_EQ(0.0f, points.colors[5].G());
+  EXPECT_NEAR(0.5f, points.colors[5].A(), 0.01f);
+
+  // Without colors
+  auto msg = Cloud(4u, 1u);
+  msg.mutable_field()->RemoveLast();
+  ASSERT_TRUE(points.Decode(msg));
+  EXPECT_EQ(4u, points.positions.size());
+  EXPECT_TRUE(points.colors.empty());
+  EXPECT_DOUBLE_EQ(3.0, points.positions[3].X());
+
+  // Empty clouds clear the points
+  ASSERT_TRUE(points.Decode(Cloud(0u, 0u)));
+  EXPECT_TRUE(points.positions.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(MarkerPointsTest, Malformed)
+{
+  MarkerPoints points;
+  ASSERT_TRUE(points.Decode(Cloud(2u, 2u)));
+
+  auto truncated = Cloud(2u, 2u);
+  truncated.mutable_data()->resize(truncated.data().size() - 8u);
+  EXPECT_FALSE(points.Decode(truncated));
+
+  auto bigEndian = Cloud(2u, 2u);
+  bigEndian.set_is_bigendian(true);
+  EXPECT_FALSE(points.Decode(bigEndian));
+
+  auto noZ = Cloud(2u, 2u);
+  noZ.mutable_field(2)->set_name("intensity");
+  EXPECT_FALSE(points.Decode(noZ));
+
+  auto outside = Cloud(2u, 2u);
+  outside.mutable_field(3)->set_offset(14u);
+  EXPECT_FALSE(points.Decode(outside));
+
+  // Points are unchanged
+  EXPECT_EQ(4u, points.positions.size());
+}
@@ -0,0 +1,299 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_MARKERMANAGER_POINTLOD_HH_
+#define GZ_GUI_PLUGINS_MARKERMANAGER_POINTLOD_HH_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <gz/math/Color.hh>
+#include <gz/math/Vector3.hh>
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  /// \brief Points of a marker decimated on a voxel grid.
+  struct PointLodLevel
+  {
+    /// \brief Size of the voxels, in meters.
+    double voxel{0.0};
+
+    /// \brief One point per occupied voxel, the average of its points.
+    std::vector<math::Vector3d> positions;
+
+    /// \brief Average color of the points of each voxel, empty if the
+    /// points have no colors.
+    std::vector<math::Color> colors;
+  };
+
+  /// \brief Levels of detail of large point markers, such as point clouds,
+  /// which are drawn with fewer points when they're far from the camera.
+  ///
+  /// Points are sorted along a Morton curve of a fine grid, which makes an
+  /// octree of it: the points of any octree node are contiguous, and the
+  /// node of a point at each depth is a prefix of its Morton code. Each
+  /// level keeps the average of the points of each occupied node at one
+  /// depth, and its voxels are at least twice as large as the ones of the
+  /// previous level.
+  class PointLod
+  {
+    /// \brief Most levels built for a marker.
+    public: static constexpr std::size_t kMaxLevels{6u};
+
+    /// \brief Build the levels of detail of some points.
+    /// \param[in] _positions Points. Points with a NaN or infinite
+    /// coordinate, such as the invalid points of organized clouds, are
+    /// left out.
+    /// \param[in] _colors Color of each point, or empty.
+    /// \param[in] _budget Most points of the finest level.
+    /// \return Levels, from the finest to the coarsest, each with fewer
+    /// points than the previous one. Empty if there are no finite points or
+    /// the budget is zero.
+    public: static std::vector<PointLodLevel> Build(
+        const std::vector<math::Vector3d> &_positions,
+        const std::vector<math::Color> &_colors, const std::size_t _budget)
+    {
+      std::vector<PointLodLevel> levels;
+      if (_budget == 0u)
+        return levels;
+
+      auto finite = [](const math::Vector3d &_position)
+      {
+        return std::isfinite(_position.X()) &&
+            std::isfinite(_position.Y()) && std::isfinite(_position.Z());
+      };
+
+      auto first = std::find_if(_positions.begin(), _positions.end(),
+          finite);
+      if (first == _positions.end())
+        return levels;
+
+      math::Vector3d min = *first;
+      math::Vector3d max = *first;
+      for (const auto &position : _positions)
+      {
+        if (!finite(position))
+          continue;
+        min.X() = std::min(min.X(), position.X());
+        min.Y() = std::min(min.Y(), position.Y());
+        min.Z() = std::min(min.Z(), position.Z());
+        max.X() = std::max(max.X(), position.X());
+        max.Y() = std::max(max.Y(), position.Y());
+        max.Z() = std::max(max.Z(), position.Z());
+      }
+      const double largest = std::max({max.X() - min.X(),
+          max.Y() - min.Y(), max.Z() - min.Z()});
+      const double cell = largest > 0.0 ? largest / kMaxCell : 1.0;
+
+      // Sort the points by the Morton code of their cell
+      std::vector<std::pair<uint64_t, uint32_t>> codes;
+      codes.reserve(_positions.size());
+      for (std::size_t i = 0; i < _positions.size(); ++i)
+      {
+        const auto &position = _positions[i];
+        if (!finite(position))
+          continue;
+        codes.emplace_back(
+            Spread(Cell(position.X() - min.X(), cell)) |
+            Spread(Cell(position.Y() - min.Y(), cell)) << 1 |
+            Spread(Cell(position.Z() - min.Z(), cell)) << 2,
+            static_cast<uint32_t>(i));
+      }
+      std::sort(codes.begin(), codes.end());
+
+      // Number of occupied nodes, 2^_depth cells wide
+      auto count = [&codes](const unsigned int _depth)
+      {
+        const unsigned int shift = 3u * _depth;
+        std::size_t result{1u};
+        for (std::size_t i = 1; i < codes.size(); ++i)
+        {
+          if ((codes[i].first >> shift) != (codes[i - 1].first >> shift))
+            ++result;
+        }
+        return result;
+      };
+
+      // The finest level is the first one within the budget. Coarser levels
+      // are only kept if they have fewer points.
+      std::size_t previous{0u};
+      for (unsigned int depth = 0u;
+           depth <= kBits && levels.size() < kMaxLevels; ++depth)
+      {
+        const std::size_t nodes = count(depth);
+        if ((levels.empty() && nodes > _budget) ||
+            (!levels.empty() && nodes == previous))
+        {
+          continue;
+        }
+        levels.push_back(Average(_positions, _colors, codes, depth,
+            std::ldexp(cell, static_cast<int>(depth)), nodes));
+        previous = nodes;
+        if (nodes == 1u)
+          break;
+      }
+      return levels;
+    }
+
+    /// \brief Pick a level for a distance to the camera.
+    /// \param[in] _levels Levels, see Build.
+    /// \param[in] _distance Distance from the camera to the points.
+    /// \param[in] _maxAngle Largest angle a voxel may span, in radians.
+    /// \param[in] _current Current level, or the number of levels if there
+    /// is none. It's kept while the distance is within 10% of a level
+    /// change, so that levels don't flicker while the camera moves.
+    /// \return Coarsest level whose voxels span at most the angle, or the
+    /// finest level.
+    public: static std::size_t Select(
+        const std::vector<PointLodLevel> &_levels, const double _distance,
+        const double _maxAngle, const std::size_t _current)
+    {
+      auto level = [&](const double _d)
+      {
+        std::size_t result{0u};
+        while (result + 1u < _levels.size() &&
+            _levels[result + 1u].voxel <= _maxAngle * _d)
+        {
+          ++result;
+        }
+        return result;
+      };
+
+      if (_current >= _levels.size())
+        return level(_distance);
+
+      const std::size_t coarser = level(_distance * 0.9);
+      if (coarser > _current)
+        return coarser;
+      const std::size_t finer = level(_distance * 1.1);
+      if (finer < _current)
+        return finer;
+      return _current;
+    }
+
+    /// \brief Average the points of each occupied node at a depth.
+    /// \param[in] _positions Points.
+    /// \param[in] _colors Color of each point, or empty.
+    /// \param[in] _codes Morton code and index of each point, sorted.
+    /// \param[in] _depth Depth of the nodes, zero for the finest cells.
+    /// \param[in] _voxel Size of the nodes.
+    /// \param[in] _nodes Number of occupied nodes.
+    /// \return Level with one point per node.
+    private: static PointLodLevel Average(
+        const std::vector<math::Vector3d> &_positions,
+        const std::vector<math::Color> &_colors,
+        const std::vector<std::pair<uint64_t, uint32_t>> &_codes,
+        const unsigned int _depth, const double _voxel,
+        const std::size_t _nodes)
+    {
+      const bool hasColors = _colors.size() == _positions.size();
+      const unsigned int shift = 3u * _depth;
+
+      PointLodLevel level;
+      level.voxel = _voxel;
+      level.positions.reserve(_nodes);
+      if (hasColors)
+        level.colors.reserve(_nodes);
+
+      std::size_t begin{0u};
+      while (begin < _codes.size())
+      {
+        const uint64_t node = _codes[begin].first >> shift;
+        std::array<double, 3> sum{0.0, 0.0, 0.0};
+        std::array<double, 4> colorSum{0.0, 0.0, 0.0, 0.0};
+        std::size_t end = begin;
+        for (; end < _codes.size() && (_codes[end].first >> shift) == node;
+             ++end)
+        {
+          const auto &position = _positions[_codes[end].second];
+          sum[0] += position.X();
+          sum[1] += position.Y();
+          sum[2] += position.Z();
+          if (hasColors)
+          {
+            const auto &color = _colors[_codes[end].second];
+            colorSum[0] += color.R();
+            colorSum[1] += color.G();
+            colorSum[2] += color.B();
+            colorSum[3] += color.A();
+          }
+        }
+
+        const double weight = static_cast<double>(end - begin);
+        level.positions.emplace_back(sum[0] / weight, sum[1] / weight,
+            sum[2] / weight);
+        if (hasColors)
+        {
+          level.colors.emplace_back(
+              static_cast<float>(colorSum[0] / weight),
+              static_cast<float>(colorSum[1] / weight),
+              static_cast<float>(colorSum[2] / weight),
+              static_cast<float>(colorSum[3] / weight));
+        }
+        begin = end;
+      }
+      return level;
+    }
+
+    /// \brief Coordinate of a cell along an axis.
+    /// \param[in] _offset Offset from the corner of the points' box.
+    /// \param[in] _cell Cell size.
+    /// \return Cell coordinate.
+    private: static uint64_t Cell(const double _offset, const double _cell)
+    {
+      // Also catches NaN, e.g. from boxes too large for a double
+      const double cell = std::floor(_offset / _cell);
+      if (!(cell > 0.0))
+        return 0u;
+      return static_cast<uint64_t>(std::min(cell, kMaxCell));
+    }
+
+    /// \brief Insert two zero bits before each of the lower 21 bits of a
+    /// value, to interleave three of them into a Morton code.
+    /// \param[in] _value Value.
+    /// \return Spread value.
+    private: static uint64_t Spread(uint64_t _value)
+    {
+      _value &= 0x1fffff;
+      _value = (_value | _value << 32) & 0x1f00000000ffff;
+      _value = (_value | _value << 16) & 0x1f0000ff0000ff;
+      _value = (_value | _value << 8) & 0x100f00f00f00f00f;
+      _value = (_value | _value << 4) & 0x10c30c30c30c30c3;
+      _value = (_value | _value << 2) & 0x1249249249249249;
+      return _value;
+    }
+
+    /// \brief Bits of a cell coordinate, and depth of the octree.
+    private: static constexpr unsigned int kBits{21u};
+
+    /// \brief Largest cell coordinate along an axis.
+    private: static constexpr double kMaxCell{(1u << kBits) - 1u};
+  };
+}
+}
+}
+
+#endif
@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "PointLodBuilder.hh"
+
+/// \brief Private data class for PointLodBuilder
+class ignition::gui::plugins::PointLodBuilderPrivate
+{
+  /// \brief Worker thread loop
+  public: void Work();
+
+  /// \brief Namespace and id of a marker
+  public: using Key = std::pair<std::string, uint64_t>;
+
+  /// \brief Points waiting for the worker
+  public: struct Job
+  {
+    /// \brief Points
+    std::vector<math::Vector3d> positions;
+
+    /// \brief Color of each point, or empty
+    std::vector<math::Color> colors;
+
+    /// \brief Number identifying the points among all jobs
+    uint64_t generation{0u};
+  };
+
+  /// \brief Most points of the finest level
+  public: std::size_t budget{0u};
+
+  /// \brief Protects all members below
+  public: std::mutex mutex;
+
+  /// \brief Notifies the worker of new points or shutdown
+  public: std::condition_variable cv;
+
+  /// \brief Latest points of each marker waiting for the worker
+  public: std::map<Key, Job> queued;
+
+  /// \brief Markers with queued points, in the order they were queued
+  public: std::deque<Key> order;
+
+  /// \brief Generation of the latest points of each marker which are
+  /// queued or being built
+  public: std::map<Key, uint64_t> latest;
+
+  /// \brief Generation of the last queued points
+  public: uint64_t generation{0u};
+
+  /// \brief Levels built since the last call to TakeFinished
+  public: std::vector<PointLodBuilder::Result> finished;
+
+  /// \brief Set to stop the worker
+  public: bool stop{false};
+
+  /// \brief Worker thread
+  public: std::thread worker;
+};
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+PointLodBuilder::PointLodBuilder(const std::size_t _budget)
+  : dataPtr(new PointLodBuilderPrivate)
+{
+  this->dataPtr->budget = _budget;
+  this->dataPtr->worker = std::thread(&PointLodBuilderPrivate::Work,
+      this->dataPtr.get());
+}
+
+/////////////////////////////////////////////////
+PointLodBuilder::~PointLodBuilder()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->stop = true;
+    this->dataPtr->queued.clear();
+    this->dataPtr->order.clear();
+  }
+  this->dataPtr->cv.notify_all();
+
+  if (this->dataPtr->worker.joinable())
+    this->dataPtr->worker.join();
+}
+
+/////////////////////////////////////////////////
+uint64_t PointLodBuilder::Build(const std::string &_ns, const uint64_t _id,
+    std::vector<math::Vector3d> _positions, std::vector<math::Color> _colors)
+{
+  uint64_t generation{0u};
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    PointLodBuilderPrivate::Key key{_ns, _id};
+    generation = ++this->dataPtr->generation;
+    this->dataPtr->latest[key] = generation;
+
+    // Levels of the replaced points which were built already are stale
+    auto &finished = this->dataPtr->finished;
+    finished.erase(std::remove_if(finished.begin(), finished.end(),
+        [&](const Result &_result)
+        {
+          return _result.ns == _ns && _result.id == _id;
+        }), finished.end());
+
+    // Replace the points which are still waiting
+    auto &job = this->dataPtr->queued[key];
+    if (job.generation == 0u)
+      this->dataPtr->order.push_back(key);
+    job.positions = std::move(_positions);
+    job.colors = std::move(_colors);
+    job.generation = generation;
+  }
+  this->dataPtr->cv.notify_one();
+  return generation;
+}
+
+/////////////////////////////////////////////////
+std::vector<PointLodBuilder::Result> PointLodBuilder::TakeFinished()
+{
+  std::vector<Result> result;
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  result.swap(this->dataPtr->finished);
+  return result;
+}
+
+/////////////////////////////////////////////////
+void PointLodBuilderPrivate::Work()
+{
+  while (true)
+  {
+    Key key;
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+      this->cv.wait(lock, [this]
+      {
+        return this->stop || !this->order.empty();
+      });
+      if (this->stop)
+        return;
+
+      key = std::move(this->order.front());
+      this->order.pop_front();
+      auto it = this->queued.find(key);
+      job = std::move(it->second);
+      this->queued.erase(it);
+    }
+
+    auto levels = PointLod::Build(job.positions, job.colors, this->budget);
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    auto it = this->latest.find(key);
+    if (it == this->latest.end() || it->second != job.generation)
+      continue;
+    this->latest.erase(it);
+    this->finished.push_back({key.first, key.second, job.generation,
+        std::move(levels)});
+  }
+}
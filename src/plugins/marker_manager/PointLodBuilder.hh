@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_MARKERMANAGER_POINTLODBUILDER_HH_
+#define GZ_GUI_PLUGINS_MARKERMANAGER_POINTLODBUILDER_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gz/math/Color.hh>
+#include <gz/math/Vector3.hh>
+
+#include "PointLod.hh"
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  class PointLodBuilderPrivate;
+
+  /// \brief Builds the levels of detail of point markers on a worker
+  /// thread, see PointLod.
+  ///
+  /// Only the latest points of each marker are built: points queued for a
+  /// marker replace the ones which are still waiting, and levels built from
+  /// points which were replaced meanwhile are discarded, even once they
+  /// are finished. Each result carries the generation returned by the Build
+  /// call of its points, so that callers can tell it apart from the results
+  /// of other points of the same marker.
+  class PointLodBuilder
+  {
+    /// \brief Levels of detail of a marker.
+    public: struct Result
+    {
+      /// \brief Marker namespace.
+      std::string ns;
+
+      /// \brief Marker id.
+      uint64_t id{0u};
+
+      /// \brief Generation of the points, as returned by Build.
+      uint64_t generation{0u};
+
+      /// \brief Levels, see PointLod::Build.
+      std::vector<PointLodLevel> levels;
+    };
+
+    /// \brief Constructor. Starts the worker thread.
+    /// \param[in] _budget Most points of the finest level.
+    public: explicit PointLodBuilder(const std::size_t _budget);
+
+    /// \brief Destructor. Waits for the points being built and stops the
+    /// worker thread. Queued points are discarded.
+    public: ~PointLodBuilder();
+
+    /// \brief Queue the points of a marker.
+    /// \param[in] _ns Marker namespace.
+    /// \param[in] _id Marker id.
+    /// \param[in] _positions Points.
+    /// \param[in] _colors Color of each point, or empty.
+    /// \return Generation of the points, never zero.
+    public: uint64_t Build(const std::string &_ns, const uint64_t _id,
+        std::vector<math::Vector3d> _positions,
+        std::vector<math::Color> _colors);
+
+    /// \brief Get the levels which were built since the last call.
+    /// \return Levels of each marker.
+    public: std::vector<Result> TakeFinished();
+
+    /// \internal
+    /// \brief Pointer to private data.
+    private: std::unique_ptr<PointLodBuilderPrivate> dataPtr;
+  };
+}
+}
+}
+
+#endif
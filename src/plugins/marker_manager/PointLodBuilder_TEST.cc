@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "gz/gui/config.hh"
+
+#include "PointLodBuilder.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+namespace
+{
+  /// \brief Make points along the X axis.
+  /// \param[in] _count Number of points.
+  /// \return Points.
+  std::vector<math::Vector3d> Line(const int _count)
+  {
+    std::vector<math::Vector3d> positions;
+    for (int i = 0; i < _count; ++i)
+      positions.emplace_back(i, 0.0, 0.0);
+    return positions;
+  }
+
+  /// \brief Wait for the builder to finish levels.
+  /// \param[in] _builder Builder.
+  /// \return Levels built, empty if none were built in time.
+  std::vector<PointLodBuilder::Result> WaitFinished(PointLodBuilder &_builder)
+  {
+    std::vector<PointLodBuilder::Result> results;
+    for (int i = 0; i < 500 && results.empty(); ++i)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      results = _builder.TakeFinished();
+    }
+    return results;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(PointLodBuilderTest, Build)
+{
+  PointLodBuilder builder(100u);
+  const uint64_t generation = builder.Build("ns", 1u, Line(1000), {});
+  EXPECT_NE(0u, generation);
+
+  auto results = WaitFinished(builder);
+  ASSERT_EQ(1u, results.size());
+  EXPECT_EQ("ns", results[0].ns);
+  EXPECT_EQ(1u, results[0].id);
+  EXPECT_EQ(generation, results[0].generation);
+  EXPECT_FALSE(results[0].levels.empty());
+
+  EXPECT_TRUE(builder.TakeFinished().empty());
+}
+
+/////////////////////////////////////////////////
+TEST(PointLodBuilderTest, Replaced)
+{
+  PointLodBuilder builder(100u);
+  const uint64_t first = builder.Build("ns", 1u, Line(1000), {});
+  const uint64_t other = builder.Build("ns", 2u, Line(10), {});
+
+  // Let the first points finish, then replace them before they're taken
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  const uint64_t second = builder.Build("ns", 1u, Line(500), {});
+  EXPECT_NE(first, second);
+
+  // Only the latest points of each marker are handed out
+  std::vector<PointLodBuilder::Result> results = builder.TakeFinished();
+  for (int i = 0; i < 500 && results.size() < 2u; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    for (auto &result : builder.TakeFinished())
+      results.push_back(std::move(result));
+  }
+  ASSERT_EQ(2u, results.size());
+  for (const auto &result : results)
+  {
+    if (result.id == 1u)
+    {
+      EXPECT_EQ(second, result.generation);
+      EXPECT_FALSE(result.levels.empty());
+    }
+    else
+    {
+      EXPECT_EQ(2u, result.id);
+      EXPECT_EQ(other, result.generation);
+    }
+  }
+}
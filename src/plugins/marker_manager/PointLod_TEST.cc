@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <vector>
+
+#include "gz/gui/config.hh"
+
+#include "PointLod.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+TEST(PointLodTest, Empty)
+{
+  std::vector<math::Vector3d> positions;
+  EXPECT_TRUE(PointLod::Build(positions, {}, 10u).empty());
+
+  positions.emplace_back(1.0, 2.0, 3.0);
+  EXPECT_TRUE(PointLod::Build(positions, {}, 0u).empty());
+}
+
+/////////////////////////////////////////////////
+TEST(PointLodTest, Plane)
+{
+  // 100 x 100 points, one meter apart
+  std::vector<math::Vector3d> positions;
+  for (int x = 0; x < 100; ++x)
+  {
+    for (int y = 0; y < 100; ++y)
+      positions.emplace_back(x, y, 0.0);
+  }
+
+  auto levels = PointLod::Build(positions, {}, 1000u);
+  ASSERT_GE(levels.size(), 2u);
+  EXPECT_LE(levels.size(), PointLod::kMaxLevels);
+  EXPECT_LE(levels[0].positions.size(), 1000u);
+  EXPECT_GT(levels[0].positions.size(), 250u);
+
+  for (std::size_t i = 0; i < levels.size(); ++i)
+  {
+    EXPECT_TRUE(levels[i].colors.empty());
+    if (i == 0u)
+      continue;
+    EXPECT_LT(levels[i].positions.size(), levels[i - 1].positions.size());
+    EXPECT_GE(levels[i].voxel, 2.0 * levels[i - 1].voxel);
+  }
+
+  // Points stay within the cloud
+  for (const auto &position : levels.back().positions)
+  {
+    EXPECT_GE(position.X(), 0.0);
+    EXPECT_LE(position.X(), 99.0);
+    EXPECT_DOUBLE_EQ(0.0, position.Z());
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(PointLodTest, Average)
+{
+  // Two close points and a far one
+  std::vector<math::Vector3d> positions{
+      {0.0, 0.0, 0.0}, {0.1, 0.0, 0.0}, {10.0, 0.0, 0.0}};
+  std::vector<math::Color> colors{
+      {1.0f, 0.0f, 0.0f, 1.0f},
+      {0.0f, 0.0f, 1.0f, 1.0f},
+      {0.0f, 1.0f, 0.0f, 0.5f}};
+
+  auto levels = PointLod::Build(positions, colors, 2u);
+  ASSERT_EQ(2u, levels.size());
+  ASSERT_EQ(2u, levels[0].positions.size());
+  ASSERT_EQ(2u, levels[0].colors.size());
+
+  EXPECT_DOUBLE_EQ(0.05, levels[0].positions[0].X());
+  EXPECT_FLOAT_EQ(0.5f, levels[0].colors[0].R());
+  EXPECT_FLOAT_EQ(0.0f, levels[0].colors[0].G());
+  EXPECT_FLOAT_EQ(0.5f, levels[0].colors[0].B());
+  EXPECT_DOUBLE_EQ(10.0, levels[0].positions[1].X());
+  EXPECT_FLOAT_EQ(0.5f, levels[0].colors[1].A());
+
+  // The coarsest level weighs each point the same
+  ASSERT_EQ(1u, levels[1].positions.size());
+  EXPECT_NEAR(10.1 / 3.0, levels[1].positions[0].X(), 1e-9);
+  EXPECT_FLOAT_EQ(1.0f / 3.0f, levels[1].colors[0].R());
+}
+
+/////////////////////////////////////////////////
+TEST(PointLodTest, Coincident)
+{
+  std::vector<math::Vector3d> positions(5u, math::Vector3d(1.0, 1.0, 1.0));
+  auto levels = PointLod::Build(positions, {}, 2u);
+  ASSERT_EQ(1u, levels.size());
+  ASSERT_EQ(1u, levels[0].positions.size());
+  EXPECT_DOUBLE_EQ(1.0, levels[0].positions[0].Y());
+}
+
+/////////////////////////////////////////////////
+TEST(PointLodTest, NonFinite)
+{
+  // Invalid points of organized clouds are NaN, and are left out
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const double inf = std::numeric_limits<double>::infinity();
+  std::vector<math::Vector3d> positions{
+      {nan, nan, nan}, {0.0, 0.0, 0.0}, {1.0, inf, 0.0}, {2.0, 0.0, 0.0},
+      {0.0, 0.0, -inf}};
+  std::vector<math::Color> colors(positions.size(), math::Color::Red);
+  colors[3] = math::Color::Blue;
+
+  auto levels = PointLod::Build(positions, colors, 10u);
+  ASSERT_FALSE(levels.empty());
+  ASSERT_EQ(2u, levels[0].positions.size());
+  EXPECT_DOUBLE_EQ(0.0, levels[0].positions[0].X());
+  EXPECT_DOUBLE_EQ(2.0, levels[0].positions[1].X());
+  EXPECT_EQ(math::Color::Blue, levels[0].colors[1]);
+  for (const auto &level : levels)
+  {
+    for (const auto &position : level.positions)
+      EXPECT_TRUE(position.IsFinite());
+  }
+
+  // Only invalid points
+  positions.assign(3u, math::Vector3d(nan, 0.0, 0.0));
+  EXPECT_TRUE(PointLod::Build(positions, {}, 10u).empty());
+
+  // Finite points too far apart for the size of their box to be finite
+  positions = {{-1e308, 0.0, 0.0}, {1e308, 0.0, 0.0}};
+  levels = PointLod::Build(positions, {}, 10u);
+  ASSERT_FALSE(levels.empty());
+  EXPECT_TRUE(levels[0].positions[0].IsFinite());
+}
+
+/////////////////////////////////////////////////
+TEST(PointLodTest, Select)
+{
+  std::vector<PointLodLevel> levels(3u);
+  levels[0].voxel = 1.0;
+  levels[1].voxel = 2.0;
+  levels[2].voxel = 4.0;
+
+  // Voxels up to 0.01 rad
+  EXPECT_EQ(0u, PointLod::Select(levels, 50.0, 0.01, 3u));
+  EXPECT_EQ(1u, PointLod::Select(levels, 250.0, 0.01, 3u));
+  EXPECT_EQ(2u, PointLod::Select(levels, 1000.0, 0.01, 3u));
+
+  // Close to a change, the current level is kept
+  EXPECT_EQ(0u, PointLod::Select(levels, 210.0, 0.01, 0u));
+  EXPECT_EQ(1u, PointLod::Select(levels, 190.0, 0.01, 1u));
+  EXPECT_EQ(1u, PointLod::Select(levels, 230.0, 0.01, 0u));
+  EXPECT_EQ(0u, PointLod::Select(levels, 170.0, 0.01, 1u));
+
+  // No levels
+  EXPECT_EQ(0u, PointLod::Select({}, 100.0, 0.01, 0u));
+}
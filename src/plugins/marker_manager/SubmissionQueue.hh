@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_MARKERMANAGER_SUBMISSIONQUEUE_HH_
+#define GZ_GUI_PLUGINS_MARKERMANAGER_SUBMISSIONQUEUE_HH_
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  /// \brief Lock-free queue where any number of threads submit values,
+  /// which are taken all at once by the consumer, e.g. once per frame.
+  ///
+  /// Values are pushed onto an atomic linked list, and taking them swaps
+  /// the whole list out, so neither side ever waits for the other.
+  /// \tparam T Value type, which must be movable.
+  template <typename T>
+  class SubmissionQueue
+  {
+    /// \brief Constructor
+    public: SubmissionQueue() = default;
+
+    /// \brief No copy constructor
+    public: SubmissionQueue(const SubmissionQueue &) = delete;
+
+    /// \brief No copy assignment
+    public: SubmissionQueue &operator=(const SubmissionQueue &) = delete;
+
+    /// \brief Destructor. Drops the values which weren't taken.
+    public: ~SubmissionQueue()
+    {
+      Node *node = this->head.exchange(nullptr);
+      while (nullptr != node)
+      {
+        Node *next = node->next;
+        delete node;
+        node = next;
+      }
+    }
+
+    /// \brief Submit a value. Safe to call from any thread.
+    /// \param[in] _value Value to submit.
+    public: void Push(T _value)
+    {
+      Node *node = new Node{std::move(_value),
+          this->head.load(std::memory_order_relaxed)};
+      while (!this->head.compare_exchange_weak(node->next, node,
+          std::memory_order_release, std::memory_order_relaxed))
+      {
+      }
+    }
+
+    /// \brief Take all submitted values.
+    /// \return Values, in the order they were submitted.
+    public: std::vector<T> TakeAll()
+    {
+      Node *node = this->head.exchange(nullptr, std::memory_order_acquire);
+
+      // The list holds the newest value first
+      std::vector<T> result;
+      while (nullptr != node)
+      {
+        result.push_back(std::move(node->value));
+        Node *next = node->next;
+        delete node;
+        node = next;
+      }
+      std::reverse(result.begin(), result.end());
+      return result;
+    }
+
+    /// \brief Check whether there are values to take.
+    /// \return True if no values were submitted since they were last taken.
+    public: bool Empty() const
+    {
+      return nullptr == this->head.load(std::memory_order_acquire);
+    }
+
+    /// \brief Element of the list.
+    private: struct Node
+    {
+      /// \brief Submitted value.
+      T value;
+
+      /// \brief Value submitted before this one.
+      Node *next;
+    };
+
+    /// \brief Last submitted value.
+    private: std::atomic<Node *> head{nullptr};
+  };
+}
+}
+}
+
+#endif
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gz/gui/config.hh"
+
+#include "SubmissionQueue.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+TEST(SubmissionQueueTest, Order)
+{
+  SubmissionQueue<std::unique_ptr<int>> queue;
+  EXPECT_TRUE(queue.Empty());
+  EXPECT_TRUE(queue.TakeAll().empty());
+
+  for (int i = 0; i < 5; ++i)
+    queue.Push(std::make_unique<int>(i));
+  EXPECT_FALSE(queue.Empty());
+
+  auto values = queue.TakeAll();
+  ASSERT_EQ(5u, values.size());
+  for (int i = 0; i < 5; ++i)
+    EXPECT_EQ(i, *values[i]);
+  EXPECT_TRUE(queue.Empty());
+
+  // Values left in the queue are freed with it
+  queue.Push(std::make_unique<int>(5));
+}
+
+/////////////////////////////////////////////////
+TEST(SubmissionQueueTest, Threads)
+{
+  SubmissionQueue<int> queue;
+  const int producers = 4;
+  const int count = 10000;
+
+  std::vector<int> taken;
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p)
+  {
+    threads.emplace_back([&queue, p]()
+    {
+      for (int i = 0; i < count; ++i)
+        queue.Push(p * count + i);
+    });
+  }
+
+  // Take while producers are pushing
+  while (taken.size() < static_cast<std::size_t>(producers * count))
+  {
+    for (int value : queue.TakeAll())
+      taken.push_back(value);
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  // Each producer's values are in order, and none is lost
+  std::vector<int> next(producers, 0);
+  for (int value : taken)
+  {
+    const int p = value / count;
+    EXPECT_EQ(p * count + next[p], value);
+    ++next[p];
+  }
+  for (int p = 0; p < producers; ++p)
+    EXPECT_EQ(count, next[p]);
+}
@@ -24,6 +24,8 @@
 #include <string>
 #include <vector>
 
+#include <QOpenGLExtraFunctions>
+
 #include <gz/common/Console.hh>
 #include <gz/common/KeyEvent.hh>
 #include <gz/common/MouseEvent.hh>
@@ -65,6 +67,8 @@
 #include "gz/gui/Helpers.hh"
 #include "gz/gui/MainWindow.hh"
 
+#include "RenderSync.hh"
+
 Q_DECLARE_METATYPE(gz::gui::plugins::RenderSync*)
 
 /// \brief Private data class for IgnRenderer
@@ -118,89 +122,6 @@ class ignition::gui::plugins::IgnRenderer::Implementation
   public: math::Vector3d target;
 };
 
-/// \brief Qt and Ogre rendering is happening in different threads
-/// The original sample 'textureinthread' from Qt used a double-buffer
-/// scheme so that the worker (Ogre) thread write to FBO A, while
-/// Qt is displaying FBO B.
-///
-/// However Qt's implementation doesn't handle all the edge cases
-/// (like resizing a window), and also it increases our VRAM
-/// consumption in multiple ways (since we have to double other
-/// resources as well or re-architect certain parts of the code
-/// to avoid it)
-///
-/// Thus we just serialize both threads so that when Qt reaches
-/// drawing preparation, it halts and Ogre worker thread starts rendering,
-/// then resumes when Ogre is done.
-///
-/// This code is admitedly more complicated than it should be
-/// because Qt's synchronization using signals and slots causes
-/// deadlocks when other means of synchronization are introduced.
-/// The whole threaded loop should be rewritten.
-///
-/// All RenderSync does is conceptually:
-///
-/// \code
-///   TextureNode::PrepareNode()
-///   {
-///     renderSync.WaitForWorkerThread(); // Qt thread
-///       // WaitForQtThreadAndBlock();
-///       // Now worker thread begins executing what's between
-///       // ReleaseQtThreadFromBlock();
-///     continue with qt code...
-///   }
-/// \endcode
-///
-///
-/// For more info see
-/// https://github.com/gazebosim/gz-rendering/issues/304
-class ignition::gui::plugins::RenderSync
-{
-  /// \brief Cond. variable to synchronize rendering on specific events
-  /// (e.g. texture resize) or for debugging (e.g. keep
-  /// all API calls sequential)
-  public: std::mutex mutex;
-
-  /// \brief Cond. variable to synchronize rendering on specific events
-  /// (e.g. texture resize) or for debugging (e.g. keep
-  /// all API calls sequential)
-  public: std::condition_variable cv;
-
-  public: enum class RenderStallState
-          {
-            /// Qt is stuck inside WaitForWorkerThread
-            /// Worker thread can proceed
-            WorkerCanProceed,
-            /// Qt is stuck inside WaitForWorkerThread
-            /// Worker thread is between WaitForQtThreadAndBlock
-            /// and ReleaseQtThreadFromBlock
-            WorkerIsProceeding,
-            /// Worker is stuck inside WaitForQtThreadAndBlock
-            /// Qt can proceed
-            QtCanProceed,
-            /// Do not block
-            ShuttingDown,
-          };
-
-  /// \brief See TextureNode::RenderSync::RenderStallState
-  public: RenderStallState renderStallState =
-      RenderStallState::QtCanProceed /*GUARDED_BY(sharedRenderMutex)*/;
-
-  /// \brief Must be called from worker thread when we want to block
-  /// \param[in] lock Acquired lock. Must be based on this->mutex
-  public: void WaitForQtThreadAndBlock(std::unique_lock<std::mutex> &_lock);
-
-  /// \brief Must be called from worker thread when we are done
-  /// \param[in] lock Acquired lock. Must be based on this->mutex
-  public: void ReleaseQtThreadFromBlock(std::unique_lock<std::mutex> &_lock);
-
-  /// \brief Must be called from Qt thread periodically
-  public: void WaitForWorkerThread();
-
-  /// \brief Must be called from GUI thread when shutting down
-  public: void Shutdown();
-};
-
 /// \brief Private data class for RenderWindowItem
 class ignition::gui::plugins::RenderWindowItem::Implementation
 {
@@ -231,65 +152,6 @@ using namespace plugins;
 
 QList<QThread *> RenderWindowItem::Implementation::threads;
 
-/////////////////////////////////////////////////
-void RenderSync::WaitForQtThreadAndBlock(std::unique_lock<std::mutex> &_lock)
-{
-  this->cv.wait(_lock, [this]
-  { return this->renderStallState == RenderStallState::WorkerCanProceed ||
-           this->renderStallState == RenderStallState::ShuttingDown; });
-
-  this->renderStallState = RenderStallState::WorkerIsProceeding;
-}
-
-/////////////////////////////////////////////////
-void RenderSync::ReleaseQtThreadFromBlock(std::unique_lock<std::mutex> &_lock)
-{
-  this->renderStallState = RenderStallState::QtCanProceed;
-  _lock.unlock();
-  this->cv.notify_one();
-}
-
-/////////////////////////////////////////////////
-void RenderSync::WaitForWorkerThread()
-{
-  std::unique_lock<std::mutex> lock(this->mutex);
-
-  // Wait until we're clear to go
-  this->cv.wait( lock, [this]
-  {
-    return this->renderStallState == RenderStallState::QtCanProceed ||
-           this->renderStallState == RenderStallState::ShuttingDown;
-  } );
-
-  // Worker thread asked us to wait!
-  this->renderStallState = RenderStallState::WorkerCanProceed;
-
-  lock.unlock();
-  // Wake up worker thread
-  this->cv.notify_one();
-  lock.lock();
-
-  // Wait until we're clear to go
-  this->cv.wait( lock, [this]
-  {
-    return this->renderStallState == RenderStallState::QtCanProceed ||
-           this->renderStallState == RenderStallState::ShuttingDown;
-  } );
-}
-
-/////////////////////////////////////////////////
-void RenderSync::Shutdown()
-{
-  {
-    std::unique_lock<std::mutex> lock(this->mutex);
-
-    this->renderStallState = RenderStallState::ShuttingDown;
-
-    lock.unlock();
-    this->cv.notify_one();
-  }
-}
-
 /////////////////////////////////////////////////
 IgnRenderer::IgnRenderer()
   : dataPtr(utils::MakeUniqueImpl<Implementation>())
@@ -299,8 +161,15 @@ IgnRenderer::IgnRenderer()
 /////////////////////////////////////////////////
 void IgnRenderer::Render(RenderSync *_renderSync)
 {
-  std::unique_lock<std::mutex> lock(_renderSync->mutex);
-  _renderSync->WaitForQtThreadAndBlock(lock);
+  // In buffered mode, Qt never shows the camera's render texture, so it can
+  // be rendered and resized without blocking Qt
+  const bool buffered = _renderSync->Buffered();
+  std::unique_lock<std::mutex> lock(_renderSync->mutex, std::defer_lock);
+  if (!buffered)
+  {
+    lock.lock();
+    _renderSync->WaitForQtThreadAndBlock(lock);
+  }
 
   if (this->textureDirty)
   {
@@ -367,7 +236,9 @@ void IgnRenderer::Render(RenderSync *_renderSync)
         gz::gui::App()->findChild<gz::gui::MainWindow *>(),
         new gui::events::Render());
   }
-  _renderSync->ReleaseQtThreadFromBlock(lock);
+
+  if (!buffered)
+    _renderSync->ReleaseQtThreadFromBlock(lock);
 }
 
 /////////////////////////////////////////////////
@@ -725,9 +596,126 @@ void RenderThread::RenderNext(RenderSync *_renderSync)
     return;
   }
 
+  // In buffered mode, only render if there's a texture to copy the frame to
+  int buffer{-1};
+  if (_renderSync->Buffered())
+  {
+    this->renderSync = _renderSync;
+    buffer = _renderSync->AcquireBuffer();
+    if (buffer < 0)
+      return;
+  }
+
   this->ignRenderer.Render(_renderSync);
 
-  emit TextureReady(this->ignRenderer.textureId, this->ignRenderer.textureSize);
+  if (buffer < 0)
+  {
+    emit TextureReady(this->ignRenderer.textureId,
+        this->ignRenderer.textureSize);
+    return;
+  }
+
+  // Qt never shows the camera's texture in buffered mode, only the copy
+  this->CopyToBuffer(_renderSync, buffer);
+  const bool renderAhead = _renderSync->PublishBuffer();
+  emit FramePublished();
+
+  if (renderAhead)
+  {
+    QMetaObject::invokeMethod(this, "RenderNext", Qt::QueuedConnection,
+        Q_ARG(RenderSync*, _renderSync));
+  }
+}
+
+/////////////////////////////////////////////////
+void RenderThread::CopyToBuffer(RenderSync *_renderSync, const int _index)
+{
+  // The buffer is owned by this thread until it's published
+  auto &buffer = _renderSync->buffers[_index];
+  auto functions = this->context->extraFunctions();
+  const GLuint source = this->ignRenderer.textureId;
+  const QSize size = this->ignRenderer.textureSize;
+
+  // Wait for Qt to be done drawing the buffer, and drop the copy which Qt
+  // didn't take
+  if (buffer.released)
+  {
+    functions->glWaitSync(buffer.released, 0, GL_TIMEOUT_IGNORED);
+    functions->glDeleteSync(buffer.released);
+    buffer.released = nullptr;
+  }
+  if (buffer.copied)
+  {
+    functions->glDeleteSync(buffer.copied);
+    buffer.copied = nullptr;
+  }
+
+  GLint texture{0};
+  functions->glGetIntegerv(GL_TEXTURE_BINDING_2D, &texture);
+
+  // Textures are created again after a resize, with the render texture's
+  // format, so that sRGB textures are drawn the same way
+  if (buffer.id == 0u || buffer.size != size)
+  {
+    GLint format{GL_RGBA8};
+    functions->glBindTexture(GL_TEXTURE_2D, source);
+    functions->glGetTexLevelParameteriv(GL_TEXTURE_2D, 0,
+        GL_TEXTURE_INTERNAL_FORMAT, &format);
+
+    if (buffer.id != 0u)
+      functions->glDeleteTextures(1, &buffer.id);
+    functions->glGenTextures(1, &buffer.id);
+    functions->glBindTexture(GL_TEXTURE_2D, buffer.id);
+    functions->glTexImage2D(GL_TEXTURE_2D, 0, format, size.width(),
+        size.height(), 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    functions->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+        GL_LINEAR);
+    functions->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER,
+        GL_LINEAR);
+    functions->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S,
+        GL_CLAMP_TO_EDGE);
+    functions->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T,
+        GL_CLAMP_TO_EDGE);
+    functions->glBindTexture(GL_TEXTURE_2D, texture);
+    buffer.size = size;
+  }
+
+  if (this->readFramebuffer == 0u)
+    functions->glGenFramebuffers(1, &this->readFramebuffer);
+  if (this->drawFramebuffer == 0u)
+    functions->glGenFramebuffers(1, &this->drawFramebuffer);
+
+  // Keep the render engine's state, which it may cache
+  GLint read{0};
+  GLint draw{0};
+  functions->glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &read);
+  functions->glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &draw);
+  const bool scissor = functions->glIsEnabled(GL_SCISSOR_TEST);
+  const bool srgb = functions->glIsEnabled(GL_FRAMEBUFFER_SRGB);
+  if (scissor)
+    functions->glDisable(GL_SCISSOR_TEST);
+  if (srgb)
+    functions->glDisable(GL_FRAMEBUFFER_SRGB);
+
+  functions->glBindFramebuffer(GL_READ_FRAMEBUFFER, this->readFramebuffer);
+  functions->glFramebufferTexture2D(GL_READ_FRAMEBUFFER,
+      GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, source, 0);
+  functions->glBindFramebuffer(GL_DRAW_FRAMEBUFFER, this->drawFramebuffer);
+  functions->glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER,
+      GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, buffer.id, 0);
+  functions->glBlitFramebuffer(0, 0, size.width(), size.height(),
+      0, 0, size.width(), size.height(), GL_COLOR_BUFFER_BIT, GL_NEAREST);
+
+  functions->glBindFramebuffer(GL_READ_FRAMEBUFFER, read);
+  functions->glBindFramebuffer(GL_DRAW_FRAMEBUFFER, draw);
+  if (scissor)
+    functions->glEnable(GL_SCISSOR_TEST);
+  if (srgb)
+    functions->glEnable(GL_FRAMEBUFFER_SRGB);
+
+  // Qt's context waits for the copy before drawing the buffer
+  buffer.copied = functions->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  functions->glFlush();
 }
 
 /////////////////////////////////////////////////
@@ -738,6 +726,27 @@ void RenderThread::ShutDown()
 
   this->ignRenderer.Destroy();
 
+  // Free the texture buffers
+  if (this->context && this->renderSync)
+  {
+    auto functions = this->context->extraFunctions();
+    std::lock_guard<std::mutex> lock(this->renderSync->mutex);
+    for (auto &buffer : this->renderSync->buffers)
+    {
+      if (buffer.id != 0u)
+        functions->glDeleteTextures(1, &buffer.id);
+      if (buffer.copied)
+        functions->glDeleteSync(buffer.copied);
+      if (buffer.released)
+        functions->glDeleteSync(buffer.released);
+      buffer = RenderSync::TextureBuffer();
+    }
+    if (this->readFramebuffer != 0u)
+      functions->glDeleteFramebuffers(1, &this->readFramebuffer);
+    if (this->drawFramebuffer != 0u)
+      functions->glDeleteFramebuffers(1, &this->drawFramebuffer);
+  }
+
   if (this->context)
   {
     this->context->doneCurrent();
@@ -807,38 +816,60 @@ void TextureNode::NewTexture(uint _id, const QSize &_size)
 }
 
 /////////////////////////////////////////////////
-void TextureNode::PrepareNode()
+void TextureNode::ShowTexture(uint _id, const QSize &_size)
 {
-  this->mutex.lock();
-  uint newId = this->id;
-  QSize sz = this->size;
-  this->id = 0;
-  this->mutex.unlock();
-  if (newId)
-  {
-    delete this->texture;
-    // note: include QQuickWindow::TextureHasAlphaChannel if the rendered
-    // content has alpha.
+  delete this->texture;
+  // note: include QQuickWindow::TextureHasAlphaChannel if the rendered
+  // content has alpha.
 #if QT_VERSION < QT_VERSION_CHECK(5, 14, 0)
-    this->texture = this->window->createTextureFromId(
-        newId, sz, QQuickWindow::TextureIsOpaque);
+  this->texture = this->window->createTextureFromId(
+      _id, _size, QQuickWindow::TextureIsOpaque);
 #else
-    // TODO(anyone) Use createTextureFromNativeObject
-    // https://github.com/ignitionrobotics/ign-gui/issues/113
+  // TODO(anyone) Use createTextureFromNativeObject
+  // https://github.com/ignitionrobotics/ign-gui/issues/113
 #ifndef _WIN32
 # pragma GCC diagnostic push
 # pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 #endif
-    this->texture = this->window->createTextureFromId(
-        newId, sz, QQuickWindow::TextureIsOpaque);
+  this->texture = this->window->createTextureFromId(
+      _id, _size, QQuickWindow::TextureIsOpaque);
 #ifndef _WIN32
 # pragma GCC diagnostic pop
 #endif
 
 #endif
-    this->setTexture(this->texture);
+  this->setTexture(this->texture);
+
+  this->markDirty(DirtyMaterial);
+}
+
+/////////////////////////////////////////////////
+void TextureNode::PrepareNode()
+{
+  // In buffered mode, show the latest copy without waiting for the worker
+  // thread, and let it render the next frame into the buffer released here
+  if (this->renderSync.Buffered())
+  {
+    GLuint newId{0u};
+    QSize sz;
+    if (this->renderSync.TakeBuffer(
+        QOpenGLContext::currentContext()->extraFunctions(), newId, sz))
+    {
+      this->ShowTexture(newId, sz);
+      if (this->renderSync.RequestRender())
+        emit TextureInUse(&this->renderSync);
+    }
+    return;
+  }
 
-    this->markDirty(DirtyMaterial);
+  this->mutex.lock();
+  uint newId = this->id;
+  QSize sz = this->size;
+  this->id = 0;
+  this->mutex.unlock();
+  if (newId)
+  {
+    this->ShowTexture(newId, sz);
 
     // This will notify the rendering thread that the texture is now being
     // rendered and it can start rendering to the other one.
@@ -958,7 +989,9 @@ QSGNode *RenderWindowItem::updatePaintNode(QSGNode *_node,
     // When a new texture is ready on the rendering thread, we use a direct
     // connection to the texture node to let it know a new texture can be used.
     // The node will then emit PendingNewTexture which we bind to
-    // QQuickWindow::update to schedule a redraw.
+    // QQuickWindow::update to schedule a redraw. In buffered mode, the node
+    // takes the published buffer from the RenderSync instead, so a published
+    // frame only schedules the redraw.
     //
     // When the scene graph starts rendering the next frame, the PrepareNode()
     // function is used to update the node with the new texture. Once it
@@ -975,6 +1008,9 @@ QSGNode *RenderWindowItem::updatePaintNode(QSGNode *_node,
     this->dataPtr->connections << this->connect(node,
         &TextureNode::PendingNewTexture, this->window(),
         &QQuickWindow::update, Qt::QueuedConnection);
+    this->dataPtr->connections << this->connect(this->dataPtr->renderThread,
+        &RenderThread::FramePublished, this->window(),
+        &QQuickWindow::update, Qt::QueuedConnection);
     this->dataPtr->connections << this->connect(this->window(),
         &QQuickWindow::beforeRendering, node, &TextureNode::PrepareNode,
         Qt::DirectConnection);
@@ -1055,6 +1091,21 @@ void RenderWindowItem::SetCameraViewController(
     _view_controller;
 }
 
+/////////////////////////////////////////////////
+void RenderWindowItem::SetTextureBuffers(unsigned int _buffers)
+{
+  if (_buffers < 1u || _buffers > 3u)
+  {
+    ignwarn << "Unable to use [" << _buffers << "] texture buffers, using "
+            << "[" << std::clamp(_buffers, 1u, 3u) << "]" << std::endl;
+    _buffers = std::clamp(_buffers, 1u, 3u);
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->renderSync.mutex);
+  this->dataPtr->renderSync.textureBuffers = _buffers;
+  this->dataPtr->renderSync.buffers.resize(_buffers > 1u ? _buffers : 0u);
+}
+
 /////////////////////////////////////////////////
 MinimalScene::MinimalScene()
   : Plugin(), dataPtr(utils::MakeUniqueImpl<Implementation>())
@@ -1200,6 +1251,21 @@ void MinimalScene::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
     {
       renderWindow->SetCameraViewController(elem->GetText());
     }
+
+    elem = _pluginElem->FirstChildElement("texture_buffers");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      unsigned int buffers;
+      if (elem->QueryUnsignedText(&buffers) == tinyxml2::XML_SUCCESS)
+      {
+        renderWindow->SetTextureBuffers(buffers);
+      }
+      else
+      {
+        ignerr << "Unable to set <texture_buffers> to '" << elem->GetText()
+               << "' using a single texture" << std::endl;
+      }
+    }
   }
 
   renderWindow->SetEngineName(cmdRenderEngine);
@@ -65,6 +65,13 @@ namespace plugins
   ///                        defaults to 90
   /// * \<view_controller> : Set the view controller (InteractiveViewControl
   ///                        currently supports types: ortho or orbit).
+  /// * \<texture_buffers\> : Number of textures the scene is shown from,
+  ///                        1 to 3, defaults to 1. With 1, Qt waits for
+  ///                        each frame to be rendered. With 2, a frame is
+  ///                        rendered while Qt draws the previous one, at the
+  ///                        cost of copying each frame into another texture
+  ///                        of the window's size. With 3, rendering can also
+  ///                        start before Qt takes the previous frame.
   class MinimalScene : public Plugin
   {
     Q_OBJECT
@@ -271,12 +278,23 @@ namespace plugins
     /// \brief Slot called to update render texture size
     public slots: void SizeChanged();
 
+    /// \brief Copy the rendered frame into a texture buffer, in buffered
+    /// mode
+    /// \param[in] _renderSync RenderSync holding the buffers
+    /// \param[in] _index Index of the buffer acquired by this thread
+    private: void CopyToBuffer(RenderSync *_renderSync, const int _index);
+
     /// \brief Signal to indicate that a frame has been rendered and ready
-    /// to be displayed
+    /// to be displayed, when the threads are serialized
     /// \param[in] _id GLuid of the opengl texture
     /// \param[in] _size Size of the texture
     signals: void TextureReady(uint _id, const QSize &_size);
 
+    /// \brief Signal to indicate that a frame has been copied into a texture
+    /// buffer and published, in buffered mode. Qt takes the buffer from the
+    /// RenderSync on its next frame, since a newer frame may replace it.
+    signals: void FramePublished();
+
     /// \brief Set a callback to be called in case there are errors.
     /// \param[in] _cb Error callback
     public: void SetErrorCb(std::function<void(const QString &)> _cb);
@@ -292,6 +310,16 @@ namespace plugins
 
     /// \brief Ign-rendering renderer
     public: IgnRenderer ignRenderer;
+
+    /// \brief RenderSync whose texture buffers are freed on shutdown, null
+    /// if it isn't buffered
+    public: RenderSync *renderSync = nullptr;
+
+    /// \brief Framebuffer to read the render texture from, in buffered mode
+    public: GLuint readFramebuffer = 0;
+
+    /// \brief Framebuffer to copy into the texture buffers
+    public: GLuint drawFramebuffer = 0;
   };
 
   /// \brief A QQUickItem that manages the render window
@@ -356,6 +384,11 @@ namespace plugins
     /// \param[in] _view_controller The camera view controller type to set
     public: void SetCameraViewController(const std::string &_view_controller);
 
+    /// \brief Set the number of textures the scene is shown from
+    /// \param[in] _buffers Number of textures, from 1 to 3. With 1, Qt and
+    /// the render thread are serialized.
+    public: void SetTextureBuffers(unsigned int _buffers);
+
     /// \brief Slot called when thread is ready to be started
     public Q_SLOTS: void Ready();
 
@@ -438,6 +471,11 @@ namespace plugins
     /// update
     signals: void PendingNewTexture();
 
+    /// \brief Show a new render texture
+    /// \param[in] _id OpenGL texture id
+    /// \param[in] _size Texture size
+    private: void ShowTexture(uint _id, const QSize &_size);
+
     /// \brief OpenGL texture id
     public: uint id = 0;
 
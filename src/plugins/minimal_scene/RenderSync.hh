@@ -0,0 +1,324 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_MINIMALSCENE_RENDERSYNC_HH_
+#define GZ_GUI_PLUGINS_MINIMALSCENE_RENDERSYNC_HH_
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include <QOpenGLExtraFunctions>
+#include <QSize>
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  /// \brief Qt and Ogre rendering is happening in different threads
+  /// The original sample 'textureinthread' from Qt used a double-buffer
+  /// scheme so that the worker (Ogre) thread write to FBO A, while
+  /// Qt is displaying FBO B.
+  ///
+  /// However Qt's implementation doesn't handle all the edge cases
+  /// (like resizing a window), and also it increases our VRAM
+  /// consumption in multiple ways (since we have to double other
+  /// resources as well or re-architect certain parts of the code
+  /// to avoid it)
+  ///
+  /// Thus by default we just serialize both threads so that when Qt reaches
+  /// drawing preparation, it halts and Ogre worker thread starts rendering,
+  /// then resumes when Ogre is done.
+  ///
+  /// Users with VRAM to spare can opt into a buffered mode instead, see
+  /// textureBuffers. The camera's render texture is never shown by Qt: once
+  /// a frame is rendered, the worker thread copies it into one of a few
+  /// textures, and Qt shows the latest copy. While Qt draws texture N, the
+  /// worker renders and copies into texture N+1, so neither thread waits for
+  /// the other. The copies are ordered with GL fences across the two
+  /// contexts. Resizing only rebuilds the camera's render texture and the
+  /// textures Qt isn't showing, so it is safe at any time.
+  ///
+  /// This code is admitedly more complicated than it should be
+  /// because Qt's synchronization using signals and slots causes
+  /// deadlocks when other means of synchronization are introduced.
+  /// The whole threaded loop should be rewritten.
+  ///
+  /// All RenderSync does is conceptually:
+  ///
+  /// \code
+  ///   TextureNode::PrepareNode()
+  ///   {
+  ///     renderSync.WaitForWorkerThread(); // Qt thread
+  ///       // WaitForQtThreadAndBlock();
+  ///       // Now worker thread begins executing what's between
+  ///       // ReleaseQtThreadFromBlock();
+  ///     continue with qt code...
+  ///   }
+  /// \endcode
+  ///
+  ///
+  /// For more info see
+  /// https://github.com/gazebosim/gz-rendering/issues/304
+  class RenderSync
+  {
+    /// \brief Cond. variable to synchronize rendering on specific events
+    /// (e.g. texture resize) or for debugging (e.g. keep
+    /// all API calls sequential)
+    public: std::mutex mutex;
+
+    /// \brief Cond. variable to synchronize rendering on specific events
+    /// (e.g. texture resize) or for debugging (e.g. keep
+    /// all API calls sequential)
+    public: std::condition_variable cv;
+
+    public: enum class RenderStallState
+            {
+              /// Qt is stuck inside WaitForWorkerThread
+              /// Worker thread can proceed
+              WorkerCanProceed,
+              /// Qt is stuck inside WaitForWorkerThread
+              /// Worker thread is between WaitForQtThreadAndBlock
+              /// and ReleaseQtThreadFromBlock
+              WorkerIsProceeding,
+              /// Worker is stuck inside WaitForQtThreadAndBlock
+              /// Qt can proceed
+              QtCanProceed,
+              /// Do not block
+              ShuttingDown,
+            };
+
+    /// \brief See TextureNode::RenderSync::RenderStallState
+    public: RenderStallState renderStallState =
+        RenderStallState::QtCanProceed /*GUARDED_BY(sharedRenderMutex)*/;
+
+    /// \brief Must be called from worker thread when we want to block
+    /// \param[in] lock Acquired lock. Must be based on this->mutex
+    public: void WaitForQtThreadAndBlock(std::unique_lock<std::mutex> &_lock)
+    {
+      this->cv.wait(_lock, [this]
+      { return this->renderStallState == RenderStallState::WorkerCanProceed ||
+               this->renderStallState == RenderStallState::ShuttingDown; });
+
+      // Once shutting down, neither thread blocks anymore
+      if (this->renderStallState != RenderStallState::ShuttingDown)
+        this->renderStallState = RenderStallState::WorkerIsProceeding;
+    }
+
+    /// \brief Must be called from worker thread when we are done
+    /// \param[in] lock Acquired lock. Must be based on this->mutex
+    public: void ReleaseQtThreadFromBlock(std::unique_lock<std::mutex> &_lock)
+    {
+      if (this->renderStallState != RenderStallState::ShuttingDown)
+        this->renderStallState = RenderStallState::QtCanProceed;
+      _lock.unlock();
+      this->cv.notify_one();
+    }
+
+    /// \brief Must be called from Qt thread periodically
+    public: void WaitForWorkerThread()
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+
+      // Wait until we're clear to go
+      this->cv.wait( lock, [this]
+      {
+        return this->renderStallState == RenderStallState::QtCanProceed ||
+               this->renderStallState == RenderStallState::ShuttingDown;
+      } );
+      if (this->renderStallState == RenderStallState::ShuttingDown)
+        return;
+
+      // Worker thread asked us to wait!
+      this->renderStallState = RenderStallState::WorkerCanProceed;
+
+      lock.unlock();
+      // Wake up worker thread
+      this->cv.notify_one();
+      lock.lock();
+
+      // Wait until we're clear to go
+      this->cv.wait( lock, [this]
+      {
+        return this->renderStallState == RenderStallState::QtCanProceed ||
+               this->renderStallState == RenderStallState::ShuttingDown;
+      } );
+    }
+
+    /// \brief Must be called from GUI thread when shutting down
+    public: void Shutdown()
+    {
+      {
+        std::unique_lock<std::mutex> lock(this->mutex);
+
+        this->renderStallState = RenderStallState::ShuttingDown;
+
+        lock.unlock();
+        // Both threads may be waiting
+        this->cv.notify_all();
+      }
+    }
+
+    /// \brief Texture shown by Qt in buffered mode
+    public: struct TextureBuffer
+    {
+      /// \brief OpenGL texture id, 0 until the worker thread creates it
+      GLuint id{0u};
+
+      /// \brief Texture size
+      QSize size;
+
+      /// \brief Fence signaled once the worker thread's copy is done
+      GLsync copied{nullptr};
+
+      /// \brief Fence signaled once Qt is done drawing the texture
+      GLsync released{nullptr};
+    };
+
+    /// \brief Check whether the threads are buffered instead of serialized
+    /// \return True if there are several texture buffers
+    public: bool Buffered() const
+    {
+      return this->textureBuffers > 1u;
+    }
+
+    /// \brief Must be called from worker thread before rendering in buffered
+    /// mode. Also clears the render request, see RequestRender.
+    /// \return Index of a buffer which Qt isn't using, to copy the frame
+    /// into, or -1 if there is none.
+    public: int AcquireBuffer()
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->renderRequested = false;
+      if (this->renderStallState == RenderStallState::ShuttingDown)
+        return -1;
+
+      for (int i = 0; i < static_cast<int>(this->buffers.size()); ++i)
+      {
+        if (i != this->pending && i != this->displayed)
+        {
+          this->copying = i;
+          return i;
+        }
+      }
+      return -1;
+    }
+
+    /// \brief Must be called from worker thread once the frame is copied
+    /// into the acquired buffer. Replaces the buffer which Qt didn't take
+    /// yet.
+    /// \return True if the worker thread should render the next frame right
+    /// away, which is the case with three buffers when Qt took the previous
+    /// frame already.
+    public: bool PublishBuffer()
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      const int previous = this->pending;
+      this->pending = this->copying;
+      this->copying = -1;
+
+      // Render ahead at most one frame which Qt didn't take
+      if (this->textureBuffers < 3u || previous >= 0 || this->renderRequested)
+        return false;
+
+      this->renderRequested = true;
+      return true;
+    }
+
+    /// \brief Must be called from Qt thread before drawing in buffered mode.
+    /// Releases the buffer shown until now.
+    /// \param[in] _functions OpenGL functions of Qt's context, such as
+    /// QOpenGLExtraFunctions
+    /// \param[out] _id Texture id of the latest published buffer
+    /// \param[out] _size Texture size
+    /// \return False if no buffer was published since the last call
+    public: template <typename Functions>
+    bool TakeBuffer(Functions *_functions, GLuint &_id, QSize &_size)
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      if (this->pending < 0)
+        return false;
+
+      // The worker thread waits for Qt's draw calls before copying into the
+      // released buffer again
+      if (this->displayed >= 0)
+      {
+        auto &released = this->buffers[this->displayed];
+        if (released.released)
+          _functions->glDeleteSync(released.released);
+        released.released =
+            _functions->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+      }
+
+      this->displayed = this->pending;
+      this->pending = -1;
+
+      auto &buffer = this->buffers[this->displayed];
+      if (buffer.copied)
+      {
+        _functions->glWaitSync(buffer.copied, 0, GL_TIMEOUT_IGNORED);
+        _functions->glDeleteSync(buffer.copied);
+        buffer.copied = nullptr;
+      }
+      _id = buffer.id;
+      _size = buffer.size;
+      return true;
+    }
+
+    /// \brief Ask for the worker thread to render, in buffered mode
+    /// \return True if the caller should trigger the render, false if it is
+    /// already requested
+    public: bool RequestRender()
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      if (this->renderRequested ||
+          this->renderStallState == RenderStallState::ShuttingDown)
+      {
+        return false;
+      }
+      this->renderRequested = true;
+      return true;
+    }
+
+    /// \brief Number of textures shown by Qt. With one, both threads are
+    /// serialized. With two, the worker thread renders the next frame while
+    /// Qt draws the last one. With three, it can also start rendering before
+    /// Qt takes the last one.
+    public: unsigned int textureBuffers{1u};
+
+    /// \brief Texture buffers /*GUARDED_BY(mutex)*/
+    public: std::vector<TextureBuffer> buffers;
+
+    /// \brief Buffer the worker thread copies into, -1 if none
+    public: int copying{-1};
+
+    /// \brief Buffer waiting for Qt, -1 if none
+    public: int pending{-1};
+
+    /// \brief Buffer shown by Qt, -1 if none
+    public: int displayed{-1};
+
+    /// \brief True if a render was requested and didn't start yet
+    public: bool renderRequested{false};
+  };
+}
+}
+}
+
+#endif
@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include "gz/gui/config.hh"
+
+#include "RenderSync.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+/// \brief Stands in for Qt's OpenGL functions, counting fences.
+struct FakeFunctions
+{
+  GLsync glFenceSync(GLenum, GLbitfield)
+  {
+    return reinterpret_cast<GLsync>(static_cast<std::uintptr_t>(++fences));
+  }
+
+  void glDeleteSync(GLsync)
+  {
+    ++deleted;
+  }
+
+  void glWaitSync(GLsync, GLbitfield, GLuint64)
+  {
+    ++waited;
+  }
+
+  int fences{0};
+  int deleted{0};
+  int waited{0};
+};
+
+/////////////////////////////////////////////////
+/// \brief Set up a RenderSync with numbered texture buffers.
+void SetBuffers(RenderSync &_sync, const unsigned int _count)
+{
+  _sync.textureBuffers = _count;
+  _sync.buffers.resize(_count);
+  for (unsigned int i = 0; i < _count; ++i)
+    _sync.buffers[i].id = 10u + i;
+}
+
+/////////////////////////////////////////////////
+TEST(RenderSyncTest, TwoBuffers)
+{
+  RenderSync sync;
+  SetBuffers(sync, 2u);
+  EXPECT_TRUE(sync.Buffered());
+
+  FakeFunctions functions;
+  GLuint id{0u};
+  QSize size;
+  EXPECT_FALSE(sync.TakeBuffer(&functions, id, size));
+
+  // The worker never renders ahead with two buffers
+  EXPECT_EQ(0, sync.AcquireBuffer());
+  EXPECT_FALSE(sync.PublishBuffer());
+
+  // A frame which Qt didn't take is replaced by the next one
+  EXPECT_EQ(1, sync.AcquireBuffer());
+  sync.buffers[1].copied = functions.glFenceSync(0, 0);
+  EXPECT_FALSE(sync.PublishBuffer());
+  EXPECT_TRUE(sync.TakeBuffer(&functions, id, size));
+  EXPECT_EQ(11u, id);
+  EXPECT_EQ(1, functions.waited);
+  EXPECT_EQ(nullptr, sync.buffers[1].copied);
+  EXPECT_FALSE(sync.TakeBuffer(&functions, id, size));
+
+  // Both buffers are in use until Qt takes the pending one
+  EXPECT_EQ(0, sync.AcquireBuffer());
+  EXPECT_FALSE(sync.PublishBuffer());
+  EXPECT_EQ(-1, sync.AcquireBuffer());
+
+  // Taking it releases the one shown until now, behind a fence
+  EXPECT_TRUE(sync.TakeBuffer(&functions, id, size));
+  EXPECT_EQ(10u, id);
+  EXPECT_NE(nullptr, sync.buffers[1].released);
+  EXPECT_EQ(1, sync.AcquireBuffer());
+}
+
+/////////////////////////////////////////////////
+TEST(RenderSyncTest, ThreeBuffers)
+{
+  RenderSync sync;
+  SetBuffers(sync, 3u);
+  FakeFunctions functions;
+  GLuint id{0u};
+  QSize size;
+
+  // Qt took the last frame, so the worker renders the next one right away,
+  // and Qt doesn't need to request it
+  EXPECT_EQ(0, sync.AcquireBuffer());
+  EXPECT_TRUE(sync.PublishBuffer());
+  EXPECT_FALSE(sync.RequestRender());
+
+  // At most one frame is rendered ahead of Qt
+  EXPECT_EQ(1, sync.AcquireBuffer());
+  EXPECT_FALSE(sync.PublishBuffer());
+  EXPECT_TRUE(sync.RequestRender());
+
+  // Qt shows a buffer and another one waits for it, which leaves one
+  EXPECT_TRUE(sync.TakeBuffer(&functions, id, size));
+  EXPECT_EQ(11u, id);
+  EXPECT_EQ(0, sync.AcquireBuffer());
+  EXPECT_TRUE(sync.PublishBuffer());
+  EXPECT_EQ(2, sync.AcquireBuffer());
+  EXPECT_FALSE(sync.PublishBuffer());
+  EXPECT_EQ(0, sync.AcquireBuffer());
+  EXPECT_FALSE(sync.PublishBuffer());
+
+  // The released buffer is reused once the fence is set
+  EXPECT_TRUE(sync.TakeBuffer(&functions, id, size));
+  EXPECT_EQ(10u, id);
+  EXPECT_NE(nullptr, sync.buffers[1].released);
+  EXPECT_EQ(1, sync.AcquireBuffer());
+}
+
+/////////////////////////////////////////////////
+TEST(RenderSyncTest, Shutdown)
+{
+  RenderSync sync;
+  SetBuffers(sync, 3u);
+
+  // Qt waits for a worker which doesn't render anymore
+  std::thread qt([&sync]
+  {
+    sync.WaitForWorkerThread();
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  sync.Shutdown();
+  qt.join();
+
+  // No more buffers or renders are handed out
+  EXPECT_EQ(-1, sync.AcquireBuffer());
+  EXPECT_FALSE(sync.RequestRender());
+
+  // Neither thread blocks anymore
+  std::unique_lock<std::mutex> lock(sync.mutex);
+  sync.WaitForQtThreadAndBlock(lock);
+  sync.ReleaseQtThreadFromBlock(lock);
+  sync.WaitForWorkerThread();
+  EXPECT_EQ(RenderSync::RenderStallState::ShuttingDown,
+      sync.renderStallState);
+}
+
+/////////////////////////////////////////////////
+TEST(RenderSyncTest, Serialized)
+{
+  RenderSync sync;
+  EXPECT_FALSE(sync.Buffered());
+
+  // Qt waits until the worker rendered a frame
+  bool rendered{false};
+  std::thread worker([&]
+  {
+    std::unique_lock<std::mutex> lock(sync.mutex);
+    sync.WaitForQtThreadAndBlock(lock);
+    rendered = true;
+    sync.ReleaseQtThreadFromBlock(lock);
+  });
+  sync.WaitForWorkerThread();
+  EXPECT_TRUE(rendered);
+  worker.join();
+}
@@ -18,10 +18,14 @@
 #include "Scene3D.hh"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <gz/common/Console.hh>
@@ -59,6 +63,11 @@
 #include "gz/gui/Conversions.hh"
 #include "gz/gui/GuiEvents.hh"
 #include "gz/gui/MainWindow.hh"
+#include "gz/gui/PagedScene.hh"
+
+#include "ArenaMessage.hh"
+#include "PoseVDecoder.hh"
+#include "ServiceWaiter.hh"
 
 namespace ignition
 {
@@ -84,6 +93,9 @@ namespace plugins
                          const std::string &_sceneTopic,
                          rendering::ScenePtr _scene);
 
+    /// \brief Destructor. Cancels a pending service request.
+    public: ~SceneManager();
+
     /// \brief Load the scene manager
     /// \param[in] _service Ign transport service name
     /// \param[in] _poseTopic Ign transport pose topic name
@@ -96,7 +108,17 @@ namespace plugins
                       const std::string &_sceneTopic,
                       rendering::ScenePtr _scene);
 
-    /// \brief Make the scene service request and populate the scene
+    /// \brief Set how the scene is requested from the paged scene service
+    /// \param[in] _pageSize Maximum number of models per page
+    /// \param[in] _timeout Timeout of each page request in milliseconds
+    public: void SetPaging(const unsigned int _pageSize,
+        const unsigned int _timeout);
+
+    /// \brief Make the scene service request and populate the scene. Waits
+    /// for the service in the background, so this returns right away. A
+    /// previous request is cancelled. Topics are subscribed first, and the
+    /// scene and deletion msgs received meanwhile are held back until the
+    /// scene is queued.
     public: void Request();
 
     /// \brief Update the scene based on pose msgs received
@@ -106,6 +128,15 @@ namespace plugins
     /// \param[in] _msg Pose vector msg
     private: void OnPoseVMsg(const msgs::Pose_V &_msg);
 
+    /// \brief Raw callback function for the pose topic. Decodes the
+    /// serialized msgs::Pose_V without constructing messages, and falls
+    /// back to OnPoseVMsg for payloads the decoder doesn't handle.
+    /// \param[in] _data Serialized pose vector msg
+    /// \param[in] _size Size of the serialized msg
+    /// \param[in] _info Message information
+    private: void OnPoseVRaw(const char *_data, const std::size_t _size,
+        const transport::MessageInfo &_info);
+
     /// \brief Load the scene from a scene msg
     /// \param[in] _msg Scene msg
     private: void LoadScene(const msgs::Scene &_msg);
@@ -114,13 +145,40 @@ namespace plugins
     /// \param[in] _msg Deletion message
     private: void OnDeletionMsg(const msgs::UInt32_V &_msg);
 
-    /// \brief Load the scene from a scene msg
-    /// \param[in] _msg Scene msg
-    private: void OnSceneSrvMsg(const msgs::Scene &_msg, const bool result);
-
-    /// \brief Called when there's an entity is added to the scene
-    /// \param[in] _msg Scene msg
-    private: void OnSceneMsg(const msgs::Scene &_msg);
+    /// \brief Request the whole scene from the scene service into its own
+    /// arena
+    /// \param[in] _waiter Waiter of this request, which cancels it
+    /// \return True if the scene was received
+    private: bool RequestScene(const ServiceWaiter &_waiter);
+
+    /// \brief Wait for the scene service and request the scene, in pages
+    /// if the paged service is advertised. Runs on a request thread.
+    /// \param[in] _waiter Waiter of this request, cancelled by the next
+    /// request or on destruction
+    private: void RunRequest(ServiceWaiter &_waiter);
+
+    /// \brief Join the request threads which are done.
+    private: void JoinFinishedRequests();
+
+    /// \brief Queue a scene, or page of a scene, received from the scene
+    /// service
+    /// \param[in] _msg Scene msg, which isn't copied
+    private: void OnSceneSrvMsg(const std::shared_ptr<const msgs::Scene> &_msg);
+
+    /// \brief Subscribe to the pose, deletion and scene topics, once
+    private: void Subscribe();
+
+    /// \brief Queue the scene and deletion msgs held back while the scene
+    /// was requested, and stop holding them back
+    private: void ReleaseHeldMsgs();
+
+    /// \brief Called when there's an entity is added to the scene. The
+    /// message is parsed into its own arena and queued without copies.
+    /// \param[in] _data Serialized scene msg
+    /// \param[in] _size Size of the data in bytes
+    /// \param[in] _info Message info
+    private: void OnSceneRaw(const char *_data, const std::size_t _size,
+        const transport::MessageInfo &_info);
 
     /// \brief Load the model from a model msg
     /// \param[in] _msg Model msg
@@ -181,6 +239,12 @@ namespace plugins
     /// \brief Map of entity id to pose
     private: std::map<unsigned int, math::Pose3d> poses;
 
+    /// \brief Poses decoded by the raw pose callback, reused across msgs
+    private: PoseFrame rawPoseFrame;
+
+    /// \brief Mutex to protect rawPoseFrame
+    private: std::mutex rawPoseMutex;
+
     /// \brief Map of entity id to initial local poses
     /// This is currently used to handle the normal vector in plane visuals. In
     /// general, this can be used to store any local transforms between the
@@ -197,11 +261,51 @@ namespace plugins
     private: std::vector<unsigned int> toDeleteEntities;
 
     /// \brief Keeps the a list of unprocessed scene messages
-    private: std::vector<msgs::Scene> sceneMsgs;
+    private: std::vector<std::shared_ptr<const msgs::Scene>> sceneMsgs;
+
+    /// \brief True while the scene is requested, so that scene and
+    /// deletion msgs are applied after the scene they update. Protected by
+    /// mutex.
+    private: bool holdMsgs{true};
+
+    /// \brief Scene msgs received while the scene was requested
+    private: std::vector<std::shared_ptr<const msgs::Scene>> heldSceneMsgs;
+
+    /// \brief Deletions received while the scene was requested
+    private: std::vector<unsigned int> heldDeletions;
+
+    /// \brief Makes sure topics are only subscribed once
+    private: std::once_flag subscribeOnce;
+
+    /// \brief Maximum number of models per page requested from the paged
+    /// scene service
+    private: unsigned int scenePageSize{1000u};
+
+    /// \brief Timeout of each page request in milliseconds
+    private: unsigned int scenePageTimeout{5000u};
 
     /// \brief Transport node for making service request and subscribing to
     /// pose topic
     private: gz::transport::Node node;
+
+    /// \brief Waits for the scene service for the latest request,
+    /// cancelled by the next request or on destruction
+    private: std::shared_ptr<ServiceWaiter> serviceWaiter;
+
+    /// \brief Thread of a scene request
+    private: struct RequestThread
+    {
+      /// \brief Thread running RunRequest
+      std::thread thread;
+
+      /// \brief Set once RunRequest returned
+      std::shared_ptr<std::atomic<bool>> done;
+    };
+
+    /// \brief Threads of the latest request, and of cancelled requests
+    /// which may still be finishing. They're only joined once done, or on
+    /// destruction, so that the render thread doesn't wait for them.
+    private: std::vector<RequestThread> requestThreads;
   };
 
   /// \brief Private data class for IgnRenderer
@@ -286,6 +390,15 @@ SceneManager::SceneManager(const std::string &_service,
   this->Load(_service, _poseTopic, _deletionTopic, _sceneTopic, _scene);
 }
 
+/////////////////////////////////////////////////
+SceneManager::~SceneManager()
+{
+  if (this->serviceWaiter)
+    this->serviceWaiter->Cancel();
+  for (auto &request : this->requestThreads)
+    request.thread.join();
+}
+
 /////////////////////////////////////////////////
 void SceneManager::Load(const std::string &_service,
                         const std::string &_poseTopic,
@@ -300,27 +413,106 @@ void SceneManager::Load(const std::string &_service,
   this->scene = _scene;
 }
 
+/////////////////////////////////////////////////
+void SceneManager::SetPaging(const unsigned int _pageSize,
+    const unsigned int _timeout)
+{
+  this->scenePageSize = _pageSize;
+  this->scenePageTimeout = _timeout;
+}
+
 /////////////////////////////////////////////////
 void SceneManager::Request()
 {
-  // wait for the service to be advertized
-  std::vector<transport::ServicePublisher> publishers;
-  const std::chrono::duration<double> sleepDuration{1.0};
-  const std::size_t tries = 30;
-  for (std::size_t i = 0; i < tries; ++i)
+  // This runs on the render thread, so the previous request is cancelled
+  // without waiting for it to return
+  if (this->serviceWaiter)
+    this->serviceWaiter->Cancel();
+  this->JoinFinishedRequests();
+
+  auto waiter = std::make_shared<ServiceWaiter>();
+  auto done = std::make_shared<std::atomic<bool>>(false);
+  this->serviceWaiter = waiter;
+  this->requestThreads.push_back({std::thread([this, waiter, done]
   {
-    this->node.ServiceInfo(this->service, publishers);
-    if (publishers.size() > 0)
-      break;
-    std::this_thread::sleep_for(sleepDuration);
-    igndbg << "Waiting for service " << this->service << "\n";
+    this->RunRequest(*waiter);
+    done->store(true);
+  }), done});
+}
+
+/////////////////////////////////////////////////
+void SceneManager::JoinFinishedRequests()
+{
+  for (auto it = this->requestThreads.begin();
+      it != this->requestThreads.end();)
+  {
+    if (!it->done->load())
+    {
+      ++it;
+      continue;
+    }
+    it->thread.join();
+    it = this->requestThreads.erase(it);
+  }
+}
+
+/////////////////////////////////////////////////
+void SceneManager::RunRequest(ServiceWaiter &_waiter)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->holdMsgs = true;
   }
+  std::call_once(this->subscribeOnce, [this] { this->Subscribe(); });
 
-  if (publishers.empty() ||
-      !this->node.Request(this->service, &SceneManager::OnSceneSrvMsg, this))
+  // wait for the service to be advertized, preferring the paged one
+  igndbg << "Waiting for service " << this->service << std::endl;
+  const std::string pagedService = PagedScene::Service(this->service);
+  std::vector<transport::ServicePublisher> publishers;
+  bool paged{false};
+  const bool found = _waiter.Wait([&]
+  {
+    paged = this->node.ServiceInfo(pagedService, publishers) &&
+        !publishers.empty();
+    return paged || (this->node.ServiceInfo(this->service, publishers) &&
+        !publishers.empty());
+  });
+
+  if (_waiter.Cancelled())
+    return;
+
+  if (found && paged)
   {
-    ignerr << "Error making service request to " << this->service << std::endl;
+    // Pages are loaded as they arrive, while the next ones are requested
+    const bool complete = PagedScene::Fetch(this->node, pagedService,
+        this->scenePageSize, this->scenePageTimeout,
+        [&](msgs::Scene &&_page, bool)
+        {
+          this->OnSceneSrvMsg(
+              std::make_shared<const msgs::Scene>(std::move(_page)));
+          return !_waiter.Cancelled();
+        },
+        [&]
+        {
+          return _waiter.Cancelled();
+        });
+
+    if (!complete && !_waiter.Cancelled())
+    {
+      ignerr << "Error requesting scene pages from " << pagedService
+             << std::endl;
+    }
+  }
+  else if (!found || !this->RequestScene(_waiter))
+  {
+    ignerr << "Error making service request to " << this->service
+           << std::endl;
   }
+
+  // Updates are applied even if the scene couldn't be received. A newer
+  // request releases them once it's done instead.
+  if (!_waiter.Cancelled())
+    this->ReleaseHeldMsgs();
 }
 
 /////////////////////////////////////////////////
@@ -342,12 +534,53 @@ void SceneManager::OnPoseVMsg(const msgs::Pose_V &_msg)
   }
 }
 
+/////////////////////////////////////////////////
+void SceneManager::OnPoseVRaw(const char *_data, const std::size_t _size,
+    const transport::MessageInfo &/*_info*/)
+{
+  std::lock_guard<std::mutex> rawLock(this->rawPoseMutex);
+  if (!PoseVDecoder::Decode(_data, _size, this->rawPoseFrame))
+  {
+    // Fall back to protobuf for payloads with fields the decoder doesn't
+    // know
+    msgs::Pose_V msg;
+    if (!msg.ParseFromArray(_data, static_cast<int>(_size)))
+    {
+      ignerr << "Failed to parse pose message on [" << this->poseTopic
+             << "]" << std::endl;
+      return;
+    }
+    this->OnPoseVMsg(msg);
+    return;
+  }
+
+  const auto &frame = this->rawPoseFrame;
+  std::lock_guard<std::mutex> lock(this->mutex);
+  for (std::size_t i = 0; i < frame.Size(); ++i)
+  {
+    const double *p = &frame.positions[i * 3];
+    const double *q = &frame.orientations[i * 4];
+    math::Pose3d pose(p[0], p[1], p[2], q[0], q[1], q[2], q[3]);
+
+    // apply additional local poses if available
+    const auto it = this->localPoses.find(frame.ids[i]);
+    if (it != this->localPoses.end())
+    {
+      pose = pose * it->second;
+    }
+
+    this->poses[frame.ids[i]] = pose;
+  }
+}
+
 /////////////////////////////////////////////////
 void SceneManager::OnDeletionMsg(const msgs::UInt32_V &_msg)
 {
   std::lock_guard<std::mutex> lock(this->mutex);
+  auto &deletions =
+      this->holdMsgs ? this->heldDeletions : this->toDeleteEntities;
   std::copy(_msg.data().begin(), _msg.data().end(),
-            std::back_inserter(this->toDeleteEntities));
+            std::back_inserter(deletions));
 }
 
 /////////////////////////////////////////////////
@@ -358,7 +591,7 @@ void SceneManager::Update()
 
   for (const auto &msg : this->sceneMsgs)
   {
-    this->LoadScene(msg);
+    this->LoadScene(*msg);
   }
   this->sceneMsgs.clear();
 
@@ -415,30 +648,75 @@ void SceneManager::Update()
 
 
 /////////////////////////////////////////////////
-void SceneManager::OnSceneMsg(const msgs::Scene &_msg)
+void SceneManager::OnSceneRaw(const char *_data, const std::size_t _size,
+    const transport::MessageInfo &/*_info*/)
 {
+  auto msg = ArenaMessage::Parse<msgs::Scene>(_data, _size);
+  if (nullptr == msg)
+  {
+    ignerr << "Dropping malformed scene message of [" << _size
+           << "] bytes on [" << this->sceneTopic << "]" << std::endl;
+    return;
+  }
+
   std::lock_guard<std::mutex> lock(this->mutex);
-  this->sceneMsgs.push_back(_msg);
+  if (this->holdMsgs)
+    this->heldSceneMsgs.push_back(std::move(msg));
+  else
+    this->sceneMsgs.push_back(std::move(msg));
 }
 
 /////////////////////////////////////////////////
-void SceneManager::OnSceneSrvMsg(const msgs::Scene &_msg, const bool result)
+bool SceneManager::RequestScene(const ServiceWaiter &_waiter)
 {
-  if (!result)
+  // The reply is copied straight into an arena. The request is made
+  // asynchronously, so that a newer request or shutdown cancels it right
+  // away instead of waiting for the reply or the timeout.
+  const unsigned int timeout{30000u};
+  auto msg = ArenaMessage::Create<msgs::Scene>();
+  if (!PagedScene::FetchWhole(this->node, this->service, timeout, msg,
+      [&_waiter] { return _waiter.Cancelled(); }))
   {
-    ignerr << "Error making service request to " << this->service
-           << std::endl;
-    return;
+    return false;
   }
 
-  {
-    std::lock_guard<std::mutex> lock(this->mutex);
-    this->sceneMsgs.push_back(_msg);
-  }
+  this->OnSceneSrvMsg(msg);
+  return true;
+}
+
+/////////////////////////////////////////////////
+void SceneManager::OnSceneSrvMsg(
+    const std::shared_ptr<const msgs::Scene> &_msg)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->sceneMsgs.push_back(_msg);
+}
+
+/////////////////////////////////////////////////
+void SceneManager::ReleaseHeldMsgs()
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->holdMsgs = false;
+  this->sceneMsgs.insert(this->sceneMsgs.end(),
+      this->heldSceneMsgs.begin(), this->heldSceneMsgs.end());
+  this->toDeleteEntities.insert(this->toDeleteEntities.end(),
+      this->heldDeletions.begin(), this->heldDeletions.end());
+  this->heldSceneMsgs.clear();
+  this->heldDeletions.clear();
+}
 
+/////////////////////////////////////////////////
+void SceneManager::Subscribe()
+{
   if (!this->poseTopic.empty())
   {
-    if (!this->node.Subscribe(this->poseTopic, &SceneManager::OnPoseVMsg, this))
+    auto poseCb = [this](const char *_data, const std::size_t _size,
+        const transport::MessageInfo &_info)
+    {
+      this->OnPoseVRaw(_data, _size, _info);
+    };
+    if (!this->node.SubscribeRaw(this->poseTopic, poseCb,
+          msgs::Pose_V().GetTypeName()))
     {
       ignerr << "Error subscribing to pose topic: " << this->poseTopic
         << std::endl;
@@ -469,8 +747,13 @@ void SceneManager::OnSceneSrvMsg(const msgs::Scene &_msg, const bool result)
 
   if (!this->sceneTopic.empty())
   {
-    if (!this->node.Subscribe(
-          this->sceneTopic, &SceneManager::OnSceneMsg, this))
+    auto sceneCb = [this](const char *_data, const std::size_t _size,
+        const transport::MessageInfo &_info)
+    {
+      this->OnSceneRaw(_data, _size, _info);
+    };
+    if (!this->node.SubscribeRaw(this->sceneTopic, sceneCb,
+          msgs::Scene().GetTypeName()))
     {
       ignerr << "Error subscribing to scene topic: " << this->sceneTopic
              << std::endl;
@@ -1181,6 +1464,8 @@ std::string IgnRenderer::Initialize()
     this->dataPtr->sceneManager.Load(this->sceneService, this->poseTopic,
                                      this->deletionTopic, this->sceneTopic,
                                      scene);
+    this->dataPtr->sceneManager.SetPaging(this->scenePageSize,
+                                          this->scenePageTimeout);
     this->dataPtr->sceneManager.Request();
   }
 
@@ -1571,6 +1856,14 @@ void RenderWindowItem::SetSceneTopic(const std::string &_topic)
   this->dataPtr->renderThread->ignRenderer.sceneTopic = _topic;
 }
 
+/////////////////////////////////////////////////
+void RenderWindowItem::SetScenePaging(const unsigned int _pageSize,
+    const unsigned int _timeout)
+{
+  this->dataPtr->renderThread->ignRenderer.scenePageSize = _pageSize;
+  this->dataPtr->renderThread->ignRenderer.scenePageTimeout = _timeout;
+}
+
 /////////////////////////////////////////////////
 Scene3D::Scene3D()
   : Plugin(), dataPtr(new Scene3DPrivate)
@@ -1680,6 +1973,25 @@ void Scene3D::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
       std::string topic = elem->GetText();
       renderWindow->SetSceneTopic(topic);
     }
+
+    unsigned int pageSize{1000u};
+    elem = _pluginElem->FirstChildElement("scene_page_size");
+    if (nullptr != elem && nullptr != elem->GetText() &&
+        elem->QueryUnsignedText(&pageSize) != tinyxml2::XML_SUCCESS)
+    {
+      ignerr << "Failed to parse <scene_page_size> value: "
+             << elem->GetText() << std::endl;
+    }
+
+    unsigned int pageTimeout{5000u};
+    elem = _pluginElem->FirstChildElement("scene_page_timeout_ms");
+    if (nullptr != elem && nullptr != elem->GetText() &&
+        elem->QueryUnsignedText(&pageTimeout) != tinyxml2::XML_SUCCESS)
+    {
+      ignerr << "Failed to parse <scene_page_timeout_ms> value: "
+             << elem->GetText() << std::endl;
+    }
+    renderWindow->SetScenePaging(pageSize, pageTimeout);
   }
 }
 
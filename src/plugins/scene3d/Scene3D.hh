@@ -63,6 +63,12 @@ namespace plugins
   ///                          (0.3, 0.3, 0.3, 1.0)
   /// * \<camera_pose\> : Optional starting pose for the camera, defaults to
   ///                     (0, 0, 5, 0, 0, 0)
+  /// * \<scene_page_size\> : Optional maximum number of models per page
+  ///                         requested from the paged scene service, see
+  ///                         PagedScene.hh, defaults to 1000.
+  /// * \<scene_page_timeout_ms\> : Optional time in milliseconds to wait for
+  ///                               each page of the paged scene service,
+  ///                               defaults to 5000.
   class Scene3D : public Plugin
   {
     Q_OBJECT
@@ -231,6 +237,13 @@ namespace plugins
     /// added
     public: std::string sceneTopic;
 
+    /// \brief Maximum number of models per page requested from the paged
+    /// scene service
+    public: unsigned int scenePageSize = 1000u;
+
+    /// \brief Timeout of each page request in milliseconds
+    public: unsigned int scenePageTimeout = 5000u;
+
     /// \internal
     /// \brief Pointer to private data.
     private: std::unique_ptr<IgnRendererPrivate> dataPtr;
@@ -332,6 +345,12 @@ namespace plugins
     /// \param[in] _topic Scene topic
     public: void SetSceneTopic(const std::string &_topic);
 
+    /// \brief Set how the scene is requested from the paged scene service
+    /// \param[in] _pageSize Maximum number of models per page
+    /// \param[in] _timeout Timeout of each page request in milliseconds
+    public: void SetScenePaging(const unsigned int _pageSize,
+        const unsigned int _timeout);
+
     /// \brief Called when the mouse hovers to a new position.
     /// \param[in] _hoverPos 2D coordinates of the hovered mouse position on
     /// the render window.
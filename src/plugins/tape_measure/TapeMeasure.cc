@@ -37,6 +37,11 @@ namespace ignition::gui
 {
   class TapeMeasurePrivate
   {
+    /// \brief Send a marker message to the MarkerManager of this process,
+    /// or to the marker service if there's none.
+    /// \param[in] _msg Marker message.
+    public: void SendMarker(const gz::msgs::Marker &_msg);
+
     /// \brief Gazebo communication node.
     public: transport::Node node;
 
@@ -86,12 +91,29 @@ namespace ignition::gui
 
     /// \brief The namespace that the markers for this plugin are placed in.
     public: std::string ns = "tape_measure";
+
+    /// \brief The marker service the markers are sent to.
+    public: std::string markerTopic = "/marker";
   };
 }
 
 using namespace gz;
 using namespace gui;
 
+/////////////////////////////////////////////////
+void TapeMeasurePrivate::SendMarker(const gz::msgs::Marker &_msg)
+{
+  // Markers are updated on every hover event, so skip serialization when
+  // a MarkerManager can take them directly
+  gz::gui::events::MarkerRequest markerEvent(_msg, this->markerTopic);
+  gz::gui::App()->sendEvent(
+      gz::gui::App()->findChild<gz::gui::MainWindow *>(),
+      &markerEvent);
+
+  if (!markerEvent.isAccepted())
+    this->node.Request(this->markerTopic, _msg);
+}
+
 /////////////////////////////////////////////////
 TapeMeasure::TapeMeasure()
   : gz::gui::Plugin(),
@@ -182,7 +204,7 @@ void TapeMeasure::DeleteMarker(int _id)
   markerMsg.set_ns(this->dataPtr->ns);
   markerMsg.set_id(_id);
   markerMsg.set_action(gz::msgs::Marker::DELETE_MARKER);
-  this->dataPtr->node.Request("/marker", markerMsg);
+  this->dataPtr->SendMarker(markerMsg);
   this->dataPtr->placedMarkers.erase(_id);
 }
 
@@ -204,7 +226,7 @@ void TapeMeasure::DrawPoint(int _id,
   gz::msgs::Set(markerMsg.mutable_pose(),
     gz::math::Pose3d(_point.X(), _point.Y(), _point.Z(), 0, 0, 0));
 
-  this->dataPtr->node.Request("/marker", markerMsg);
+  this->dataPtr->SendMarker(markerMsg);
   this->dataPtr->placedMarkers.insert(_id);
 }
 
@@ -224,7 +246,7 @@ void TapeMeasure::DrawLine(int _id, gz::math::Vector3d &_startPoint,
   gz::msgs::Set(markerMsg.add_point(), _startPoint);
   gz::msgs::Set(markerMsg.add_point(), _endPoint);
 
-  this->dataPtr->node.Request("/marker", markerMsg);
+  this->dataPtr->SendMarker(markerMsg);
   this->dataPtr->placedMarkers.insert(_id);
 }
 
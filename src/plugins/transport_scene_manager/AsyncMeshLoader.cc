@@ -0,0 +1,614 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include <gz/common/ColladaLoader.hh>
+#include <gz/common/Console.hh>
+#include <gz/common/MeshManager.hh>
+#include <gz/common/OBJLoader.hh>
+#include <gz/common/STLLoader.hh>
+#include <gz/common/SubMesh.hh>
+#include <gz/common/Util.hh>
+#include <gz/math/Vector2.hh>
+#include <gz/math/Vector3.hh>
+
+#include "AsyncMeshLoader.hh"
+#include "MeshSimplifier.hh"
+
+/// \brief Private data class for AsyncMeshLoader
+class ignition::gui::plugins::AsyncMeshLoaderPrivate
+{
+  /// \brief Worker thread loop
+  public: void Work();
+
+  /// \brief Parse a mesh file, or load it from the cache
+  /// \param[in] _filename Mesh file path or URI
+  /// \return Parsed mesh, null on failure
+  public: std::shared_ptr<common::Mesh> Parse(
+      const std::string &_filename) const;
+
+  /// \brief Build the levels of detail of a parsed mesh, or load them from
+  /// the cache
+  /// \param[in] _filename Mesh file path or URI
+  public: void BuildLods(const std::string &_filename);
+
+  /// \brief Deleter of parsed meshes, which doesn't delete them once
+  /// they're handed to common::MeshManager, since it owns them from then
+  /// on
+  public: struct MeshDeleter
+  {
+    /// \brief Delete a mesh unless the mesh manager owns it
+    /// \param[in] _mesh Mesh
+    void operator()(common::Mesh *_mesh) const
+    {
+      if (!this->managed->load())
+        delete _mesh;
+    }
+
+    /// \brief Set once the mesh manager owns the mesh. The last reference
+    /// may be dropped by a worker, so it's atomic.
+    std::shared_ptr<std::atomic<bool>> managed{
+        std::make_shared<std::atomic<bool>>(false)};
+  };
+
+  /// \brief Check if a parsed mesh should get levels of detail. Must be
+  /// called with the mutex locked.
+  /// \param[in] _mesh Parsed mesh
+  /// \return True if it should
+  public: bool NeedsLods(const common::Mesh &_mesh) const;
+
+  /// \brief Cache of parsed meshes, may be null
+  public: std::shared_ptr<const SceneCache> cache;
+
+  /// \brief Protects all members below
+  public: std::mutex mutex;
+
+  /// \brief Notifies workers of new files or shutdown
+  public: std::condition_variable cv;
+
+  /// \brief Work waiting for a worker
+  public: struct Job
+  {
+    /// \brief Mesh file path or URI
+    std::string filename;
+
+    /// \brief True to build levels of detail of a parsed mesh, false to
+    /// parse the file
+    bool lods;
+  };
+
+  /// \brief Jobs waiting for a worker
+  public: std::deque<Job> queue;
+
+  /// \brief Parsed mesh and its references
+  public: struct Entry
+  {
+    /// \brief Parsed mesh, null if parsing failed
+    std::shared_ptr<common::Mesh> mesh;
+
+    /// \brief Levels of detail of the mesh, empty until they're built
+    std::vector<std::shared_ptr<common::Mesh>> lods;
+
+    /// \brief Approximate size in bytes of the mesh, unless the mesh
+    /// manager owns it, and of its levels of detail
+    std::size_t bytes{0u};
+
+    /// \brief Number of users of the mesh
+    unsigned int refs{0u};
+
+    /// \brief Position in the list of unused meshes, if it's there
+    std::list<std::string>::iterator unused;
+
+    /// \brief True if the mesh is in the list of unused meshes
+    bool isUnused{false};
+
+    /// \brief True once the mesh is owned by the mesh manager, which keeps
+    /// it until it's removed from there
+    bool managed{false};
+  };
+
+  /// \brief Hand a parsed mesh to common::MeshManager, so that other users
+  /// of the mesh manager share it instead of parsing the file again. Must
+  /// be called with the mutex locked, from the thread which uses the mesh
+  /// manager.
+  /// \param[in] _entry Entry of the mesh
+  public: void Register(Entry &_entry);
+
+  /// \brief Approximate size of a mesh
+  /// \param[in] _mesh Mesh
+  /// \return Size in bytes
+  public: static std::size_t Size(const common::Mesh &_mesh);
+
+  /// \brief Files which are done. The mesh is null if parsing failed.
+  public: std::unordered_map<std::string, Entry> done;
+
+  /// \brief Parsed meshes without references, most recently used first
+  public: std::list<std::string> unused;
+
+  /// \brief Number of unused meshes kept by Trim
+  public: std::size_t retention{64u};
+
+  /// \brief Total size of the parsed meshes in bytes
+  public: std::size_t memory{0u};
+
+  /// \brief Files which are queued or being parsed
+  public: std::unordered_set<std::string> inFlight;
+
+  /// \brief Files which finished since the last call to TakeFinished
+  public: std::vector<std::string> finished;
+
+  /// \brief Files whose levels of detail were built since the last call to
+  /// TakeFinishedLods
+  public: std::vector<std::string> finishedLods;
+
+  /// \brief Number of levels of detail to build
+  public: unsigned int lodLevels{0u};
+
+  /// \brief Fewest triangles of meshes which get levels of detail
+  public: std::size_t lodMinTriangles{0u};
+
+  /// \brief Files returned by TakeFinished since the last call to Trim,
+  /// which become unused if they weren't acquired in between
+  public: std::vector<std::string> taken;
+
+  /// \brief Set to stop the workers
+  public: bool stop{false};
+
+  /// \brief Worker threads
+  public: std::vector<std::thread> workers;
+};
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+AsyncMeshLoader::AsyncMeshLoader(unsigned int _threads,
+    std::shared_ptr<const SceneCache> _cache)
+  : dataPtr(new AsyncMeshLoaderPrivate)
+{
+  this->dataPtr->cache = std::move(_cache);
+
+  if (_threads == 0u)
+  {
+    // Leave a core for the render and GUI threads
+    const unsigned int cores = std::thread::hardware_concurrency();
+    _threads = std::clamp(cores > 1u ? cores - 1u : 1u, 1u, 4u);
+  }
+
+  for (unsigned int i = 0u; i < _threads; ++i)
+  {
+    this->dataPtr->workers.emplace_back(
+        &AsyncMeshLoaderPrivate::Work, this->dataPtr.get());
+  }
+}
+
+/////////////////////////////////////////////////
+AsyncMeshLoader::~AsyncMeshLoader()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->stop = true;
+    this->dataPtr->queue.clear();
+  }
+  this->dataPtr->cv.notify_all();
+
+  for (auto &worker : this->dataPtr->workers)
+  {
+    if (worker.joinable())
+      worker.join();
+  }
+}
+
+/////////////////////////////////////////////////
+bool AsyncMeshLoader::Request(const std::string &_filename,
+    std::shared_ptr<common::Mesh> &_mesh)
+{
+  _mesh.reset();
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    auto it = this->dataPtr->done.find(_filename);
+    if (it != this->dataPtr->done.end())
+    {
+      this->dataPtr->Register(it->second);
+      _mesh = it->second.mesh;
+      return true;
+    }
+
+    // Merge with the request that is already queued or being parsed
+    if (this->dataPtr->inFlight.count(_filename) > 0u)
+      return false;
+
+    // Meshes created in memory, by other plugins for example, only exist
+    // in the mesh manager, which keeps ownership of them. It isn't thread
+    // safe, so it's only used from the caller's thread.
+    auto meshManager = common::MeshManager::Instance();
+    if (meshManager->HasMesh(_filename))
+    {
+      auto mesh = meshManager->MeshByName(_filename);
+      if (nullptr != mesh)
+      {
+        _mesh = std::shared_ptr<common::Mesh>(
+            const_cast<common::Mesh *>(mesh), [](common::Mesh *){});
+        auto &entry = this->dataPtr->done[_filename];
+        entry.mesh = _mesh;
+        entry.managed = true;
+        this->dataPtr->taken.push_back(_filename);
+        if (this->dataPtr->NeedsLods(*mesh))
+        {
+          this->dataPtr->queue.push_back({_filename, true});
+          this->dataPtr->cv.notify_one();
+        }
+        return true;
+      }
+    }
+
+    this->dataPtr->inFlight.insert(_filename);
+
+    this->dataPtr->queue.push_back({_filename, false});
+  }
+  this->dataPtr->cv.notify_one();
+  return false;
+}
+
+/////////////////////////////////////////////////
+std::vector<std::string> AsyncMeshLoader::TakeFinished()
+{
+  std::vector<std::string> result;
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  result.swap(this->dataPtr->finished);
+  for (const auto &filename : result)
+  {
+    auto it = this->dataPtr->done.find(filename);
+    if (it != this->dataPtr->done.end())
+      this->dataPtr->Register(it->second);
+  }
+  this->dataPtr->taken.insert(this->dataPtr->taken.end(), result.begin(),
+      result.end());
+  return result;
+}
+
+/////////////////////////////////////////////////
+void AsyncMeshLoader::SetLod(const unsigned int _levels,
+    const std::size_t _minTriangles)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->lodLevels = _levels;
+  this->dataPtr->lodMinTriangles = _minTriangles;
+}
+
+/////////////////////////////////////////////////
+std::vector<std::shared_ptr<common::Mesh>> AsyncMeshLoader::Lods(
+    const std::string &_filename) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto it = this->dataPtr->done.find(_filename);
+  if (it == this->dataPtr->done.end())
+    return {};
+  return it->second.lods;
+}
+
+/////////////////////////////////////////////////
+std::vector<std::string> AsyncMeshLoader::TakeFinishedLods()
+{
+  std::vector<std::string> result;
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  result.swap(this->dataPtr->finishedLods);
+  return result;
+}
+
+/////////////////////////////////////////////////
+void AsyncMeshLoader::Acquire(const std::string &_filename)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto it = this->dataPtr->done.find(_filename);
+  if (it == this->dataPtr->done.end() || nullptr == it->second.mesh)
+    return;
+
+  auto &entry = it->second;
+  if (entry.isUnused)
+  {
+    this->dataPtr->unused.erase(entry.unused);
+    entry.isUnused = false;
+  }
+  ++entry.refs;
+}
+
+/////////////////////////////////////////////////
+void AsyncMeshLoader::Release(const std::string &_filename)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto it = this->dataPtr->done.find(_filename);
+  if (it == this->dataPtr->done.end() || it->second.refs == 0u)
+    return;
+
+  auto &entry = it->second;
+  if (--entry.refs == 0u)
+  {
+    this->dataPtr->unused.push_front(_filename);
+    entry.unused = this->dataPtr->unused.begin();
+    entry.isUnused = true;
+  }
+}
+
+/////////////////////////////////////////////////
+void AsyncMeshLoader::SetRetention(const std::size_t _count)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->retention = _count;
+}
+
+/////////////////////////////////////////////////
+void AsyncMeshLoader::Trim()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  // Failed files are kept, so that they aren't parsed and reported again
+  for (const auto &filename : this->dataPtr->taken)
+  {
+    auto it = this->dataPtr->done.find(filename);
+    if (it == this->dataPtr->done.end() || nullptr == it->second.mesh ||
+        it->second.refs > 0u || it->second.isUnused)
+    {
+      continue;
+    }
+    this->dataPtr->unused.push_front(filename);
+    it->second.unused = this->dataPtr->unused.begin();
+    it->second.isUnused = true;
+  }
+  this->dataPtr->taken.clear();
+
+  while (this->dataPtr->unused.size() > this->dataPtr->retention)
+  {
+    auto it = this->dataPtr->done.find(this->dataPtr->unused.back());
+    this->dataPtr->memory -= it->second.bytes;
+    this->dataPtr->done.erase(it);
+    this->dataPtr->unused.pop_back();
+  }
+}
+
+/////////////////////////////////////////////////
+std::size_t AsyncMeshLoader::MemoryUsage() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->memory;
+}
+
+/////////////////////////////////////////////////
+std::size_t AsyncMeshLoaderPrivate::Size(const common::Mesh &_mesh)
+{
+  std::size_t bytes{0u};
+  for (unsigned int i = 0u; i < _mesh.SubMeshCount(); ++i)
+  {
+    auto subMesh = _mesh.SubMeshByIndex(i).lock();
+    if (nullptr == subMesh)
+      continue;
+
+    bytes += (subMesh->VertexCount() + subMesh->NormalCount()) *
+        sizeof(math::Vector3d) +
+        subMesh->TexCoordCount() * sizeof(math::Vector2d) +
+        subMesh->IndexCount() * sizeof(unsigned int);
+  }
+  return bytes;
+}
+
+/////////////////////////////////////////////////
+void AsyncMeshLoaderPrivate::Work()
+{
+  while (true)
+  {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+      this->cv.wait(lock, [this]
+      {
+        return this->stop || !this->queue.empty();
+      });
+      if (this->stop)
+        return;
+
+      job = std::move(this->queue.front());
+      this->queue.pop_front();
+    }
+
+    if (job.lods)
+    {
+      this->BuildLods(job.filename);
+      continue;
+    }
+
+    auto mesh = Parse(job.filename);
+    const std::size_t bytes = mesh ? Size(*mesh) : 0u;
+
+    bool lods{false};
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->inFlight.erase(job.filename);
+      auto &entry = this->done[job.filename];
+      entry.mesh = mesh;
+      entry.bytes = bytes;
+      this->memory += bytes;
+      this->finished.push_back(job.filename);
+
+      // Levels of detail are queued after the mesh is reported, so that the
+      // full mesh can be shown meanwhile
+      lods = mesh && this->NeedsLods(*mesh);
+      if (lods)
+        this->queue.push_back({job.filename, true});
+    }
+    if (lods)
+      this->cv.notify_one();
+  }
+}
+
+/////////////////////////////////////////////////
+void AsyncMeshLoaderPrivate::Register(Entry &_entry)
+{
+  if (_entry.managed || nullptr == _entry.mesh)
+    return;
+  _entry.managed = true;
+
+  auto deleter = std::get_deleter<MeshDeleter>(_entry.mesh);
+  auto meshManager = common::MeshManager::Instance();
+  // Another plugin may have loaded the same file meanwhile, then this copy
+  // stays with the loader
+  if (nullptr == deleter || meshManager->HasMesh(_entry.mesh->Name()))
+    return;
+
+  deleter->managed->store(true);
+  meshManager->AddMesh(_entry.mesh.get());
+
+  const std::size_t bytes = Size(*_entry.mesh);
+  _entry.bytes -= std::min(bytes, _entry.bytes);
+  this->memory -= std::min(bytes, this->memory);
+}
+
+/////////////////////////////////////////////////
+bool AsyncMeshLoaderPrivate::NeedsLods(const common::Mesh &_mesh) const
+{
+  // Animated meshes would need their skeletons remapped, and aren't cached
+  return this->lodLevels > 0u && !_mesh.HasSkeleton() &&
+      MeshSimplifier::TriangleCount(_mesh) >= this->lodMinTriangles;
+}
+
+/////////////////////////////////////////////////
+void AsyncMeshLoaderPrivate::BuildLods(const std::string &_filename)
+{
+  std::shared_ptr<common::Mesh> mesh;
+  unsigned int levels;
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    auto it = this->done.find(_filename);
+    // The mesh may have been freed since
+    if (it == this->done.end() || nullptr == it->second.mesh)
+      return;
+    mesh = it->second.mesh;
+    levels = this->lodLevels;
+  }
+
+  const std::string fullname = common::findFile(_filename);
+  std::vector<std::shared_ptr<common::Mesh>> lods;
+  std::size_t bytes{0u};
+  for (unsigned int level = 1u; level <= levels; ++level)
+  {
+    // Each level is simplified from the previous one, which is much faster
+    // than simplifying the full mesh again
+    const std::string key = _filename + "#lod" + std::to_string(level);
+    std::shared_ptr<common::Mesh> lod;
+    // Meshes which only exist in memory aren't cached
+    if (this->cache && !fullname.empty())
+      lod = this->cache->LoadMesh(key, fullname);
+    if (nullptr == lod)
+    {
+      lod = MeshSimplifier::Simplify(lods.empty() ? *mesh : *lods.back(),
+          0.25);
+      if (nullptr == lod)
+        break;
+      if (this->cache && !fullname.empty())
+        this->cache->SaveMesh(key, fullname, *lod);
+    }
+
+    // Mesh names identify the meshes in the render engine
+    lod->SetName(_filename + "::lod" + std::to_string(level));
+    bytes += Size(*lod);
+    lods.push_back(lod);
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->stop)
+      return;
+  }
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  auto it = this->done.find(_filename);
+  if (lods.empty() || it == this->done.end() || it->second.mesh != mesh)
+    return;
+
+  it->second.lods = std::move(lods);
+  it->second.bytes += bytes;
+  this->memory += bytes;
+  this->finishedLods.push_back(_filename);
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<common::Mesh> AsyncMeshLoaderPrivate::Parse(
+    const std::string &_filename) const
+{
+  const std::string fullname = common::findFile(_filename);
+  if (fullname.empty())
+  {
+    ignerr << "Unable to find mesh file [" << _filename << "]" << std::endl;
+    return nullptr;
+  }
+
+  if (this->cache)
+  {
+    auto cached = this->cache->LoadMesh(_filename, fullname);
+    if (cached)
+      return std::shared_ptr<common::Mesh>(cached.release(), MeshDeleter());
+  }
+
+  std::string extension = fullname.substr(fullname.rfind(".") + 1);
+  std::transform(extension.begin(), extension.end(), extension.begin(),
+      ::tolower);
+
+  // Same loaders as common::MeshManager, but each call has its own instance
+  // so that several files can be parsed at the same time
+  common::Mesh *mesh{nullptr};
+  if (extension == "stl" || extension == "stlb" || extension == "stla")
+  {
+    common::STLLoader loader;
+    mesh = loader.Load(fullname);
+  }
+  else if (extension == "dae")
+  {
+    common::ColladaLoader loader;
+    mesh = loader.Load(fullname);
+  }
+  else if (extension == "obj")
+  {
+    common::OBJLoader loader;
+    mesh = loader.Load(fullname);
+  }
+  else
+  {
+    ignerr << "Unsupported mesh format for file [" << _filename << "]"
+           << std::endl;
+    return nullptr;
+  }
+
+  if (nullptr == mesh)
+  {
+    ignerr << "Failed to parse mesh file [" << _filename << "]" << std::endl;
+    return nullptr;
+  }
+
+  mesh->SetName(_filename);
+  if (this->cache)
+    this->cache->SaveMesh(_filename, fullname, *mesh);
+  return std::shared_ptr<common::Mesh>(mesh, MeshDeleter());
+}
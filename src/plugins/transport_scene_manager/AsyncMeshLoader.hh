@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_TRANSPORTSCENEMANAGER_ASYNCMESHLOADER_HH_
+#define GZ_GUI_PLUGINS_TRANSPORTSCENEMANAGER_ASYNCMESHLOADER_HH_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gz/common/Mesh.hh>
+
+#include "SceneCache.hh"
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  class AsyncMeshLoaderPrivate;
+
+  /// \brief Parses mesh files on a pool of worker threads.
+  ///
+  /// Each file is parsed at most once while it's in use: requests for a
+  /// file which is already being parsed are merged, and parsed meshes are
+  /// kept so that later requests are answered immediately. Meshes are
+  /// parsed with the gz-common loaders directly instead of through
+  /// common::MeshManager, which serializes parsing behind a single mutex.
+  ///
+  /// Parsed meshes are then handed to the mesh manager, from the thread
+  /// calling Request() and TakeFinished(), so that the render engine and
+  /// other plugins share them instead of parsing the files again. The mesh
+  /// manager owns them from then on. Meshes which the mesh manager already
+  /// has, such as meshes created in memory by other plugins, are used from
+  /// it right away.
+  ///
+  /// Users of a mesh hold a reference with Acquire() and Release(). Meshes
+  /// without references are kept in a least recently used list, and the
+  /// oldest ones are dropped by Trim() once the list is longer than the
+  /// retention. This frees their levels of detail, and the meshes which
+  /// couldn't be handed to the mesh manager.
+  ///
+  /// Large meshes can also get simplified levels of detail, see SetLod().
+  /// They're built after the mesh is done, so that the full mesh can be
+  /// shown before its levels of detail are ready.
+  class AsyncMeshLoader
+  {
+    /// \brief Constructor. Starts the worker threads.
+    /// \param[in] _threads Number of worker threads. Zero picks a number
+    /// based on the hardware concurrency.
+    /// \param[in] _cache Cache of parsed meshes on disk, checked before
+    /// parsing a file and updated after. Null to always parse.
+    public: explicit AsyncMeshLoader(unsigned int _threads = 0u,
+        std::shared_ptr<const SceneCache> _cache = nullptr);
+
+    /// \brief Destructor. Waits for the meshes being parsed or simplified
+    /// and stops the worker threads. Queued files which haven't started are
+    /// discarded.
+    public: ~AsyncMeshLoader();
+
+    /// \brief Get a mesh, queueing it to be parsed if it hasn't been yet.
+    /// Must be called from the thread which uses common::MeshManager,
+    /// usually the render thread.
+    /// \param[in] _filename Mesh file path or URI.
+    /// \param[out] _mesh Parsed mesh. Null if the file is still being parsed
+    /// or couldn't be parsed.
+    /// \return True if the file is done, which includes files that failed to
+    /// parse. False if the file is queued or being parsed, in which case
+    /// it will be returned by a later call to TakeFinished.
+    public: bool Request(const std::string &_filename,
+        std::shared_ptr<common::Mesh> &_mesh);
+
+    /// \brief Get the files which finished parsing since the last call.
+    /// Each file requested while it wasn't done is returned exactly once.
+    /// Must be called from the thread which uses common::MeshManager,
+    /// usually the render thread.
+    /// \return Finished file names.
+    public: std::vector<std::string> TakeFinished();
+
+    /// \brief Build levels of detail for meshes parsed from now on. Each
+    /// level has a quarter of the triangles of the previous one. Levels are
+    /// cached on disk together with the meshes.
+    /// \param[in] _levels Number of simplified levels, zero to disable.
+    /// \param[in] _minTriangles Meshes with fewer triangles don't get
+    /// levels of detail.
+    public: void SetLod(const unsigned int _levels,
+        const std::size_t _minTriangles);
+
+    /// \brief Get the levels of detail of a mesh.
+    /// \param[in] _filename Mesh file path or URI.
+    /// \return Simplified meshes, from the most to the least detailed. The
+    /// full mesh isn't included. Empty if the levels aren't built.
+    public: std::vector<std::shared_ptr<common::Mesh>> Lods(
+        const std::string &_filename) const;
+
+    /// \brief Get the files whose levels of detail were built since the
+    /// last call.
+    /// \return File names.
+    public: std::vector<std::string> TakeFinishedLods();
+
+    /// \brief Add a reference to a parsed mesh, which keeps it from being
+    /// freed.
+    /// \param[in] _filename Mesh file path or URI.
+    public: void Acquire(const std::string &_filename);
+
+    /// \brief Remove a reference added with Acquire. Meshes without
+    /// references become candidates to be freed by Trim.
+    /// \param[in] _filename Mesh file path or URI.
+    public: void Release(const std::string &_filename);
+
+    /// \brief Set how many meshes without references are kept.
+    /// \param[in] _count Number of meshes.
+    public: void SetRetention(const std::size_t _count);
+
+    /// \brief Drop the least recently used meshes without references, past
+    /// the retention. Meshes returned by TakeFinished which weren't
+    /// acquired since are considered unused, so this must not be called
+    /// between Request or TakeFinished and Acquire.
+    public: void Trim();
+
+    /// \brief Approximate memory used by the meshes which the loader owns,
+    /// which are the levels of detail and the meshes which weren't handed
+    /// to the mesh manager.
+    /// \return Size in bytes.
+    public: std::size_t MemoryUsage() const;
+
+    /// \internal
+    /// \brief Pointer to private data.
+    private: std::unique_ptr<AsyncMeshLoaderPrivate> dataPtr;
+  };
+}
+}
+}
+
+#endif
@@ -0,0 +1,292 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_TRANSPORTSCENEMANAGER_IDSLOTMAP_HH_
+#define GZ_GUI_PLUGINS_TRANSPORTSCENEMANAGER_IDSLOTMAP_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  /// \brief Dense container of values indexed by entity id.
+  ///
+  /// Values are stored contiguously, so sweeping over all of them touches
+  /// a single array. Lookups by id go through an open-addressing table with
+  /// linear probing which maps the id to its slot in the dense array.
+  /// Erasing moves the last value into the freed slot, so slot indices are
+  /// only stable until the next call to Erase.
+  /// \tparam T Value type, must be default constructible and movable.
+  template <typename T>
+  class IdSlotMap
+  {
+    /// \brief Entity id type.
+    public: using Id = unsigned int;
+
+    /// \brief Get the value stored for an id.
+    /// \param[in] _id Entity id.
+    /// \return Pointer to the value, or null if the id isn't in the map.
+    public: T *Find(const Id _id)
+    {
+      const std::size_t bucket = this->FindBucket(_id);
+      if (bucket == kNotFound)
+        return nullptr;
+      return &this->values[this->buckets[bucket] - 1];
+    }
+
+    /// \brief Get the value stored for an id.
+    /// \param[in] _id Entity id.
+    /// \return Pointer to the value, or null if the id isn't in the map.
+    public: const T *Find(const Id _id) const
+    {
+      const std::size_t bucket = this->FindBucket(_id);
+      if (bucket == kNotFound)
+        return nullptr;
+      return &this->values[this->buckets[bucket] - 1];
+    }
+
+    /// \brief Check whether an id is in the map.
+    /// \param[in] _id Entity id.
+    /// \return True if there's a value for the id.
+    public: bool Contains(const Id _id) const
+    {
+      return this->FindBucket(_id) != kNotFound;
+    }
+
+    /// \brief Get the value for an id, inserting a default constructed one
+    /// if the id isn't in the map yet.
+    /// \param[in] _id Entity id.
+    /// \return Reference to the value. It's invalidated by the next insertion
+    /// or erasure.
+    public: T &operator[](const Id _id)
+    {
+      const std::size_t bucket = this->FindBucket(_id);
+      if (bucket != kNotFound)
+        return this->values[this->buckets[bucket] - 1];
+
+      if ((this->ids.size() + 1) * 2 > this->buckets.size())
+        this->Rehash(this->buckets.empty() ? 64u : this->buckets.size() * 2);
+
+      this->ids.push_back(_id);
+      this->values.emplace_back();
+
+      std::size_t b = this->Home(_id);
+      while (this->buckets[b] != 0u)
+        b = (b + 1) & this->mask;
+      this->buckets[b] = this->ids.size();
+
+      return this->values.back();
+    }
+
+    /// \brief Remove the value stored for an id.
+    /// \param[in] _id Entity id.
+    /// \return True if the id was in the map.
+    public: bool Erase(const Id _id)
+    {
+      std::size_t hole = this->FindBucket(_id);
+      if (hole == kNotFound)
+        return false;
+
+      const std::size_t slot = this->buckets[hole] - 1;
+
+      // Backward shift deletion, so that probe sequences stay unbroken
+      // without the need for tombstones.
+      std::size_t next = hole;
+      while (true)
+      {
+        next = (next + 1) & this->mask;
+        if (this->buckets[next] == 0u)
+          break;
+
+        const std::size_t home =
+            this->Home(this->ids[this->buckets[next] - 1]);
+        const bool stays = hole <= next ?
+            (hole < home && home <= next) :
+            (hole < home || home <= next);
+        if (!stays)
+        {
+          this->buckets[hole] = this->buckets[next];
+          hole = next;
+        }
+      }
+      this->buckets[hole] = 0u;
+
+      // Keep the values dense by moving the last one into the freed slot
+      const std::size_t last = this->ids.size() - 1;
+      if (slot != last)
+      {
+        std::size_t b = this->Home(this->ids[last]);
+        while (this->buckets[b] != last + 1)
+          b = (b + 1) & this->mask;
+        this->buckets[b] = slot + 1;
+
+        this->ids[slot] = this->ids[last];
+        this->values[slot] = std::move(this->values[last]);
+      }
+      this->ids.pop_back();
+      this->values.pop_back();
+      return true;
+    }
+
+    /// \brief Remove all values. Allocated memory is kept for reuse.
+    public: void Clear()
+    {
+      this->ids.clear();
+      this->values.clear();
+      std::fill(this->buckets.begin(), this->buckets.end(), 0u);
+    }
+
+    /// \brief Number of values in the map.
+    /// \return Number of values.
+    public: std::size_t Size() const
+    {
+      return this->ids.size();
+    }
+
+    /// \brief Whether the map is empty.
+    /// \return True if there are no values.
+    public: bool Empty() const
+    {
+      return this->ids.empty();
+    }
+
+    /// \brief Get the id stored at a slot of the dense array.
+    /// \param[in] _slot Slot index, must be smaller than Size().
+    /// \return Entity id.
+    public: Id IdAt(const std::size_t _slot) const
+    {
+      return this->ids[_slot];
+    }
+
+    /// \brief Get the value stored at a slot of the dense array.
+    /// \param[in] _slot Slot index, must be smaller than Size().
+    /// \return Value at the slot.
+    public: T &ValueAt(const std::size_t _slot)
+    {
+      return this->values[_slot];
+    }
+
+    /// \brief Get the value stored at a slot of the dense array.
+    /// \param[in] _slot Slot index, must be smaller than Size().
+    /// \return Value at the slot.
+    public: const T &ValueAt(const std::size_t _slot) const
+    {
+      return this->values[_slot];
+    }
+
+    /// \brief Iterator to the first value of the dense array.
+    public: typename std::vector<T>::iterator begin()
+    {
+      return this->values.begin();
+    }
+
+    /// \brief Iterator past the last value of the dense array.
+    public: typename std::vector<T>::iterator end()
+    {
+      return this->values.end();
+    }
+
+    /// \brief Iterator to the first value of the dense array.
+    public: typename std::vector<T>::const_iterator begin() const
+    {
+      return this->values.begin();
+    }
+
+    /// \brief Iterator past the last value of the dense array.
+    public: typename std::vector<T>::const_iterator end() const
+    {
+      return this->values.end();
+    }
+
+    /// \brief Home bucket of an id, using Fibonacci hashing so that
+    /// sequential ids are spread over the table.
+    /// \param[in] _id Entity id.
+    /// \return Bucket index.
+    private: std::size_t Home(const Id _id) const
+    {
+      return static_cast<std::size_t>(
+          (static_cast<uint64_t>(_id) * 0x9E3779B97F4A7C15ull) >> this->shift);
+    }
+
+    /// \brief Find the bucket that points to an id.
+    /// \param[in] _id Entity id.
+    /// \return Bucket index, or kNotFound.
+    private: std::size_t FindBucket(const Id _id) const
+    {
+      if (this->ids.empty())
+        return kNotFound;
+
+      std::size_t b = this->Home(_id);
+      while (this->buckets[b] != 0u)
+      {
+        if (this->ids[this->buckets[b] - 1] == _id)
+          return b;
+        b = (b + 1) & this->mask;
+      }
+      return kNotFound;
+    }
+
+    /// \brief Resize the bucket table and reinsert all ids.
+    /// \param[in] _count New number of buckets, must be a power of two.
+    private: void Rehash(const std::size_t _count)
+    {
+      this->buckets.assign(_count, 0u);
+      this->mask = _count - 1;
+      this->shift = 64u;
+      for (std::size_t c = _count; c > 1u; c >>= 1)
+        --this->shift;
+
+      for (std::size_t i = 0; i < this->ids.size(); ++i)
+      {
+        std::size_t b = this->Home(this->ids[i]);
+        while (this->buckets[b] != 0u)
+          b = (b + 1) & this->mask;
+        this->buckets[b] = i + 1;
+      }
+    }
+
+    /// \brief Returned by FindBucket when the id isn't in the table.
+    private: static constexpr std::size_t kNotFound = ~std::size_t(0);
+
+    /// \brief Entity ids, in the same order as values.
+    private: std::vector<Id> ids;
+
+    /// \brief Dense array of values.
+    private: std::vector<T> values;
+
+    /// \brief Open-addressing table. Each bucket holds the slot index of a
+    /// value plus one, zero marks an empty bucket.
+    private: std::vector<std::size_t> buckets;
+
+    /// \brief Bucket count minus one.
+    private: std::size_t mask{0u};
+
+    /// \brief Right shift applied to the hash to get a bucket index.
+    private: unsigned int shift{64u};
+  };
+}
+}
+}
+
+#endif
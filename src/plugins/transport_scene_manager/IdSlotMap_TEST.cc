@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+
+#include "gz/gui/config.hh"
+
+#include "IdSlotMap.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+TEST(IdSlotMapTest, InsertFindErase)
+{
+  IdSlotMap<double> map;
+  EXPECT_TRUE(map.Empty());
+  EXPECT_EQ(nullptr, map.Find(1u));
+  EXPECT_FALSE(map.Erase(1u));
+
+  map[1u] = 1.0;
+  map[5u] = 5.0;
+  map[100000u] = 7.0;
+  EXPECT_EQ(3u, map.Size());
+  EXPECT_TRUE(map.Contains(5u));
+  ASSERT_NE(nullptr, map.Find(100000u));
+  EXPECT_DOUBLE_EQ(7.0, *map.Find(100000u));
+
+  // Existing ids are not inserted twice
+  map[5u] += 1.0;
+  EXPECT_EQ(3u, map.Size());
+  EXPECT_DOUBLE_EQ(6.0, *map.Find(5u));
+
+  // Erasing keeps the remaining values dense and reachable
+  EXPECT_TRUE(map.Erase(1u));
+  EXPECT_FALSE(map.Contains(1u));
+  EXPECT_EQ(2u, map.Size());
+  EXPECT_DOUBLE_EQ(6.0, *map.Find(5u));
+  EXPECT_DOUBLE_EQ(7.0, *map.Find(100000u));
+
+  double sum = 0.0;
+  for (const auto &value : map)
+    sum += value;
+  EXPECT_DOUBLE_EQ(13.0, sum);
+
+  for (std::size_t i = 0; i < map.Size(); ++i)
+    EXPECT_DOUBLE_EQ(map.ValueAt(i), *map.Find(map.IdAt(i)));
+
+  map.Clear();
+  EXPECT_TRUE(map.Empty());
+  EXPECT_EQ(nullptr, map.Find(5u));
+}
+
+/////////////////////////////////////////////////
+TEST(IdSlotMapTest, Churn)
+{
+  // Compare against std::map under random insertions and erasures, which
+  // exercises growth, probe collisions and backward shift deletion.
+  IdSlotMap<unsigned int> map;
+  std::map<unsigned int, unsigned int> reference;
+
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<unsigned int> idDist(0u, 5000u);
+  std::uniform_int_distribution<int> opDist(0, 2);
+
+  for (int i = 0; i < 200000; ++i)
+  {
+    const unsigned int id = idDist(gen);
+    if (opDist(gen) == 0)
+    {
+      EXPECT_EQ(reference.erase(id) > 0u, map.Erase(id));
+    }
+    else
+    {
+      map[id] = id * 3u;
+      reference[id] = id * 3u;
+    }
+  }
+
+  ASSERT_EQ(reference.size(), map.Size());
+  for (const auto &[id, value] : reference)
+  {
+    auto found = map.Find(id);
+    ASSERT_NE(nullptr, found);
+    EXPECT_EQ(value, *found);
+  }
+  for (unsigned int id = 0u; id <= 5000u; ++id)
+    EXPECT_EQ(reference.count(id) > 0u, map.Contains(id));
+}
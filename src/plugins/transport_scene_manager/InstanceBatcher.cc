@@ -0,0 +1,545 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/math/Pose3.hh>
+#include <gz/msgs/Utility.hh>
+#include <gz/rendering/Marker.hh>
+#include <gz/rendering/RenderTypes.hh>
+
+#include "InstanceBatcher.hh"
+#include "TriangleBatches.hh"
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  /// \brief Instance drawn by a batch, in a slot of the batch's vertices.
+  struct BatchInstance
+  {
+    /// \brief Visual of the instance, which has no geometry of its own.
+    rendering::VisualPtr::weak_type visual;
+
+    /// \brief Child of the visual with the instance's geometry, which is
+    /// only drawn by selection buffers so that the instance can be picked.
+    rendering::VisualPtr::weak_type proxy;
+
+    /// \brief Scale applied to the unit mesh.
+    math::Vector3d scale{math::Vector3d::One};
+
+    /// \brief Ids of the visual and its ancestors, except for the root.
+    /// Moving any of them moves the instance.
+    std::vector<unsigned int> nodeIds;
+
+    /// \brief False if the slot is free.
+    bool live{false};
+
+    /// \brief True if the slot is in the batch's list of changed slots.
+    bool changed{false};
+  };
+
+  /// \brief Instance added since the last update.
+  struct NewInstance
+  {
+    /// \brief Visual of the instance.
+    rendering::VisualPtr::weak_type visual;
+
+    /// \brief Unit mesh name.
+    std::string meshName;
+
+    /// \brief Scale applied to the unit mesh.
+    math::Vector3d scale{math::Vector3d::One};
+
+    /// \brief Shared material.
+    rendering::MaterialPtr material;
+  };
+
+  /// \brief Instances sharing a unit mesh and a material, drawn as one
+  /// triangle list. Each slot holds the vertices of one instance, at the
+  /// slot index times the number of unit mesh vertices.
+  struct InstanceBatch
+  {
+    /// \brief Unit mesh triangles, three vertices per triangle.
+    const std::vector<math::Vector3d> *triangles{nullptr};
+
+    /// \brief Key of the unit mesh and material, see lookup.
+    std::string key;
+
+    /// \brief Shared material of all instances, acquired by the batch.
+    rendering::MaterialPtr material;
+
+    /// \brief Visual holding the marker.
+    rendering::VisualPtr visual;
+
+    /// \brief Triangle list with the vertices of all instances.
+    rendering::MarkerPtr marker;
+
+    /// \brief Slots of the batch, including free ones.
+    std::vector<BatchInstance> instances;
+
+    /// \brief Indices of the free slots, reused by new instances.
+    std::vector<std::size_t> freeSlots;
+
+    /// \brief Number of live instances.
+    std::size_t liveCount{0u};
+
+    /// \brief Number of slots whose vertices are in the marker. Slots past
+    /// it are appended on the next update.
+    std::size_t drawnSlots{0u};
+
+    /// \brief Slots to write on the next update.
+    std::vector<std::size_t> changed;
+
+    /// \brief True if the batch is in the list of batches to update.
+    bool dirty{false};
+  };
+}
+}
+}
+
+/// \brief Private data class for InstanceBatcher
+class ignition::gui::plugins::InstanceBatcherPrivate
+{
+  /// \brief Find a batch with room for one more instance, creating it if
+  /// needed.
+  /// \param[in] _instance New instance.
+  /// \param[in] _triangles Unit mesh triangles.
+  /// \return Index of the batch.
+  public: std::size_t FindBatch(const NewInstance &_instance,
+      const std::vector<math::Vector3d> *_triangles);
+
+  /// \brief Queue a slot to be written on the next update.
+  /// \param[in] _index Index of the batch.
+  /// \param[in] _slot Slot of the instance.
+  public: void MarkChanged(const std::size_t _index, const std::size_t _slot);
+
+  /// \brief Write the vertices of the changed slots of a batch, freeing the
+  /// slots of deleted instances. The batch is destroyed if it has no
+  /// instances left.
+  /// \param[in] _index Index of the batch.
+  public: void Write(const std::size_t _index);
+
+  /// \brief Get the transform of an instance in the world.
+  /// \param[in] _instance Instance.
+  /// \param[out] _pose World pose.
+  /// \param[out] _scale World scale, including the instance's scale.
+  /// \return False if the instance was deleted, in which case the pose
+  /// and scale collapse its vertices to a point.
+  public: bool Transform(const BatchInstance &_instance,
+      math::Pose3d &_pose, math::Vector3d &_scale);
+
+  /// \brief Free the slot of a deleted instance.
+  /// \param[in] _index Index of the batch.
+  /// \param[in] _slot Slot of the instance.
+  public: void Free(const std::size_t _index, const std::size_t _slot);
+
+  /// \brief Destroy the marker of a batch and release its material. Its
+  /// index is reused by the next new batch.
+  /// \param[in] _index Index of the batch.
+  public: void Destroy(const std::size_t _index);
+
+  /// \brief Key of an instance in nodeInstances.
+  /// \param[in] _index Index of the batch.
+  /// \param[in] _slot Slot of the instance.
+  /// \return Key.
+  public: static uint64_t Key(const std::size_t _index,
+      const std::size_t _slot);
+
+  /// \brief Scene where batches are created.
+  public: rendering::ScenePtr scene;
+
+  /// \brief Cache of the instances' materials.
+  public: MaterialCache *materials{nullptr};
+
+  /// \brief All batches. Indices of batches are kept while they exist, so
+  /// destroyed batches leave a free slot.
+  public: std::vector<InstanceBatch> batches;
+
+  /// \brief Indices of the slots of destroyed batches.
+  public: std::vector<std::size_t> freeBatches;
+
+  /// \brief Batches by unit mesh and material, and unit mesh triangles.
+  public: TriangleBatches lookup;
+
+  /// \brief Indices of batches to write on the next update.
+  public: std::vector<std::size_t> dirtyBatches;
+
+  /// \brief Instances under each node, by node id. See Key().
+  public: std::unordered_map<unsigned int, std::unordered_set<uint64_t>>
+      nodeInstances;
+
+  /// \brief Instances added since the last update.
+  public: std::vector<NewInstance> newInstances;
+
+  /// \brief Nodes from the root to an instance, reused between instances.
+  public: std::vector<rendering::NodePtr> chain;
+};
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+InstanceBatcher::InstanceBatcher(const rendering::ScenePtr &_scene,
+    MaterialCache &_materials)
+  : dataPtr(new InstanceBatcherPrivate)
+{
+  this->dataPtr->scene = _scene;
+  this->dataPtr->materials = &_materials;
+}
+
+/////////////////////////////////////////////////
+InstanceBatcher::~InstanceBatcher() = default;
+
+/////////////////////////////////////////////////
+bool InstanceBatcher::Supports(const msgs::Geometry &_msg,
+    std::string &_meshName, math::Vector3d &_scale)
+{
+  // Same scales as the primitives created by TransportSceneManager, which
+  // have unit size like the common::MeshManager meshes
+  _scale = math::Vector3d::One;
+  if (_msg.has_box())
+  {
+    _meshName = "unit_box";
+    if (_msg.box().has_size())
+      _scale = msgs::Convert(_msg.box().size());
+  }
+  else if (_msg.has_cylinder())
+  {
+    _meshName = "unit_cylinder";
+    _scale.X() = _msg.cylinder().radius() * 2;
+    _scale.Y() = _scale.X();
+    _scale.Z() = _msg.cylinder().length();
+  }
+  else if (_msg.has_sphere())
+  {
+    _meshName = "unit_sphere";
+    _scale.X() = _msg.sphere().radius() * 2;
+    _scale.Y() = _scale.X();
+    _scale.Z() = _scale.X();
+  }
+  else if (_msg.has_ellipsoid())
+  {
+    _meshName = "unit_sphere";
+    _scale = msgs::Convert(_msg.ellipsoid().radii()) * 2;
+  }
+  else
+  {
+    return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+void InstanceBatcher::Add(const rendering::VisualPtr &_visual,
+    const std::string &_meshName, const math::Vector3d &_scale,
+    const rendering::MaterialPtr &_material)
+{
+  // Other visuals may release the material before the next update
+  this->dataPtr->materials->Acquire(_material);
+  this->dataPtr->newInstances.push_back({_visual, _meshName, _scale,
+      _material});
+}
+
+/////////////////////////////////////////////////
+void InstanceBatcher::MarkDirty(const unsigned int _nodeId)
+{
+  auto it = this->dataPtr->nodeInstances.find(_nodeId);
+  if (it == this->dataPtr->nodeInstances.end())
+    return;
+
+  for (const auto key : it->second)
+  {
+    this->dataPtr->MarkChanged(static_cast<std::size_t>(key >> 32u),
+        static_cast<std::size_t>(key & 0xFFFFFFFFu));
+  }
+}
+
+/////////////////////////////////////////////////
+void InstanceBatcher::Update()
+{
+  for (const auto &newInstance : this->dataPtr->newInstances)
+  {
+    // The batch holds its own reference to the material
+    auto release = [&]
+    {
+      this->dataPtr->materials->Release(this->dataPtr->scene,
+          newInstance.material);
+    };
+
+    // Skip instances deleted before their first update
+    auto visual = newInstance.visual.lock();
+    if (!visual)
+    {
+      release();
+      continue;
+    }
+
+    auto triangles = this->dataPtr->lookup.Triangles(newInstance.meshName);
+    if (nullptr == triangles)
+    {
+      ignerr << "Failed to find mesh [" << newInstance.meshName
+             << "] for instance [" << visual->Name() << "]" << std::endl;
+      release();
+      continue;
+    }
+
+    const std::size_t index = this->dataPtr->FindBatch(newInstance,
+        triangles);
+    release();
+
+    auto &batch = this->dataPtr->batches[index];
+    std::size_t slot = batch.instances.size();
+    if (batch.freeSlots.empty())
+    {
+      batch.instances.emplace_back();
+    }
+    else
+    {
+      slot = batch.freeSlots.back();
+      batch.freeSlots.pop_back();
+    }
+    ++batch.liveCount;
+
+    auto &instance = batch.instances[slot];
+    instance.visual = visual;
+    instance.scale = newInstance.scale;
+    instance.live = true;
+    instance.nodeIds.clear();
+    for (rendering::NodePtr node = visual; node && node->HasParent();
+        node = node->Parent())
+    {
+      instance.nodeIds.push_back(node->Id());
+      this->dataPtr->nodeInstances[node->Id()].insert(
+          InstanceBatcherPrivate::Key(index, slot));
+    }
+
+    // The batch isn't selectable, so ray queries and selection buffers hit
+    // this copy of the geometry instead, which is a child of the entity's
+    // visual
+    auto proxy = this->dataPtr->scene->CreateVisual();
+    proxy->AddGeometry(this->dataPtr->scene->CreateMesh(
+        newInstance.meshName));
+    proxy->SetLocalScale(newInstance.scale);
+    proxy->SetVisibilityFlags(IGN_VISIBILITY_SELECTION);
+    visual->AddChild(proxy);
+    instance.proxy = proxy;
+
+    this->dataPtr->MarkChanged(index, slot);
+  }
+  this->dataPtr->newInstances.clear();
+
+  for (const auto index : this->dataPtr->dirtyBatches)
+    this->dataPtr->Write(index);
+  this->dataPtr->dirtyBatches.clear();
+}
+
+/////////////////////////////////////////////////
+std::size_t InstanceBatcherPrivate::FindBatch(const NewInstance &_instance,
+    const std::vector<math::Vector3d> *_triangles)
+{
+  // Material names are unique, and cached materials are shared by all
+  // visuals with the same appearance
+  const std::string key = _instance.meshName + "::" +
+      _instance.material->Name();
+  auto fits = [&](const std::size_t _index)
+  {
+    const auto &batch = this->batches[_index];
+    return !batch.freeSlots.empty() ||
+        (batch.instances.size() + 1) * _triangles->size() <=
+        TriangleBatches::kMaxVertices;
+  };
+  auto create = [&]
+  {
+    InstanceBatch batch;
+    batch.triangles = _triangles;
+    batch.key = key;
+    batch.material = _instance.material;
+    this->materials->Acquire(batch.material);
+    batch.visual = TriangleBatches::CreateVisual(this->scene,
+        batch.material, batch.marker);
+    batch.visual->SetVisibilityFlags(
+        IGN_VISIBILITY_ALL & ~IGN_VISIBILITY_SELECTABLE);
+
+    std::size_t index = this->batches.size();
+    if (this->freeBatches.empty())
+    {
+      this->batches.push_back(std::move(batch));
+    }
+    else
+    {
+      index = this->freeBatches.back();
+      this->freeBatches.pop_back();
+      this->batches[index] = std::move(batch);
+    }
+    return index;
+  };
+  return this->lookup.Find(key, fits, create);
+}
+
+/////////////////////////////////////////////////
+void InstanceBatcherPrivate::MarkChanged(const std::size_t _index,
+    const std::size_t _slot)
+{
+  auto &batch = this->batches[_index];
+  auto &instance = batch.instances[_slot];
+  if (instance.changed)
+    return;
+
+  instance.changed = true;
+  batch.changed.push_back(_slot);
+  if (!batch.dirty)
+  {
+    batch.dirty = true;
+    this->dirtyBatches.push_back(_index);
+  }
+}
+
+/////////////////////////////////////////////////
+void InstanceBatcherPrivate::Write(const std::size_t _index)
+{
+  auto &batch = this->batches[_index];
+  batch.dirty = false;
+  if (!batch.marker)
+    return;
+
+  // Only the ranges of the instances which moved change. Deleted instances
+  // collapse their triangles to a point, and their slot is reused.
+  const std::size_t count = batch.triangles->size();
+  math::Pose3d pose;
+  math::Vector3d scale;
+  for (const auto slot : batch.changed)
+  {
+    auto &instance = batch.instances[slot];
+    instance.changed = false;
+    if (!instance.live || slot >= batch.drawnSlots)
+      continue;
+
+    if (!this->Transform(instance, pose, scale))
+      this->Free(_index, slot);
+    TriangleBatches::Set(batch.marker, slot * count, *batch.triangles, pose,
+        scale);
+  }
+  batch.changed.clear();
+
+  // New slots are appended in order
+  const math::Color color = batch.material->Diffuse();
+  for (; batch.drawnSlots < batch.instances.size(); ++batch.drawnSlots)
+  {
+    auto &instance = batch.instances[batch.drawnSlots];
+    instance.changed = false;
+    if (!this->Transform(instance, pose, scale) && instance.live)
+      this->Free(_index, batch.drawnSlots);
+    TriangleBatches::Add(batch.marker, *batch.triangles, pose, scale,
+        color);
+  }
+
+  if (batch.liveCount == 0u)
+    this->Destroy(_index);
+}
+
+/////////////////////////////////////////////////
+bool InstanceBatcherPrivate::Transform(const BatchInstance &_instance,
+    math::Pose3d &_pose, math::Vector3d &_scale)
+{
+  auto visual = _instance.visual.lock();
+  if (!_instance.live || !visual)
+  {
+    _pose = math::Pose3d::Zero;
+    _scale = math::Vector3d::Zero;
+    return false;
+  }
+
+  // Node::WorldPose leaves out the scale of the ancestors, which also
+  // scales the positions of their descendants
+  this->chain.clear();
+  for (rendering::NodePtr node = visual; node; node = node->Parent())
+    this->chain.push_back(node);
+
+  _pose = math::Pose3d::Zero;
+  _scale = math::Vector3d::One;
+  for (auto it = this->chain.rbegin(); it != this->chain.rend(); ++it)
+  {
+    const math::Pose3d local = (*it)->LocalPose();
+    _pose.Pos() += _pose.Rot() * (_scale * local.Pos());
+    _pose.Rot() = _pose.Rot() * local.Rot();
+    _scale *= (*it)->LocalScale();
+  }
+  this->chain.clear();
+
+  _scale *= _instance.scale;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void InstanceBatcherPrivate::Free(const std::size_t _index,
+    const std::size_t _slot)
+{
+  auto &batch = this->batches[_index];
+  auto &instance = batch.instances[_slot];
+
+  // Stop tracking its ancestors for this batch
+  const uint64_t key = Key(_index, _slot);
+  for (const auto nodeId : instance.nodeIds)
+  {
+    auto it = this->nodeInstances.find(nodeId);
+    if (it == this->nodeInstances.end())
+      continue;
+    it->second.erase(key);
+    if (it->second.empty())
+      this->nodeInstances.erase(it);
+  }
+
+  // The proxy is usually destroyed with the instance's visual
+  if (auto proxy = instance.proxy.lock())
+    this->scene->DestroyVisual(proxy);
+
+  instance = BatchInstance();
+  batch.freeSlots.push_back(_slot);
+  --batch.liveCount;
+}
+
+/////////////////////////////////////////////////
+void InstanceBatcherPrivate::Destroy(const std::size_t _index)
+{
+  auto &batch = this->batches[_index];
+
+  this->lookup.Remove(batch.key, _index);
+
+  // The marker must be gone before its material may be destroyed
+  this->scene->DestroyVisual(batch.visual, true);
+  this->materials->Release(this->scene, batch.material);
+
+  batch = InstanceBatch();
+  this->freeBatches.push_back(_index);
+}
+
+/////////////////////////////////////////////////
+uint64_t InstanceBatcherPrivate::Key(const std::size_t _index,
+    const std::size_t _slot)
+{
+  return (static_cast<uint64_t>(_index) << 32u) |
+      static_cast<uint64_t>(_slot);
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_TRANSPORTSCENEMANAGER_INSTANCEBATCHER_HH_
+#define GZ_GUI_PLUGINS_TRANSPORTSCENEMANAGER_INSTANCEBATCHER_HH_
+
+#include <memory>
+#include <string>
+
+#include <gz/math/Vector3.hh>
+#include <gz/msgs/geometry.pb.h>
+#include <gz/rendering/Material.hh>
+#include <gz/rendering/Scene.hh>
+#include <gz/rendering/Visual.hh>
+
+#include "MaterialCache.hh"
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  class InstanceBatcherPrivate;
+
+  /// \brief Draws many copies of the same primitive with few draw calls.
+  ///
+  /// gz-rendering has no instanced drawing API, so instances which share a
+  /// primitive and a material are merged into a single dynamic triangle
+  /// list, with each instance's world transform and scale baked into its
+  /// own range of vertices. Each instance keeps its own visual in the scene
+  /// graph, which can still be posed, looked up and deleted. When an
+  /// instance or one of its ancestors moves, only the instance's range is
+  /// rewritten. Deleted instances collapse their range, which is reused by
+  /// the next new instance of the batch. Batches whose instances are all
+  /// deleted are destroyed.
+  ///
+  /// Materials come from a MaterialCache. Instances hold a reference to
+  /// their material until they're added to a batch, and each batch holds a
+  /// reference while it exists, so materials shared with other visuals
+  /// aren't destroyed while a batch draws them.
+  ///
+  /// Batches can't be picked. Instead, each instance's visual gets a child
+  /// with the instance's geometry, which only selection buffers draw, so
+  /// that ray queries and selection return that child of the instance's
+  /// visual.
+  class InstanceBatcher
+  {
+    /// \brief Constructor
+    /// \param[in] _scene Scene where batches are created.
+    /// \param[in] _materials Cache of the instances' materials, which must
+    /// outlive the batcher.
+    public: InstanceBatcher(const rendering::ScenePtr &_scene,
+        MaterialCache &_materials);
+
+    /// \brief Destructor
+    public: ~InstanceBatcher();
+
+    /// \brief Check whether a geometry can be drawn by a batch.
+    /// \param[in] _msg Geometry msg.
+    /// \param[out] _meshName Name of the unit mesh in common::MeshManager.
+    /// \param[out] _scale Scale to apply to the unit mesh.
+    /// \return True for boxes, cylinders, spheres and ellipsoids.
+    public: static bool Supports(const msgs::Geometry &_msg,
+        std::string &_meshName, math::Vector3d &_scale);
+
+    /// \brief Add an instance. It is drawn from the next call to Update,
+    /// once its visual has been attached to the scene.
+    /// \param[in] _visual Visual of the instance, without geometry. The
+    /// child used for picking is added to it.
+    /// \param[in] _meshName Unit mesh returned by Supports.
+    /// \param[in] _scale Scale returned by Supports.
+    /// \param[in] _material Material from the cache, which is acquired
+    /// until the next call to Update merges the instance into a batch. The
+    /// batch holds its own reference while it exists.
+    public: void Add(const rendering::VisualPtr &_visual,
+        const std::string &_meshName, const math::Vector3d &_scale,
+        const rendering::MaterialPtr &_material);
+
+    /// \brief Notify that a node has moved or is about to be deleted, so
+    /// that the vertices of the instances under it are rewritten.
+    /// \param[in] _nodeId Id of the rendering node.
+    public: void MarkDirty(const unsigned int _nodeId);
+
+    /// \brief Add new instances to batches and rewrite the vertices of the
+    /// instances which moved or were deleted.
+    public: void Update();
+
+    /// \internal
+    /// \brief Pointer to private data.
+    private: std::unique_ptr<InstanceBatcherPrivate> dataPtr;
+  };
+}
+}
+}
+
+#endif
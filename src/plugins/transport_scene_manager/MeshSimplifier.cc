@@ -0,0 +1,708 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <gz/common/SubMesh.hh>
+#include <gz/math/Vector2.hh>
+#include <gz/math/Vector3.hh>
+
+#include "MeshSimplifier.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+namespace
+{
+/// \brief Weight of the planes which keep borders and seams in place,
+/// relative to the planes of the triangles
+constexpr double kBorderWeight = 100.0;
+
+/// \brief Fewest triangles kept in a simplified submesh
+constexpr std::size_t kMinTriangles = 8u;
+
+/// \brief Cosine of the crease angle, 30 degrees. Vertices at the same
+/// place whose normals differ more aren't welded, so that hard edges are
+/// kept as seams.
+constexpr double kCreaseCosine = 0.866;
+
+/// \brief Symmetric 4x4 matrix of a quadric error metric, which sums the
+/// weighted squared distances to a set of planes
+class Quadric
+{
+  /// \brief Add a plane
+  /// \param[in] _normal Unit normal of the plane
+  /// \param[in] _point Point on the plane
+  /// \param[in] _weight Weight of the plane
+  public: void AddPlane(const math::Vector3d &_normal,
+      const math::Vector3d &_point, const double _weight)
+  {
+    const double a = _normal.X();
+    const double b = _normal.Y();
+    const double c = _normal.Z();
+    const double d = -_normal.Dot(_point);
+    this->m[0] += _weight * a * a;
+    this->m[1] += _weight * a * b;
+    this->m[2] += _weight * a * c;
+    this->m[3] += _weight * a * d;
+    this->m[4] += _weight * b * b;
+    this->m[5] += _weight * b * c;
+    this->m[6] += _weight * b * d;
+    this->m[7] += _weight * c * c;
+    this->m[8] += _weight * c * d;
+    this->m[9] += _weight * d * d;
+  }
+
+  /// \brief Get the error of a point
+  /// \param[in] _p Point
+  /// \return Weighted sum of squared distances to the planes
+  public: double Error(const math::Vector3d &_p) const
+  {
+    const double x = _p.X();
+    const double y = _p.Y();
+    const double z = _p.Z();
+    return this->m[0] * x * x + 2.0 * this->m[1] * x * y +
+        2.0 * this->m[2] * x * z + 2.0 * this->m[3] * x +
+        this->m[4] * y * y + 2.0 * this->m[5] * y * z +
+        2.0 * this->m[6] * y + this->m[7] * z * z +
+        2.0 * this->m[8] * z + this->m[9];
+  }
+
+  /// \brief Add the planes of another quadric
+  /// \param[in] _other Other quadric
+  /// \return This quadric
+  public: Quadric &operator+=(const Quadric &_other)
+  {
+    for (std::size_t i = 0u; i < this->m.size(); ++i)
+      this->m[i] += _other.m[i];
+    return *this;
+  }
+
+  /// \brief Upper triangle of the matrix
+  private: std::array<double, 10> m{};
+};
+
+/// \brief Candidate edge collapse
+struct Collapse
+{
+  /// \brief Error of the collapsed vertex
+  double error;
+
+  /// \brief Vertex which is kept, in place
+  uint32_t keep;
+
+  /// \brief Vertex which is merged into the kept one
+  uint32_t remove;
+
+  /// \brief Stamp of the kept vertex when the candidate was computed
+  uint32_t keepStamp;
+
+  /// \brief Stamp of the removed vertex when the candidate was computed
+  uint32_t removeStamp;
+
+  /// \brief Order of the priority queue, lowest error first
+  /// \param[in] _other Other candidate
+  /// \return True if this candidate has a larger error
+  bool operator>(const Collapse &_other) const
+  {
+    return this->error > _other.error;
+  }
+};
+
+/// \brief Simplifies a triangle list submesh by collapsing edges, lowest
+/// error first. Vertices are kept in place, so that their texture
+/// coordinates stay valid.
+class SubMeshSimplifier
+{
+  /// \brief Constructor
+  /// \param[in] _subMesh Triangle list submesh
+  public: explicit SubMeshSimplifier(const common::SubMesh &_subMesh);
+
+  /// \brief Get the number of triangles left
+  /// \return Number of triangles
+  public: std::size_t TriangleCount() const
+  {
+    return this->liveTriangles;
+  }
+
+  /// \brief Collapse edges until there are few enough triangles, or no
+  /// edge can be collapsed
+  /// \param[in] _target Number of triangles to keep
+  public: void Simplify(const std::size_t _target);
+
+  /// \brief Add the remaining vertices and triangles to a submesh
+  /// \param[out] _subMesh Submesh to fill
+  public: void Write(common::SubMesh &_subMesh) const;
+
+  /// \brief Weld vertices with the same position and texture coordinate,
+  /// and normals within the crease angle
+  /// \param[in] _subMesh Submesh
+  /// \param[out] _remap Welded vertex of each submesh vertex
+  private: void Weld(const common::SubMesh &_subMesh,
+      std::vector<uint32_t> &_remap);
+
+  /// \brief Compute the quadrics of all vertices and queue all edges
+  private: void Initialize();
+
+  /// \brief Queue the collapse of an edge, towards its cheapest vertex
+  /// \param[in] _a First vertex
+  /// \param[in] _b Second vertex
+  private: void Push(const uint32_t _a, const uint32_t _b);
+
+  /// \brief Get the vertices sharing a triangle with a vertex
+  /// \param[in] _v Vertex
+  /// \param[out] _neighbors Sorted neighbors
+  private: void Neighbors(const uint32_t _v,
+      std::vector<uint32_t> &_neighbors) const;
+
+  /// \brief Check that a collapse keeps the surface manifold and doesn't
+  /// flip triangles
+  /// \param[in] _keep Vertex which is kept
+  /// \param[in] _remove Vertex which is removed
+  /// \return True if the collapse is valid
+  private: bool CanCollapse(const uint32_t _keep, const uint32_t _remove);
+
+  /// \brief Merge a vertex into another one
+  /// \param[in] _keep Vertex which is kept
+  /// \param[in] _remove Vertex which is removed
+  private: void Apply(const uint32_t _keep, const uint32_t _remove);
+
+  /// \brief Get the area weighted normal of a triangle
+  /// \param[in] _tri Triangle
+  /// \return Normal, with twice the area as length
+  private: math::Vector3d Normal(const std::array<uint32_t, 3> &_tri) const
+  {
+    const auto &p0 = this->positions[_tri[0]];
+    return (this->positions[_tri[1]] - p0).Cross(
+        this->positions[_tri[2]] - p0);
+  }
+
+  /// \brief Welded vertex positions
+  private: std::vector<math::Vector3d> positions;
+
+  /// \brief Welded vertex texture coordinates, empty if there are none
+  private: std::vector<math::Vector2d> texCoords;
+
+  /// \brief Welded vertex normals, the average of the original normals
+  /// which were welded. Empty if there are none, in which case normals are
+  /// recomputed.
+  private: std::vector<math::Vector3d> normals;
+
+  /// \brief Triangles, by welded vertex
+  private: std::vector<std::array<uint32_t, 3>> triangles;
+
+  /// \brief Whether each triangle was collapsed
+  private: std::vector<bool> deadTriangles;
+
+  /// \brief Number of triangles which weren't collapsed
+  private: std::size_t liveTriangles{0u};
+
+  /// \brief Triangles of each vertex, may hold collapsed triangles
+  private: std::vector<std::vector<uint32_t>> vertexTriangles;
+
+  /// \brief Quadric of each vertex
+  private: std::vector<Quadric> quadrics;
+
+  /// \brief Incremented each time a vertex changes, to skip stale
+  /// candidates
+  private: std::vector<uint32_t> stamps;
+
+  /// \brief Whether each vertex was merged into another one
+  private: std::vector<bool> removed;
+
+  /// \brief Candidate collapses, lowest error first
+  private: std::priority_queue<Collapse, std::vector<Collapse>,
+      std::greater<Collapse>> queue;
+
+  /// \brief Scratch neighbors of the kept vertex
+  private: std::vector<uint32_t> keepNeighbors;
+
+  /// \brief Scratch neighbors of the removed vertex
+  private: std::vector<uint32_t> removeNeighbors;
+};
+
+/////////////////////////////////////////////////
+SubMeshSimplifier::SubMeshSimplifier(const common::SubMesh &_subMesh)
+{
+  std::vector<uint32_t> remap;
+  this->Weld(_subMesh, remap);
+
+  const auto vertexCount = static_cast<int64_t>(remap.size());
+  const unsigned int indexCount = _subMesh.IndexCount();
+  this->triangles.reserve(indexCount / 3u);
+  for (unsigned int i = 0u; i + 2u < indexCount; i += 3u)
+  {
+    std::array<uint32_t, 3> tri;
+    bool valid{true};
+    for (unsigned int j = 0u; j < 3u; ++j)
+    {
+      const auto index = static_cast<int64_t>(_subMesh.Index(i + j));
+      valid = valid && index >= 0 && index < vertexCount;
+      tri[j] = valid ? remap[index] : 0u;
+    }
+
+    // Triangles which are already degenerate are dropped
+    if (valid && tri[0] != tri[1] && tri[1] != tri[2] && tri[0] != tri[2])
+      this->triangles.push_back(tri);
+  }
+
+  this->deadTriangles.assign(this->triangles.size(), false);
+  this->liveTriangles = this->triangles.size();
+  this->vertexTriangles.resize(this->positions.size());
+  for (uint32_t t = 0u; t < this->triangles.size(); ++t)
+  {
+    for (const uint32_t v : this->triangles[t])
+      this->vertexTriangles[v].push_back(t);
+  }
+  this->quadrics.resize(this->positions.size());
+  this->stamps.assign(this->positions.size(), 0u);
+  this->removed.assign(this->positions.size(), false);
+
+  this->Initialize();
+}
+
+/////////////////////////////////////////////////
+void SubMeshSimplifier::Weld(const common::SubMesh &_subMesh,
+    std::vector<uint32_t> &_remap)
+{
+  const unsigned int count = _subMesh.VertexCount();
+  const bool hasTexCoords = count > 0u && _subMesh.TexCoordCount() == count;
+
+  std::vector<math::Vector3d> vertices(count);
+  std::vector<math::Vector2d> coords(hasTexCoords ? count : 0u);
+  for (unsigned int i = 0u; i < count; ++i)
+  {
+    vertices[i] = _subMesh.Vertex(i);
+    if (hasTexCoords)
+      coords[i] = _subMesh.TexCoord(i);
+  }
+
+  auto key = [&](const uint32_t _i)
+  {
+    const auto &v = vertices[_i];
+    const auto &t = hasTexCoords ? coords[_i] : math::Vector2d::Zero;
+    return std::make_tuple(v.X(), v.Y(), v.Z(), t.X(), t.Y());
+  };
+
+  std::vector<uint32_t> order(count);
+  std::iota(order.begin(), order.end(), 0u);
+  std::sort(order.begin(), order.end(),
+      [&key](const uint32_t _a, const uint32_t _b)
+      {
+        return key(_a) < key(_b);
+      });
+
+  // Vertices at the same place are split further by normal, so that hard
+  // edges, like those of flat shaded meshes, become seams which stay in
+  // place and keep their normals
+  const bool hasNormals = count > 0u && _subMesh.NormalCount() == count;
+  _remap.resize(count);
+  std::size_t groupStart{0u};
+  for (std::size_t i = 0u; i < order.size(); ++i)
+  {
+    if (i == 0u || key(order[i]) != key(order[i - 1u]))
+      groupStart = this->positions.size();
+
+    // Welded vertices of this group so far, whose normals are sums of
+    // the original ones
+    std::size_t welded = this->positions.size();
+    if (hasNormals)
+    {
+      auto normal = _subMesh.Normal(order[i]);
+      normal.Normalize();
+      for (std::size_t w = groupStart; w < this->positions.size(); ++w)
+      {
+        auto average = this->normals[w];
+        average.Normalize();
+        if (average.Dot(normal) >= kCreaseCosine)
+        {
+          welded = w;
+          this->normals[w] += normal;
+          break;
+        }
+      }
+      if (welded == this->positions.size())
+        this->normals.push_back(normal);
+    }
+    else if (groupStart < this->positions.size())
+    {
+      welded = groupStart;
+    }
+
+    if (welded == this->positions.size())
+    {
+      this->positions.push_back(vertices[order[i]]);
+      if (hasTexCoords)
+        this->texCoords.push_back(coords[order[i]]);
+    }
+    _remap[order[i]] = static_cast<uint32_t>(welded);
+  }
+
+  for (auto &normal : this->normals)
+  {
+    if (normal.SquaredLength() > 0.0)
+      normal.Normalize();
+    else
+      normal = math::Vector3d::UnitZ;
+  }
+}
+
+/////////////////////////////////////////////////
+void SubMeshSimplifier::Initialize()
+{
+  // Each edge of each triangle, sorted so that copies of an edge are next
+  // to each other
+  std::vector<std::pair<uint64_t, uint32_t>> edges;
+  edges.reserve(this->triangles.size() * 3u);
+
+  for (uint32_t t = 0u; t < this->triangles.size(); ++t)
+  {
+    const auto &tri = this->triangles[t];
+    const auto normal = this->Normal(tri);
+    const double length = normal.Length();
+    if (length > 0.0)
+    {
+      // Larger triangles weigh more
+      for (const uint32_t v : tri)
+      {
+        this->quadrics[v].AddPlane(normal / length,
+            this->positions[tri[0]], length * 0.5);
+      }
+    }
+
+    for (unsigned int j = 0u; j < 3u; ++j)
+    {
+      const uint32_t a = std::min(tri[j], tri[(j + 1u) % 3u]);
+      const uint32_t b = std::max(tri[j], tri[(j + 1u) % 3u]);
+      edges.emplace_back((static_cast<uint64_t>(a) << 32u) | b, t);
+    }
+  }
+  std::sort(edges.begin(), edges.end());
+
+  // Edges with a single triangle are on borders or texture seams. They get
+  // a plane perpendicular to their triangle, so that they stay in place.
+  auto unique = edges.begin();
+  for (auto it = edges.begin(); it != edges.end();)
+  {
+    auto next = it + 1;
+    while (next != edges.end() && next->first == it->first)
+      ++next;
+
+    const auto a = static_cast<uint32_t>(it->first >> 32u);
+    const auto b = static_cast<uint32_t>(it->first & 0xffffffffu);
+    if (next - it == 1)
+    {
+      const auto direction = this->positions[b] - this->positions[a];
+      const auto normal =
+          direction.Cross(this->Normal(this->triangles[it->second]));
+      const double length = normal.Length();
+      if (length > 0.0)
+      {
+        const double weight = kBorderWeight * direction.SquaredLength();
+        this->quadrics[a].AddPlane(normal / length, this->positions[a],
+            weight);
+        this->quadrics[b].AddPlane(normal / length, this->positions[a],
+            weight);
+      }
+    }
+
+    *unique++ = *it;
+    it = next;
+  }
+  edges.erase(unique, edges.end());
+
+  for (const auto &edge : edges)
+  {
+    this->Push(static_cast<uint32_t>(edge.first >> 32u),
+        static_cast<uint32_t>(edge.first & 0xffffffffu));
+  }
+}
+
+/////////////////////////////////////////////////
+void SubMeshSimplifier::Push(const uint32_t _a, const uint32_t _b)
+{
+  Quadric quadric = this->quadrics[_a];
+  quadric += this->quadrics[_b];
+  const double errorA = quadric.Error(this->positions[_a]);
+  const double errorB = quadric.Error(this->positions[_b]);
+  if (errorA <= errorB)
+    this->queue.push({errorA, _a, _b, this->stamps[_a], this->stamps[_b]});
+  else
+    this->queue.push({errorB, _b, _a, this->stamps[_b], this->stamps[_a]});
+}
+
+/////////////////////////////////////////////////
+void SubMeshSimplifier::Neighbors(const uint32_t _v,
+    std::vector<uint32_t> &_neighbors) const
+{
+  _neighbors.clear();
+  for (const uint32_t t : this->vertexTriangles[_v])
+  {
+    if (this->deadTriangles[t])
+      continue;
+    for (const uint32_t v : this->triangles[t])
+    {
+      if (v != _v)
+        _neighbors.push_back(v);
+    }
+  }
+  std::sort(_neighbors.begin(), _neighbors.end());
+  _neighbors.erase(std::unique(_neighbors.begin(), _neighbors.end()),
+      _neighbors.end());
+}
+
+/////////////////////////////////////////////////
+bool SubMeshSimplifier::CanCollapse(const uint32_t _keep,
+    const uint32_t _remove)
+{
+  this->Neighbors(_keep, this->keepNeighbors);
+  this->Neighbors(_remove, this->removeNeighbors);
+
+  // Vertices shared by both ends must be the ones of the collapsed
+  // triangles, otherwise the collapse would pinch the surface
+  std::size_t shared{0u};
+  for (const uint32_t t : this->vertexTriangles[_remove])
+  {
+    const auto &tri = this->triangles[t];
+    if (!this->deadTriangles[t] &&
+        std::find(tri.begin(), tri.end(), _keep) != tri.end())
+    {
+      ++shared;
+    }
+  }
+  if (shared == 0u)
+    return false;
+
+  std::size_t sharedNeighbors{0u};
+  auto keepIt = this->keepNeighbors.begin();
+  auto removeIt = this->removeNeighbors.begin();
+  while (keepIt != this->keepNeighbors.end() &&
+         removeIt != this->removeNeighbors.end())
+  {
+    if (*keepIt < *removeIt)
+    {
+      ++keepIt;
+    }
+    else if (*removeIt < *keepIt)
+    {
+      ++removeIt;
+    }
+    else
+    {
+      ++sharedNeighbors;
+      ++keepIt;
+      ++removeIt;
+    }
+  }
+  if (sharedNeighbors != shared)
+    return false;
+
+  // Moving the removed vertex onto the kept one must not flip the
+  // triangles which are left
+  for (const uint32_t t : this->vertexTriangles[_remove])
+  {
+    auto tri = this->triangles[t];
+    if (this->deadTriangles[t] ||
+        std::find(tri.begin(), tri.end(), _keep) != tri.end())
+    {
+      continue;
+    }
+
+    const auto before = this->Normal(tri);
+    std::replace(tri.begin(), tri.end(), _remove, _keep);
+    if (before.SquaredLength() > 0.0 && before.Dot(this->Normal(tri)) <= 0.0)
+      return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+void SubMeshSimplifier::Apply(const uint32_t _keep, const uint32_t _remove)
+{
+  auto &keepTriangles = this->vertexTriangles[_keep];
+  for (const uint32_t t : this->vertexTriangles[_remove])
+  {
+    if (this->deadTriangles[t])
+      continue;
+
+    auto &tri = this->triangles[t];
+    if (std::find(tri.begin(), tri.end(), _keep) != tri.end())
+    {
+      this->deadTriangles[t] = true;
+      --this->liveTriangles;
+      continue;
+    }
+    std::replace(tri.begin(), tri.end(), _remove, _keep);
+    keepTriangles.push_back(t);
+  }
+  std::vector<uint32_t>().swap(this->vertexTriangles[_remove]);
+  this->removed[_remove] = true;
+
+  keepTriangles.erase(std::remove_if(keepTriangles.begin(),
+      keepTriangles.end(), [this](const uint32_t _t)
+      {
+        return this->deadTriangles[_t];
+      }), keepTriangles.end());
+
+  // The kept vertex has a new quadric, so all its edges have new costs
+  this->quadrics[_keep] += this->quadrics[_remove];
+  ++this->stamps[_keep];
+  this->Neighbors(_keep, this->keepNeighbors);
+  for (const uint32_t v : this->keepNeighbors)
+    this->Push(_keep, v);
+}
+
+/////////////////////////////////////////////////
+void SubMeshSimplifier::Simplify(const std::size_t _target)
+{
+  while (this->liveTriangles > _target && !this->queue.empty())
+  {
+    const Collapse collapse = this->queue.top();
+    this->queue.pop();
+
+    if (this->removed[collapse.keep] || this->removed[collapse.remove] ||
+        this->stamps[collapse.keep] != collapse.keepStamp ||
+        this->stamps[collapse.remove] != collapse.removeStamp)
+    {
+      continue;
+    }
+
+    if (this->CanCollapse(collapse.keep, collapse.remove))
+      this->Apply(collapse.keep, collapse.remove);
+  }
+}
+
+/////////////////////////////////////////////////
+void SubMeshSimplifier::Write(common::SubMesh &_subMesh) const
+{
+  constexpr uint32_t kUnused = std::numeric_limits<uint32_t>::max();
+  std::vector<uint32_t> indices(this->positions.size(), kUnused);
+  std::vector<math::Vector3d> normals;
+
+  for (uint32_t t = 0u; t < this->triangles.size(); ++t)
+  {
+    if (this->deadTriangles[t])
+      continue;
+
+    const auto &tri = this->triangles[t];
+    const auto normal = this->Normal(tri);
+    for (const uint32_t v : tri)
+    {
+      if (indices[v] == kUnused)
+      {
+        indices[v] = static_cast<uint32_t>(normals.size());
+        normals.push_back(math::Vector3d::Zero);
+        _subMesh.AddVertex(this->positions[v]);
+        if (!this->texCoords.empty())
+          _subMesh.AddTexCoord(this->texCoords[v]);
+        if (!this->normals.empty())
+          normals.back() = this->normals[v];
+      }
+      if (this->normals.empty())
+        normals[indices[v]] += normal;
+      _subMesh.AddIndex(indices[v]);
+    }
+  }
+
+  // Vertices stay in place, so they keep their original normals. Meshes
+  // without normals get smooth ones, weighted by the area of the triangles.
+  for (auto &normal : normals)
+  {
+    if (normal.SquaredLength() > 0.0)
+      normal.Normalize();
+    else
+      normal = math::Vector3d::UnitZ;
+    _subMesh.AddNormal(normal);
+  }
+}
+}
+
+/////////////////////////////////////////////////
+std::unique_ptr<common::Mesh> MeshSimplifier::Simplify(
+    const common::Mesh &_mesh, const double _ratio)
+{
+  auto result = std::make_unique<common::Mesh>();
+  result->SetName(_mesh.Name());
+  for (unsigned int i = 0u; i < _mesh.MaterialCount(); ++i)
+    result->AddMaterial(_mesh.MaterialByIndex(i));
+
+  const double ratio = std::clamp(_ratio, 0.0, 1.0);
+  bool hasTriangles{false};
+  for (unsigned int i = 0u; i < _mesh.SubMeshCount(); ++i)
+  {
+    auto subMesh = _mesh.SubMeshByIndex(i).lock();
+    if (nullptr == subMesh)
+      continue;
+
+    if (subMesh->SubMeshPrimitiveType() != common::SubMesh::TRIANGLES)
+    {
+      result->AddSubMesh(*subMesh);
+      continue;
+    }
+
+    hasTriangles = hasTriangles || subMesh->IndexCount() >= 3u;
+
+    SubMeshSimplifier simplifier(*subMesh);
+    const std::size_t count = simplifier.TriangleCount();
+    simplifier.Simplify(std::max(static_cast<std::size_t>(count * ratio),
+        std::min(count, kMinTriangles)));
+
+    // Submeshes which are too small or degenerate to be simplified are kept
+    // as they are, instead of being welded and getting new normals
+    if (simplifier.TriangleCount() == count)
+    {
+      result->AddSubMesh(*subMesh);
+      continue;
+    }
+
+    common::SubMesh simplified(subMesh->Name());
+    simplified.SetPrimitiveType(common::SubMesh::TRIANGLES);
+    simplified.SetMaterialIndex(subMesh->MaterialIndex());
+    simplifier.Write(simplified);
+    result->AddSubMesh(simplified);
+  }
+
+  if (!hasTriangles)
+    return nullptr;
+  return result;
+}
+
+/////////////////////////////////////////////////
+std::size_t MeshSimplifier::TriangleCount(const common::Mesh &_mesh)
+{
+  std::size_t count{0u};
+  for (unsigned int i = 0u; i < _mesh.SubMeshCount(); ++i)
+  {
+    auto subMesh = _mesh.SubMeshByIndex(i).lock();
+    if (nullptr != subMesh &&
+        subMesh->SubMeshPrimitiveType() == common::SubMesh::TRIANGLES)
+    {
+      count += subMesh->IndexCount() / 3u;
+    }
+  }
+  return count;
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_TRANSPORTSCENEMANAGER_MESHSIMPLIFIER_HH_
+#define GZ_GUI_PLUGINS_TRANSPORTSCENEMANAGER_MESHSIMPLIFIER_HH_
+
+#include <cstddef>
+#include <memory>
+
+#include <gz/common/Mesh.hh>
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  /// \brief Builds simplified versions of meshes, used as levels of detail
+  /// for meshes which are far from the camera.
+  ///
+  /// Triangle lists are simplified with quadric error metric edge
+  /// collapses. Vertices are welded by position, texture coordinate and
+  /// normal first, so that meshes with a vertex per face corner, like STL,
+  /// can be simplified too. Normals within a 30 degree crease angle are
+  /// welded, so hard edges aren't. Open borders, texture seams and hard
+  /// edges are kept in place, and collapses which would flip triangles are
+  /// skipped. Vertices keep their original normals, averaged where they
+  /// were welded. Meshes without normals get smooth ones.
+  ///
+  /// Submeshes are simplified independently, so the simplified mesh has
+  /// the same submeshes and materials as the original. Submeshes with other
+  /// primitive types, and triangle lists which are too small or degenerate
+  /// to be simplified, are copied as is.
+  ///
+  /// Simplifying millions of triangles takes seconds, so this is meant to
+  /// be called from worker threads.
+  class MeshSimplifier
+  {
+    /// \brief Build a simplified copy of a mesh.
+    /// \param[in] _mesh Mesh to simplify.
+    /// \param[in] _ratio Fraction of the triangles to keep, in (0, 1].
+    /// \return Simplified mesh, null if the mesh has no triangles.
+    public: static std::unique_ptr<common::Mesh> Simplify(
+        const common::Mesh &_mesh, const double _ratio);
+
+    /// \brief Count the triangles of a mesh.
+    /// \param[in] _mesh Mesh.
+    /// \return Number of triangles in its triangle list submeshes.
+    public: static std::size_t TriangleCount(const common::Mesh &_mesh);
+  };
+}
+}
+}
+
+#endif
@@ -0,0 +1,340 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <map>
+#include <utility>
+
+#include <gz/common/Mesh.hh>
+#include <gz/common/SubMesh.hh>
+#include <gz/math/Vector3.hh>
+
+#include "gz/gui/config.hh"
+
+#include "MeshSimplifier.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+namespace
+{
+  /// \brief Make a flat square grid on the XY plane, with an open border.
+  /// \param[in] _cells Number of cells along each side.
+  /// \return Mesh with two triangles per cell.
+  common::Mesh Grid(const int _cells)
+  {
+    common::SubMesh subMesh("grid");
+    subMesh.SetPrimitiveType(common::SubMesh::TRIANGLES);
+    for (int y = 0; y <= _cells; ++y)
+    {
+      for (int x = 0; x <= _cells; ++x)
+        subMesh.AddVertex(math::Vector3d(x, y, 0.0));
+    }
+    for (int y = 0; y < _cells; ++y)
+    {
+      for (int x = 0; x < _cells; ++x)
+      {
+        const unsigned int a = y * (_cells + 1) + x;
+        const unsigned int b = a + 1;
+        const unsigned int c = a + _cells + 1;
+        const unsigned int d = c + 1;
+        for (const unsigned int index : {a, b, d, a, d, c})
+          subMesh.AddIndex(index);
+      }
+    }
+
+    common::Mesh mesh;
+    mesh.AddSubMesh(subMesh);
+    return mesh;
+  }
+
+  /// \brief Make a closed sphere with a vertex per triangle corner, like an
+  /// STL file.
+  /// \param[in] _rings Number of rings between the poles.
+  /// \param[in] _segments Number of segments around the poles.
+  /// \return Mesh of a unit sphere centered at the origin.
+  common::Mesh Sphere(const int _rings, const int _segments)
+  {
+    auto point = [&](const int _ring, const int _segment)
+    {
+      // Poles are exactly on the axis, so that their vertices are welded
+      if (_ring == 0)
+        return math::Vector3d(0.0, 0.0, 1.0);
+      if (_ring == _rings)
+        return math::Vector3d(0.0, 0.0, -1.0);
+      const double theta = M_PI * _ring / _rings;
+      const double phi = 2.0 * M_PI * (_segment % _segments) / _segments;
+      return math::Vector3d(std::sin(theta) * std::cos(phi),
+          std::sin(theta) * std::sin(phi), std::cos(theta));
+    };
+
+    common::SubMesh subMesh("sphere");
+    subMesh.SetPrimitiveType(common::SubMesh::TRIANGLES);
+    auto add = [&subMesh](const math::Vector3d &_a,
+        const math::Vector3d &_b, const math::Vector3d &_c)
+    {
+      for (const auto &v : {_a, _b, _c})
+      {
+        subMesh.AddIndex(subMesh.VertexCount());
+        subMesh.AddVertex(v);
+      }
+    };
+    for (int r = 0; r < _rings; ++r)
+    {
+      for (int s = 0; s < _segments; ++s)
+      {
+        // Counterclockwise seen from outside
+        if (r > 0)
+          add(point(r, s), point(r + 1, s), point(r, s + 1));
+        if (r + 1 < _rings)
+          add(point(r, s + 1), point(r + 1, s), point(r + 1, s + 1));
+      }
+    }
+
+    common::Mesh mesh;
+    mesh.AddSubMesh(subMesh);
+    return mesh;
+  }
+
+  /// \brief Make two square grids folded at a right angle along the X
+  /// axis, a floor facing +Z and a wall facing -Y, with a normal per
+  /// vertex. Vertices on the fold are duplicated, one per grid.
+  /// \param[in] _cells Number of cells along each side of each grid.
+  /// \return Mesh with two triangles per cell.
+  common::Mesh Fold(const int _cells)
+  {
+    common::SubMesh subMesh("fold");
+    subMesh.SetPrimitiveType(common::SubMesh::TRIANGLES);
+    auto grid = [&](const math::Vector3d &_u, const math::Vector3d &_v)
+    {
+      const unsigned int first = subMesh.VertexCount();
+      const auto normal = _u.Cross(_v);
+      for (int y = 0; y <= _cells; ++y)
+      {
+        for (int x = 0; x <= _cells; ++x)
+        {
+          subMesh.AddVertex(_u * x + _v * y);
+          subMesh.AddNormal(normal);
+        }
+      }
+      for (int y = 0; y < _cells; ++y)
+      {
+        for (int x = 0; x < _cells; ++x)
+        {
+          const unsigned int a = first + y * (_cells + 1) + x;
+          const unsigned int b = a + 1;
+          const unsigned int c = a + _cells + 1;
+          const unsigned int d = c + 1;
+          for (const unsigned int index : {a, b, d, a, d, c})
+            subMesh.AddIndex(index);
+        }
+      }
+    };
+    grid(math::Vector3d::UnitX, math::Vector3d::UnitY);
+    grid(math::Vector3d::UnitX, math::Vector3d::UnitZ);
+
+    common::Mesh mesh;
+    mesh.AddSubMesh(subMesh);
+    return mesh;
+  }
+
+  /// \brief Get the normal of a triangle of a submesh.
+  /// \param[in] _subMesh Submesh.
+  /// \param[in] _triangle Triangle index.
+  /// \return Unnormalized normal.
+  math::Vector3d Normal(const common::SubMesh &_subMesh,
+      const unsigned int _triangle)
+  {
+    const auto a = _subMesh.Vertex(_subMesh.Index(3 * _triangle));
+    const auto b = _subMesh.Vertex(_subMesh.Index(3 * _triangle + 1));
+    const auto c = _subMesh.Vertex(_subMesh.Index(3 * _triangle + 2));
+    return (b - a).Cross(c - a);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(MeshSimplifierTest, TriangleCount)
+{
+  auto sphere = Sphere(16, 32);
+  const std::size_t count = MeshSimplifier::TriangleCount(sphere);
+  EXPECT_EQ(2u * 15u * 32u, count);
+
+  for (const double ratio : {0.5, 0.25, 0.1})
+  {
+    auto simplified = MeshSimplifier::Simplify(sphere, ratio);
+    ASSERT_NE(nullptr, simplified);
+    ASSERT_EQ(1u, simplified->SubMeshCount());
+    const std::size_t target = static_cast<std::size_t>(count * ratio);
+    EXPECT_LE(MeshSimplifier::TriangleCount(*simplified), target);
+    EXPECT_GE(MeshSimplifier::TriangleCount(*simplified), target - 2u);
+
+    // Each vertex has a normal
+    auto subMesh = simplified->SubMeshByIndex(0u).lock();
+    ASSERT_NE(nullptr, subMesh);
+    EXPECT_EQ(subMesh->VertexCount(), subMesh->NormalCount());
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(MeshSimplifierTest, NoFlips)
+{
+  auto simplified = MeshSimplifier::Simplify(Sphere(16, 32), 0.1);
+  ASSERT_NE(nullptr, simplified);
+  auto subMesh = simplified->SubMeshByIndex(0u).lock();
+  ASSERT_NE(nullptr, subMesh);
+
+  // All triangles of the sphere still face outwards
+  for (unsigned int t = 0u; t < subMesh->IndexCount() / 3u; ++t)
+  {
+    const auto centroid = (subMesh->Vertex(subMesh->Index(3 * t)) +
+        subMesh->Vertex(subMesh->Index(3 * t + 1)) +
+        subMesh->Vertex(subMesh->Index(3 * t + 2))) / 3.0;
+    EXPECT_GT(Normal(*subMesh, t).Dot(centroid), 0.0) << t;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(MeshSimplifierTest, Border)
+{
+  const int cells = 16;
+  auto simplified = MeshSimplifier::Simplify(Grid(cells), 0.25);
+  ASSERT_NE(nullptr, simplified);
+  auto subMesh = simplified->SubMeshByIndex(0u).lock();
+  ASSERT_NE(nullptr, subMesh);
+  EXPECT_LE(subMesh->IndexCount() / 3u, 2u * cells * cells / 4u);
+
+  // Edges with a single triangle are on the border
+  std::map<std::pair<unsigned int, unsigned int>, int> edges;
+  for (unsigned int t = 0u; t < subMesh->IndexCount() / 3u; ++t)
+  {
+    EXPECT_GT(Normal(*subMesh, t).Z(), 0.0);
+    for (unsigned int j = 0u; j < 3u; ++j)
+    {
+      const unsigned int a = subMesh->Index(3 * t + j);
+      const unsigned int b = subMesh->Index(3 * t + (j + 1) % 3);
+      ++edges[{std::min(a, b), std::max(a, b)}];
+    }
+  }
+
+  // Border edges stay on the sides of the square, so the outline doesn't
+  // shrink
+  auto side = [&](const math::Vector3d &_a, const math::Vector3d &_b)
+  {
+    return (_a.X() == 0.0 && _b.X() == 0.0) ||
+        (_a.X() == cells && _b.X() == cells) ||
+        (_a.Y() == 0.0 && _b.Y() == 0.0) ||
+        (_a.Y() == cells && _b.Y() == cells);
+  };
+  double perimeter{0.0};
+  for (const auto &edge : edges)
+  {
+    if (edge.second != 1)
+      continue;
+    const auto a = subMesh->Vertex(edge.first.first);
+    const auto b = subMesh->Vertex(edge.first.second);
+    EXPECT_TRUE(side(a, b)) << a << " " << b;
+    perimeter += (b - a).Length();
+  }
+  EXPECT_DOUBLE_EQ(4.0 * cells, perimeter);
+
+  for (unsigned int i = 0u; i < subMesh->VertexCount(); ++i)
+    EXPECT_DOUBLE_EQ(0.0, subMesh->Vertex(i).Z());
+}
+
+/////////////////////////////////////////////////
+TEST(MeshSimplifierTest, HardEdges)
+{
+  const int cells = 16;
+  auto simplified = MeshSimplifier::Simplify(Fold(cells), 0.25);
+  ASSERT_NE(nullptr, simplified);
+  auto subMesh = simplified->SubMeshByIndex(0u).lock();
+  ASSERT_NE(nullptr, subMesh);
+  EXPECT_LE(subMesh->IndexCount() / 3u, 4u * cells * cells / 4u);
+  ASSERT_EQ(subMesh->VertexCount(), subMesh->NormalCount());
+
+  // The fold isn't welded, so each triangle stays on its grid and keeps
+  // the grid's normal at all its vertices
+  for (unsigned int t = 0u; t < subMesh->IndexCount() / 3u; ++t)
+  {
+    auto normal = Normal(*subMesh, t);
+    normal.Normalize();
+    for (unsigned int j = 0u; j < 3u; ++j)
+    {
+      const unsigned int index = subMesh->Index(3 * t + j);
+      EXPECT_EQ(normal, subMesh->Normal(index)) << t;
+      if (normal == math::Vector3d::UnitZ)
+        EXPECT_DOUBLE_EQ(0.0, subMesh->Vertex(index).Z());
+      else
+        EXPECT_DOUBLE_EQ(0.0, subMesh->Vertex(index).Y());
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(MeshSimplifierTest, Unchanged)
+{
+  // Too small to be simplified
+  auto grid = Grid(1);
+  auto simplified = MeshSimplifier::Simplify(grid, 0.25);
+  ASSERT_NE(nullptr, simplified);
+  auto original = grid.SubMeshByIndex(0u).lock();
+  auto subMesh = simplified->SubMeshByIndex(0u).lock();
+  ASSERT_NE(nullptr, subMesh);
+  ASSERT_EQ(original->VertexCount(), subMesh->VertexCount());
+  ASSERT_EQ(original->IndexCount(), subMesh->IndexCount());
+  for (unsigned int i = 0u; i < subMesh->VertexCount(); ++i)
+    EXPECT_EQ(original->Vertex(i), subMesh->Vertex(i));
+  for (unsigned int i = 0u; i < subMesh->IndexCount(); ++i)
+    EXPECT_EQ(original->Index(i), subMesh->Index(i));
+
+  // Degenerate triangles
+  common::SubMesh degenerate("degenerate");
+  degenerate.SetPrimitiveType(common::SubMesh::TRIANGLES);
+  degenerate.AddVertex(math::Vector3d(0.0, 0.0, 0.0));
+  degenerate.AddVertex(math::Vector3d(1.0, 0.0, 0.0));
+  for (const unsigned int index : {0u, 1u, 1u, 0u, 0u, 0u})
+    degenerate.AddIndex(index);
+  common::Mesh mesh;
+  mesh.AddSubMesh(degenerate);
+  simplified = MeshSimplifier::Simplify(mesh, 0.25);
+  ASSERT_NE(nullptr, simplified);
+  subMesh = simplified->SubMeshByIndex(0u).lock();
+  ASSERT_NE(nullptr, subMesh);
+  EXPECT_EQ(2u, subMesh->VertexCount());
+  EXPECT_EQ(6u, subMesh->IndexCount());
+
+  // Other primitives are copied
+  common::SubMesh points("points");
+  points.SetPrimitiveType(common::SubMesh::POINTS);
+  points.AddVertex(math::Vector3d(1.0, 2.0, 3.0));
+  mesh.AddSubMesh(points);
+  simplified = MeshSimplifier::Simplify(mesh, 0.25);
+  ASSERT_NE(nullptr, simplified);
+  ASSERT_EQ(2u, simplified->SubMeshCount());
+  subMesh = simplified->SubMeshByIndex(1u).lock();
+  ASSERT_NE(nullptr, subMesh);
+  EXPECT_EQ(common::SubMesh::POINTS, subMesh->SubMeshPrimitiveType());
+  EXPECT_EQ(math::Vector3d(1.0, 2.0, 3.0), subMesh->Vertex(0u));
+
+  // No triangles at all
+  common::Mesh empty;
+  empty.AddSubMesh(points);
+  EXPECT_EQ(nullptr, MeshSimplifier::Simplify(empty, 0.25));
+}
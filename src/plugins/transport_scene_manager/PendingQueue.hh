@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_TRANSPORTSCENEMANAGER_PENDINGQUEUE_HH_
+#define GZ_GUI_PLUGINS_TRANSPORTSCENEMANAGER_PENDINGQUEUE_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  /// \brief Entities waiting to be loaded, at most one per id, which are
+  /// taken in priority order.
+  ///
+  /// Removing an entity is O(1): its entry stays in the queue but is
+  /// skipped when it's reached. Each entry is tagged with a generation, so
+  /// that if an entity is removed and queued again with the same id, only
+  /// its latest entry is taken.
+  /// \tparam T Entity data.
+  template <typename T>
+  class PendingQueue
+  {
+    /// \brief Queue an entity, unless one with the same id is queued.
+    /// \param[in] _id Entity id.
+    /// \param[in] _value Entity data.
+    /// \return False if an entity with the same id is already queued.
+    public: bool Push(const unsigned int _id, T _value)
+    {
+      const uint64_t generation = ++this->generation;
+      if (!this->generations.emplace(_id, generation).second)
+        return false;
+
+      this->entries.push_back({std::move(_value), _id, generation, 0.0});
+      return true;
+    }
+
+    /// \brief Remove an entity from the queue.
+    /// \param[in] _id Entity id.
+    /// \return True if the entity was queued.
+    public: bool Remove(const unsigned int _id)
+    {
+      return this->generations.erase(_id) > 0u;
+    }
+
+    /// \brief Whether an entity is queued.
+    /// \param[in] _id Entity id.
+    /// \return True if the entity is queued.
+    public: bool Contains(const unsigned int _id) const
+    {
+      return this->generations.count(_id) > 0u;
+    }
+
+    /// \brief Whether no entity is queued.
+    /// \return True if the queue is empty.
+    public: bool Empty() const
+    {
+      return this->generations.empty();
+    }
+
+    /// \brief Sort the queue, dropping the entries of removed entities.
+    /// \param[in] _priority Function returning the priority of an entity.
+    /// Entities with lower values are taken first.
+    /// \tparam F Callable taking a const T & and returning a double.
+    public: template <typename F>
+    void Sort(F _priority)
+    {
+      this->entries.erase(std::remove_if(this->entries.begin(),
+          this->entries.end(), [this](const Entry &_entry)
+          {
+            return !this->Live(_entry);
+          }), this->entries.end());
+
+      for (auto &entry : this->entries)
+        entry.priority = _priority(static_cast<const T &>(entry.value));
+
+      // The entry taken first is at the back
+      std::sort(this->entries.begin(), this->entries.end(),
+          [](const Entry &_a, const Entry &_b)
+          {
+            return _a.priority > _b.priority;
+          });
+    }
+
+    /// \brief Take the next entity.
+    /// \param[out] _value Entity data.
+    /// \return False if the queue is empty.
+    public: bool Pop(T &_value)
+    {
+      while (!this->entries.empty())
+      {
+        Entry entry = std::move(this->entries.back());
+        this->entries.pop_back();
+        if (!this->Live(entry))
+          continue;
+
+        this->generations.erase(entry.id);
+        _value = std::move(entry.value);
+        return true;
+      }
+      return false;
+    }
+
+    /// \brief Release the memory of the queue if it's empty.
+    public: void ShrinkToFit()
+    {
+      if (!this->Empty())
+        return;
+      this->entries.clear();
+      this->entries.shrink_to_fit();
+    }
+
+    /// \brief Queued entity.
+    private: struct Entry
+    {
+      /// \brief Entity data.
+      T value;
+
+      /// \brief Entity id.
+      unsigned int id;
+
+      /// \brief Generation of the entry.
+      uint64_t generation;
+
+      /// \brief Priority when the queue was last sorted.
+      double priority;
+    };
+
+    /// \brief Whether an entry is the latest one of its entity.
+    /// \param[in] _entry Entry.
+    /// \return False if its entity was removed since it was queued.
+    private: bool Live(const Entry &_entry) const
+    {
+      auto it = this->generations.find(_entry.id);
+      return it != this->generations.end() &&
+          it->second == _entry.generation;
+    }
+
+    /// \brief Queued entries, including the ones of removed entities.
+    private: std::vector<Entry> entries;
+
+    /// \brief Generation of the latest entry of each queued entity.
+    private: std::unordered_map<unsigned int, uint64_t> generations;
+
+    /// \brief Generation of the last queued entry.
+    private: uint64_t generation{0u};
+  };
+}
+}
+}
+
+#endif
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "gz/gui/config.hh"
+
+#include "PendingQueue.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+TEST(PendingQueueTest, Priority)
+{
+  PendingQueue<double> queue;
+  EXPECT_TRUE(queue.Empty());
+  EXPECT_TRUE(queue.Push(1u, 3.0));
+  EXPECT_TRUE(queue.Push(2u, 1.0));
+  EXPECT_TRUE(queue.Push(3u, 2.0));
+  EXPECT_FALSE(queue.Push(2u, 0.0));
+  EXPECT_TRUE(queue.Contains(2u));
+  EXPECT_FALSE(queue.Empty());
+
+  queue.Sort([](const double _value) { return _value; });
+
+  double value;
+  ASSERT_TRUE(queue.Pop(value));
+  EXPECT_DOUBLE_EQ(1.0, value);
+  EXPECT_FALSE(queue.Contains(2u));
+  ASSERT_TRUE(queue.Pop(value));
+  EXPECT_DOUBLE_EQ(2.0, value);
+  ASSERT_TRUE(queue.Pop(value));
+  EXPECT_DOUBLE_EQ(3.0, value);
+  EXPECT_FALSE(queue.Pop(value));
+  EXPECT_TRUE(queue.Empty());
+}
+
+/////////////////////////////////////////////////
+TEST(PendingQueueTest, Remove)
+{
+  PendingQueue<std::string> queue;
+  queue.Push(1u, "one");
+  queue.Push(2u, "two");
+  EXPECT_TRUE(queue.Remove(1u));
+  EXPECT_FALSE(queue.Remove(1u));
+  EXPECT_FALSE(queue.Contains(1u));
+
+  std::string value;
+  ASSERT_TRUE(queue.Pop(value));
+  EXPECT_EQ("two", value);
+  EXPECT_FALSE(queue.Pop(value));
+  EXPECT_FALSE(queue.Remove(0u));
+  queue.ShrinkToFit();
+  EXPECT_TRUE(queue.Empty());
+}
+
+/////////////////////////////////////////////////
+TEST(PendingQueueTest, DeleteThenRequeue)
+{
+  // An entity is deleted while queued, then queued again with the same id
+  // from a newer scene msg. Its old entry is nearer, so it's sorted first.
+  PendingQueue<std::string> queue;
+  queue.Push(1u, "old");
+  queue.Push(2u, "other");
+  EXPECT_TRUE(queue.Remove(1u));
+  EXPECT_TRUE(queue.Push(1u, "new"));
+
+  std::string value;
+  ASSERT_TRUE(queue.Pop(value));
+  EXPECT_EQ("new", value);
+  ASSERT_TRUE(queue.Pop(value));
+  EXPECT_EQ("other", value);
+  EXPECT_FALSE(queue.Pop(value));
+
+  // Same once the queue is sorted, with the old entry taken first
+  queue.Push(1u, "old");
+  queue.Push(2u, "other");
+  queue.Remove(1u);
+  queue.Push(1u, "new");
+  queue.Sort([](const std::string &_value)
+  {
+    return _value == "old" ? 0.0 : _value == "new" ? 2.0 : 1.0;
+  });
+  ASSERT_TRUE(queue.Pop(value));
+  EXPECT_EQ("other", value);
+  ASSERT_TRUE(queue.Pop(value));
+  EXPECT_EQ("new", value);
+  EXPECT_FALSE(queue.Pop(value));
+}
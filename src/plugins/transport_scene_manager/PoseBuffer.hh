@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_TRANSPORTSCENEMANAGER_POSEBUFFER_HH_
+#define GZ_GUI_PLUGINS_TRANSPORTSCENEMANAGER_POSEBUFFER_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <unordered_map>
+
+#include "gz/gui/PoseFrame.hh"
+
+#include "TripleBuffer.hh"
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  /// \brief Lock-free handoff of entity poses from one writer thread to one
+  /// reader thread, see TripleBuffer.
+  ///
+  /// Pose messages can be partial: a world may publish static and dynamic
+  /// entities separately, or throttle a subset of them. So instead of
+  /// dropping frames which the reader didn't take, each published frame
+  /// is merged per entity into the poses published since the reader last
+  /// consumed. The reader therefore gets the latest pose of every entity
+  /// which moved since its previous frame. Merged poses take the stamp of
+  /// the latest frame.
+  class PoseBuffer
+  {
+    /// \brief Get the frame to be filled by the writer. Only to be called
+    /// from the writer thread.
+    /// \return Frame, holding stale data.
+    public: PoseFrame &Back()
+    {
+      return this->incoming;
+    }
+
+    /// \brief Merge the frame filled through Back() into the poses not
+    /// consumed yet, and make them available to the reader. Only to be
+    /// called from the writer thread.
+    public: void Publish()
+    {
+      // The reader took everything merged so far. If it takes the last
+      // frame right after this check, the poses it took are published
+      // again, which is harmless since they're still the latest ones.
+      if (!this->buffer.Pending())
+      {
+        this->merged.Clear();
+        this->slots.clear();
+      }
+
+      for (std::size_t i = 0u; i < this->incoming.Size(); ++i)
+      {
+        const auto slot = this->slots.emplace(this->incoming.ids[i],
+            this->merged.Size());
+        const double *p = &this->incoming.positions[i * 3];
+        const double *q = &this->incoming.orientations[i * 4];
+        if (slot.second)
+        {
+          this->merged.Add(this->incoming.ids[i], p[0], p[1], p[2],
+              q[0], q[1], q[2], q[3]);
+          continue;
+        }
+
+        const std::size_t j = slot.first->second;
+        std::copy(p, p + 3, &this->merged.positions[j * 3]);
+        std::copy(q, q + 4, &this->merged.orientations[j * 4]);
+      }
+      this->merged.hasStamp = this->incoming.hasStamp;
+      this->merged.stamp = this->incoming.stamp;
+      this->merged.received = this->incoming.received;
+
+      // Copy assignment reuses the capacity of the recycled buffer
+      this->buffer.Back() = this->merged;
+      this->buffer.Publish();
+    }
+
+    /// \brief Swap in the latest poses, if there are new ones. Only to be
+    /// called from the reader thread.
+    /// \return True if new poses are available through Front().
+    public: bool Consume()
+    {
+      return this->buffer.Consume();
+    }
+
+    /// \brief Get the poses last swapped in by Consume(). Only to be called
+    /// from the reader thread.
+    /// \return Latest pose of each entity which moved since the previous
+    /// call to Consume().
+    public: const PoseFrame &Front()
+    {
+      return this->buffer.Front();
+    }
+
+    /// \brief Frame being filled by the writer.
+    private: PoseFrame incoming;
+
+    /// \brief Poses published since the reader last consumed.
+    private: PoseFrame merged;
+
+    /// \brief Index of each entity's pose in the merged frame.
+    private: std::unordered_map<unsigned int, std::size_t> slots;
+
+    /// \brief Handoff of merged frames.
+    private: TripleBuffer<PoseFrame> buffer;
+  };
+}
+}
+}
+
+#endif
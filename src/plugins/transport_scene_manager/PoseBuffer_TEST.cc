@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <map>
+#include <utility>
+
+#include "gz/gui/config.hh"
+
+#include "PoseBuffer.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+namespace
+{
+  /// \brief Get the X position of each entity of a frame.
+  /// \param[in] _frame Frame.
+  /// \return X position of each entity id.
+  std::map<unsigned int, double> Positions(const PoseFrame &_frame)
+  {
+    std::map<unsigned int, double> result;
+    for (std::size_t i = 0u; i < _frame.Size(); ++i)
+      result[_frame.ids[i]] = _frame.positions[i * 3];
+    return result;
+  }
+
+  /// \brief Publish a frame with one pose per entity.
+  /// \param[in] _buffer Buffer.
+  /// \param[in] _poses X position of each entity id.
+  void Publish(PoseBuffer &_buffer,
+      const std::map<unsigned int, double> &_poses)
+  {
+    auto &frame = _buffer.Back();
+    frame.Clear();
+    for (const auto &pose : _poses)
+      frame.Add(pose.first, pose.second, 0, 0, 1, 0, 0, 0);
+    _buffer.Publish();
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(PoseBufferTest, DisjointPartialFrames)
+{
+  PoseBuffer buffer;
+  EXPECT_FALSE(buffer.Consume());
+
+  // Static and dynamic entities published separately before one render
+  Publish(buffer, {{1u, 1.0}, {2u, 2.0}});
+  Publish(buffer, {{3u, 3.0}});
+
+  ASSERT_TRUE(buffer.Consume());
+  const std::map<unsigned int, double> expected{
+      {1u, 1.0}, {2u, 2.0}, {3u, 3.0}};
+  EXPECT_EQ(expected, Positions(buffer.Front()));
+  EXPECT_FALSE(buffer.Consume());
+}
+
+/////////////////////////////////////////////////
+TEST(PoseBufferTest, LatestPoseWins)
+{
+  PoseBuffer buffer;
+  Publish(buffer, {{1u, 1.0}, {2u, 2.0}});
+  Publish(buffer, {{2u, 20.0}});
+  Publish(buffer, {{1u, 10.0}, {4u, 4.0}});
+
+  ASSERT_TRUE(buffer.Consume());
+  const std::map<unsigned int, double> expected{
+      {1u, 10.0}, {2u, 20.0}, {4u, 4.0}};
+  EXPECT_EQ(expected, Positions(buffer.Front()));
+  EXPECT_EQ(3u, buffer.Front().Size());
+}
+
+/////////////////////////////////////////////////
+TEST(PoseBufferTest, ConsumedPosesAreNotRepeated)
+{
+  PoseBuffer buffer;
+  Publish(buffer, {{1u, 1.0}, {2u, 2.0}});
+  ASSERT_TRUE(buffer.Consume());
+
+  // Only entities which moved since the last render are handed over
+  Publish(buffer, {{2u, 3.0}});
+  ASSERT_TRUE(buffer.Consume());
+  const std::map<unsigned int, double> expected{{2u, 3.0}};
+  EXPECT_EQ(expected, Positions(buffer.Front()));
+}
+
+/////////////////////////////////////////////////
+TEST(PoseBufferTest, Stamp)
+{
+  PoseBuffer buffer;
+  auto &frame = buffer.Back();
+  frame.Clear();
+  frame.Add(1u, 1, 0, 0, 1, 0, 0, 0);
+  frame.hasStamp = true;
+  frame.stamp = std::chrono::seconds(1);
+  buffer.Publish();
+
+  auto &next = buffer.Back();
+  next.Clear();
+  next.Add(2u, 1, 0, 0, 1, 0, 0, 0);
+  next.hasStamp = true;
+  next.stamp = std::chrono::seconds(2);
+  buffer.Publish();
+
+  // Merged poses take the latest stamp
+  ASSERT_TRUE(buffer.Consume());
+  EXPECT_TRUE(buffer.Front().hasStamp);
+  EXPECT_EQ(std::chrono::seconds(2), buffer.Front().stamp);
+  EXPECT_EQ(2u, buffer.Front().Size());
+}
@@ -0,0 +1,806 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <sstream>
+#include <thread>
+
+#include <sys/stat.h>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/Material.hh>
+#include <gz/common/Pbr.hh>
+#include <gz/common/SubMesh.hh>
+#include <gz/common/Util.hh>
+#include <gz/math/Color.hh>
+#include <gz/math/Vector2.hh>
+#include <gz/math/Vector3.hh>
+
+#include "SceneCache.hh"
+
+namespace
+{
+  /// \brief Appends binary values to a buffer.
+  class Writer
+  {
+    /// \brief Append a trivially copyable value.
+    /// \param[in] _value Value to append.
+    public: template <typename T>
+    void Put(const T &_value)
+    {
+      this->data.append(reinterpret_cast<const char *>(&_value), sizeof(T));
+    }
+
+    /// \brief Append a string, prefixed with its size.
+    /// \param[in] _value String to append.
+    public: void PutString(const std::string &_value)
+    {
+      this->Put(static_cast<uint64_t>(_value.size()));
+      this->data.append(_value);
+    }
+
+    /// \brief Written data.
+    public: std::string data;
+  };
+
+  /// \brief Reads binary values from a buffer, failing instead of reading
+  /// past its end.
+  class Reader
+  {
+    /// \brief Constructor.
+    /// \param[in] _data Buffer to read, which must outlive the reader.
+    public: explicit Reader(const std::string &_data)
+      : p(_data.data()), end(_data.data() + _data.size())
+    {
+    }
+
+    /// \brief Read a trivially copyable value.
+    /// \param[out] _value Value read.
+    /// \return False if the buffer is too short.
+    public: template <typename T>
+    bool Get(T &_value)
+    {
+      if (static_cast<std::size_t>(this->end - this->p) < sizeof(T))
+        return false;
+      std::memcpy(&_value, this->p, sizeof(T));
+      this->p += sizeof(T);
+      return true;
+    }
+
+    /// \brief Read a string prefixed with its size.
+    /// \param[out] _value String read.
+    /// \return False if the buffer is too short.
+    public: bool GetString(std::string &_value)
+    {
+      uint64_t size;
+      if (!this->Get(size) ||
+          size > static_cast<uint64_t>(this->end - this->p))
+      {
+        return false;
+      }
+      _value.assign(this->p, size);
+      this->p += size;
+      return true;
+    }
+
+    /// \brief Check that a count of elements of a given size fits in the
+    /// rest of the buffer, so corrupt counts don't cause huge allocations.
+    /// \param[in] _count Number of elements.
+    /// \param[in] _size Minimum size of each element in bytes.
+    /// \return True if the elements may fit.
+    public: bool Fits(const uint64_t _count, const std::size_t _size) const
+    {
+      return _count <= static_cast<uint64_t>(this->end - this->p) / _size;
+    }
+
+    /// \brief True if the whole buffer was read.
+    /// \return True at the end of the buffer.
+    public: bool Done() const
+    {
+      return this->p == this->end;
+    }
+
+    /// \brief Read position.
+    private: const char *p;
+
+    /// \brief End of the buffer.
+    private: const char *end;
+  };
+
+  /// \brief Magic number of scene files.
+  const char kSceneMagic[] = "GZSC";
+
+  /// \brief Magic number of mesh files.
+  const char kMeshMagic[] = "GZMC";
+
+  /// \brief Read a whole file.
+  /// \param[in] _path File path.
+  /// \param[out] _data File contents.
+  /// \return False if the file couldn't be read.
+  bool ReadFile(const std::string &_path, std::string &_data)
+  {
+    std::ifstream file(_path, std::ios::binary);
+    if (!file)
+      return false;
+    _data.assign(std::istreambuf_iterator<char>(file),
+        std::istreambuf_iterator<char>());
+    return !file.bad();
+  }
+
+  /// \brief Get the size and modification time of a file.
+  /// \param[in] _path File path.
+  /// \param[out] _size File size in bytes.
+  /// \param[out] _mtime Modification time in nanoseconds, so that files
+  /// edited twice within a second are told apart. Windows only has seconds.
+  /// \return False if the file doesn't exist.
+  bool StatFile(const std::string &_path, uint64_t &_size, int64_t &_mtime)
+  {
+    struct stat buf;
+    if (stat(_path.c_str(), &buf) != 0)
+      return false;
+    _size = static_cast<uint64_t>(buf.st_size);
+#if defined(_WIN32)
+    _mtime = static_cast<int64_t>(buf.st_mtime) * 1000000000;
+#elif defined(__APPLE__)
+    _mtime = static_cast<int64_t>(buf.st_mtimespec.tv_sec) * 1000000000 +
+        buf.st_mtimespec.tv_nsec;
+#else
+    _mtime = static_cast<int64_t>(buf.st_mtim.tv_sec) * 1000000000 +
+        buf.st_mtim.tv_nsec;
+#endif
+    return true;
+  }
+
+  /// \brief Write a whole file, through a temporary file which is renamed
+  /// once complete.
+  /// \param[in] _path File path.
+  /// \param[in] _data File contents.
+  /// \return False if the file couldn't be written.
+  bool WriteFile(const std::string &_path, const std::string &_data)
+  {
+    std::ostringstream tmp;
+    tmp << _path << ".tmp" << std::hash<std::thread::id>()(
+        std::this_thread::get_id());
+    {
+      std::ofstream file(tmp.str(), std::ios::binary | std::ios::trunc);
+      if (!file)
+        return false;
+      file.write(_data.data(), static_cast<std::streamsize>(_data.size()));
+      if (!file)
+      {
+        file.close();
+        std::remove(tmp.str().c_str());
+        return false;
+      }
+    }
+
+    // Renaming over an existing file fails on some platforms
+    if (std::rename(tmp.str().c_str(), _path.c_str()) != 0)
+    {
+      std::remove(_path.c_str());
+      if (std::rename(tmp.str().c_str(), _path.c_str()) != 0)
+      {
+        std::remove(tmp.str().c_str());
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// \brief Write the magic number and version at the start of a file.
+  /// \param[in] _magic Magic number.
+  /// \param[out] _writer Writer of the file.
+  void PutHeader(const char *_magic, Writer &_writer)
+  {
+    _writer.data.append(_magic, 4u);
+    _writer.Put(ignition::gui::plugins::SceneCache::kVersion);
+  }
+
+  /// \brief Check the magic number and version at the start of a file.
+  /// \param[in] _magic Expected magic number.
+  /// \param[in,out] _reader Reader of the file, positioned after the
+  /// header on success.
+  /// \return False if the file isn't of the expected kind and version.
+  bool GetHeader(const char *_magic, Reader &_reader)
+  {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t expected;
+    std::memcpy(&expected, _magic, 4u);
+    return _reader.Get(magic) && magic == expected &&
+        _reader.Get(version) &&
+        version == ignition::gui::plugins::SceneCache::kVersion;
+  }
+
+  /// \brief Write a color.
+  /// \param[in] _color Color to write.
+  /// \param[out] _writer Writer.
+  void PutColor(const ignition::math::Color &_color, Writer &_writer)
+  {
+    _writer.Put(_color.R());
+    _writer.Put(_color.G());
+    _writer.Put(_color.B());
+    _writer.Put(_color.A());
+  }
+
+  /// \brief Read a color.
+  /// \param[out] _color Color read.
+  /// \param[in,out] _reader Reader.
+  /// \return False if the buffer is too short.
+  bool GetColor(ignition::math::Color &_color, Reader &_reader)
+  {
+    float rgba[4];
+    for (float &value : rgba)
+    {
+      if (!_reader.Get(value))
+        return false;
+    }
+    _color.Set(rgba[0], rgba[1], rgba[2], rgba[3]);
+    return true;
+  }
+
+  /// \brief Write a material, including its PBR properties.
+  /// \param[in] _material Material to write.
+  /// \param[out] _writer Writer.
+  void PutMaterial(const ignition::common::Material &_material,
+      Writer &_writer)
+  {
+    PutColor(_material.Ambient(), _writer);
+    PutColor(_material.Diffuse(), _writer);
+    PutColor(_material.Specular(), _writer);
+    PutColor(_material.Emissive(), _writer);
+    _writer.Put(_material.Transparency());
+    _writer.Put(_material.Shininess());
+    _writer.Put(static_cast<uint8_t>(_material.Lighting()));
+    _writer.PutString(_material.TextureImage());
+    _writer.Put(static_cast<uint8_t>(_material.TextureAlphaEnabled()));
+    _writer.Put(_material.AlphaThreshold());
+    _writer.Put(static_cast<uint8_t>(_material.TwoSidedEnabled()));
+    double srcFactor;
+    double dstFactor;
+    _material.BlendFactors(srcFactor, dstFactor);
+    _writer.Put(srcFactor);
+    _writer.Put(dstFactor);
+    _writer.Put(static_cast<uint32_t>(_material.Blend()));
+    _writer.Put(static_cast<uint32_t>(_material.Shade()));
+    _writer.Put(_material.PointSize());
+    _writer.Put(static_cast<uint8_t>(_material.DepthWrite()));
+    _writer.Put(static_cast<double>(_material.RenderOrder()));
+
+    const auto *pbr = _material.PbrMaterial();
+    _writer.Put(static_cast<uint8_t>(nullptr != pbr));
+    if (nullptr == pbr)
+      return;
+
+    _writer.Put(static_cast<uint32_t>(pbr->Type()));
+    _writer.PutString(pbr->AlbedoMap());
+    _writer.PutString(pbr->NormalMap());
+    _writer.Put(static_cast<uint32_t>(pbr->NormalMapType()));
+    _writer.PutString(pbr->RoughnessMap());
+    _writer.PutString(pbr->MetalnessMap());
+    _writer.PutString(pbr->EmissiveMap());
+    _writer.PutString(pbr->LightMap());
+    _writer.Put(static_cast<uint32_t>(pbr->LightMapTexCoordSet()));
+    _writer.PutString(pbr->EnvironmentMap());
+    _writer.PutString(pbr->AmbientOcclusionMap());
+    _writer.PutString(pbr->SpecularMap());
+    _writer.PutString(pbr->GlossinessMap());
+    _writer.Put(pbr->Roughness());
+    _writer.Put(pbr->Metalness());
+    _writer.Put(pbr->Glossiness());
+  }
+
+  /// \brief Read a material written by PutMaterial.
+  /// \param[in,out] _reader Reader.
+  /// \return Material read, null if the buffer is too short.
+  std::shared_ptr<ignition::common::Material> GetMaterial(Reader &_reader)
+  {
+    using ignition::common::Material;
+    using ignition::common::NormalMapSpace;
+    using ignition::common::Pbr;
+    using ignition::common::PbrType;
+
+    ignition::math::Color ambient;
+    ignition::math::Color diffuse;
+    ignition::math::Color specular;
+    ignition::math::Color emissive;
+    double transparency;
+    double shininess;
+    uint8_t lighting;
+    std::string texture;
+    uint8_t alphaFromTexture;
+    double alphaThreshold;
+    uint8_t twoSided;
+    double srcFactor;
+    double dstFactor;
+    uint32_t blendMode;
+    uint32_t shadeMode;
+    double pointSize;
+    uint8_t depthWrite;
+    double renderOrder;
+    uint8_t hasPbr;
+    if (!GetColor(ambient, _reader) || !GetColor(diffuse, _reader) ||
+        !GetColor(specular, _reader) || !GetColor(emissive, _reader) ||
+        !_reader.Get(transparency) || !_reader.Get(shininess) ||
+        !_reader.Get(lighting) || !_reader.GetString(texture) ||
+        !_reader.Get(alphaFromTexture) || !_reader.Get(alphaThreshold) ||
+        !_reader.Get(twoSided) || !_reader.Get(srcFactor) ||
+        !_reader.Get(dstFactor) || !_reader.Get(blendMode) ||
+        !_reader.Get(shadeMode) || !_reader.Get(pointSize) ||
+        !_reader.Get(depthWrite) || !_reader.Get(renderOrder) ||
+        !_reader.Get(hasPbr) ||
+        blendMode >= static_cast<uint32_t>(Material::BLEND_MODE_COUNT) ||
+        shadeMode >= static_cast<uint32_t>(Material::SHADE_COUNT))
+    {
+      return nullptr;
+    }
+
+    auto material = std::make_shared<Material>();
+    material->SetAmbient(ambient);
+    material->SetDiffuse(diffuse);
+    material->SetSpecular(specular);
+    material->SetEmissive(emissive);
+    material->SetTransparency(transparency);
+    material->SetShininess(shininess);
+    material->SetLighting(lighting != 0u);
+    if (!texture.empty())
+      material->SetTextureImage(texture);
+    material->SetAlphaFromTexture(alphaFromTexture != 0u, alphaThreshold,
+        twoSided != 0u);
+    material->SetBlendFactors(srcFactor, dstFactor);
+    material->SetBlendMode(static_cast<Material::BlendMode>(blendMode));
+    material->SetShadeMode(static_cast<Material::ShadeMode>(shadeMode));
+    material->SetPointSize(pointSize);
+    material->SetDepthWrite(depthWrite != 0u);
+    material->SetRenderOrder(renderOrder);
+    if (hasPbr == 0u)
+      return material;
+
+    uint32_t type;
+    std::string albedoMap;
+    std::string normalMap;
+    uint32_t normalMapType;
+    std::string roughnessMap;
+    std::string metalnessMap;
+    std::string emissiveMap;
+    std::string lightMap;
+    uint32_t lightMapTexCoordSet;
+    std::string environmentMap;
+    std::string ambientOcclusionMap;
+    std::string specularMap;
+    std::string glossinessMap;
+    double roughness;
+    double metalness;
+    double glossiness;
+    if (!_reader.Get(type) || !_reader.GetString(albedoMap) ||
+        !_reader.GetString(normalMap) || !_reader.Get(normalMapType) ||
+        !_reader.GetString(roughnessMap) ||
+        !_reader.GetString(metalnessMap) ||
+        !_reader.GetString(emissiveMap) || !_reader.GetString(lightMap) ||
+        !_reader.Get(lightMapTexCoordSet) ||
+        !_reader.GetString(environmentMap) ||
+        !_reader.GetString(ambientOcclusionMap) ||
+        !_reader.GetString(specularMap) ||
+        !_reader.GetString(glossinessMap) || !_reader.Get(roughness) ||
+        !_reader.Get(metalness) || !_reader.Get(glossiness) ||
+        type > static_cast<uint32_t>(PbrType::SPECULAR) ||
+        normalMapType > static_cast<uint32_t>(NormalMapSpace::OBJECT))
+    {
+      return nullptr;
+    }
+
+    Pbr pbr;
+    pbr.SetType(static_cast<PbrType>(type));
+    pbr.SetAlbedoMap(albedoMap);
+    pbr.SetNormalMap(normalMap, static_cast<NormalMapSpace>(normalMapType));
+    pbr.SetRoughnessMap(roughnessMap);
+    pbr.SetMetalnessMap(metalnessMap);
+    pbr.SetEmissiveMap(emissiveMap);
+    pbr.SetLightMap(lightMap, lightMapTexCoordSet);
+    pbr.SetEnvironmentMap(environmentMap);
+    pbr.SetAmbientOcclusionMap(ambientOcclusionMap);
+    pbr.SetSpecularMap(specularMap);
+    pbr.SetGlossinessMap(glossinessMap);
+    pbr.SetRoughness(roughness);
+    pbr.SetMetalness(metalness);
+    pbr.SetGlossiness(glossiness);
+    material->SetPbrMaterial(pbr);
+    return material;
+  }
+
+  /// \brief Write the pages of a scene one after the other, prefixed with
+  /// their total size. Parsing the result merges them.
+  /// \param[in] _pages Pages to write.
+  /// \param[out] _writer Writer.
+  /// \return False if a page couldn't be serialized.
+  bool PutScene(const std::vector<const ignition::msgs::Scene *> &_pages,
+      Writer &_writer)
+  {
+    uint64_t size{0u};
+    for (const auto *page : _pages)
+      size += page->ByteSizeLong();
+
+    _writer.Put(size);
+    _writer.data.reserve(_writer.data.size() + size);
+    for (const auto *page : _pages)
+    {
+      if (!page->AppendToString(&_writer.data))
+        return false;
+    }
+    return true;
+  }
+}
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+SceneCache::SceneCache(const std::string &_directory)
+  : directory(_directory)
+{
+  if (this->directory.empty())
+  {
+    std::string home;
+    common::env(IGN_HOMEDIR, home);
+    this->directory =
+        common::joinPaths(home, ".ignition", "gui", "scene_cache");
+  }
+
+  if (!common::exists(this->directory) &&
+      !common::createDirectories(this->directory))
+  {
+    ignerr << "Failed to create scene cache directory ["
+           << this->directory << "]" << std::endl;
+  }
+}
+
+/////////////////////////////////////////////////
+const std::string &SceneCache::Directory() const
+{
+  return this->directory;
+}
+
+/////////////////////////////////////////////////
+bool SceneCache::LoadScene(const std::string &_world,
+    msgs::Scene &_scene) const
+{
+  std::string data;
+  if (!ReadFile(this->Path(_world, ".scene"), data))
+    return false;
+
+  Reader reader(data);
+  std::string serialized;
+  if (!GetHeader(kSceneMagic, reader) ||
+      !reader.GetString(serialized) || !reader.Done() ||
+      !_scene.ParseFromString(serialized))
+  {
+    ignwarn << "Ignoring invalid cached scene of world [" << _world << "]"
+            << std::endl;
+    return false;
+  }
+
+  // Headers of the saved pages are merged, none of them apply anymore
+  _scene.clear_header();
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool SceneCache::SaveScene(const std::string &_world,
+    const msgs::Scene &_scene) const
+{
+  return this->SaveScene(_world, {std::shared_ptr<const msgs::Scene>(
+      std::shared_ptr<const msgs::Scene>(), &_scene)});
+}
+
+/////////////////////////////////////////////////
+bool SceneCache::SaveScene(const std::string &_world,
+    const std::vector<std::shared_ptr<const msgs::Scene>> &_pages) const
+{
+  std::vector<const msgs::Scene *> pages;
+  pages.reserve(_pages.size());
+  for (const auto &page : _pages)
+    pages.push_back(page.get());
+
+  Writer writer;
+  PutHeader(kSceneMagic, writer);
+  if (!PutScene(pages, writer))
+    return false;
+  if (!WriteFile(this->Path(_world, ".scene"), writer.data))
+  {
+    ignerr << "Failed to cache scene of world [" << _world << "]"
+           << std::endl;
+    return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::unique_ptr<common::Mesh> SceneCache::LoadMesh(
+    const std::string &_filename, const std::string &_fullname) const
+{
+  std::string data;
+  uint64_t size;
+  int64_t mtime;
+  if (!StatFile(_fullname, size, mtime) ||
+      !ReadFile(this->Path(_filename, ".mesh"), data))
+  {
+    return nullptr;
+  }
+
+  Reader reader(data);
+  uint64_t sourceSize;
+  int64_t sourceMtime;
+  uint64_t sourceHash;
+  if (!GetHeader(kMeshMagic, reader) || !reader.Get(sourceSize) ||
+      !reader.Get(sourceMtime) || !reader.Get(sourceHash) ||
+      sourceSize != size)
+  {
+    return nullptr;
+  }
+
+  // Sources which were only touched, by a checkout for example, are hashed
+  // to check that they didn't change
+  if (sourceMtime != mtime)
+  {
+    uint64_t hash;
+    if (!this->SourceHash(_fullname, size, mtime, hash) || hash != sourceHash)
+      return nullptr;
+  }
+
+  auto mesh = std::make_unique<common::Mesh>();
+  mesh->SetName(_filename);
+
+  uint32_t materialCount;
+  if (!reader.Get(materialCount))
+    return nullptr;
+  for (uint32_t i = 0u; i < materialCount; ++i)
+  {
+    auto material = GetMaterial(reader);
+    if (nullptr == material)
+      return nullptr;
+    mesh->AddMaterial(material);
+  }
+
+  uint32_t subMeshCount;
+  if (!reader.Get(subMeshCount))
+    return nullptr;
+  for (uint32_t i = 0u; i < subMeshCount; ++i)
+  {
+    std::string name;
+    uint32_t primitiveType;
+    uint32_t materialIndex;
+    if (!reader.GetString(name) || !reader.Get(primitiveType) ||
+        !reader.Get(materialIndex))
+    {
+      return nullptr;
+    }
+
+    common::SubMesh subMesh(name);
+    subMesh.SetPrimitiveType(
+        static_cast<common::SubMesh::PrimitiveType>(primitiveType));
+    subMesh.SetMaterialIndex(materialIndex);
+
+    uint64_t count;
+    if (!reader.Get(count) || !reader.Fits(count, 3u * sizeof(double)))
+      return nullptr;
+    for (uint64_t j = 0u; j < count; ++j)
+    {
+      math::Vector3d vertex;
+      reader.Get(vertex.X());
+      reader.Get(vertex.Y());
+      reader.Get(vertex.Z());
+      subMesh.AddVertex(vertex);
+    }
+
+    if (!reader.Get(count) || !reader.Fits(count, 3u * sizeof(double)))
+      return nullptr;
+    for (uint64_t j = 0u; j < count; ++j)
+    {
+      math::Vector3d normal;
+      reader.Get(normal.X());
+      reader.Get(normal.Y());
+      reader.Get(normal.Z());
+      subMesh.AddNormal(normal);
+    }
+
+    if (!reader.Get(count) || !reader.Fits(count, 2u * sizeof(double)))
+      return nullptr;
+    for (uint64_t j = 0u; j < count; ++j)
+    {
+      math::Vector2d texCoord;
+      reader.Get(texCoord.X());
+      reader.Get(texCoord.Y());
+      subMesh.AddTexCoord(texCoord);
+    }
+
+    if (!reader.Get(count) || !reader.Fits(count, sizeof(uint32_t)))
+      return nullptr;
+    for (uint64_t j = 0u; j < count; ++j)
+    {
+      uint32_t index;
+      reader.Get(index);
+      subMesh.AddIndex(index);
+    }
+
+    mesh->AddSubMesh(subMesh);
+  }
+
+  if (!reader.Done())
+    return nullptr;
+
+  return mesh;
+}
+
+/////////////////////////////////////////////////
+bool SceneCache::SaveMesh(const std::string &_filename,
+    const std::string &_fullname, const common::Mesh &_mesh) const
+{
+  // Skeletons and animations aren't cached, those meshes are always parsed
+  if (_mesh.HasSkeleton())
+    return false;
+
+  uint64_t size;
+  int64_t mtime;
+  uint64_t hash;
+  if (!StatFile(_fullname, size, mtime) ||
+      !this->SourceHash(_fullname, size, mtime, hash))
+  {
+    return false;
+  }
+
+  Writer writer;
+  PutHeader(kMeshMagic, writer);
+  writer.Put(size);
+  writer.Put(mtime);
+  writer.Put(hash);
+
+  writer.Put(static_cast<uint32_t>(_mesh.MaterialCount()));
+  for (unsigned int i = 0u; i < _mesh.MaterialCount(); ++i)
+  {
+    auto material = _mesh.MaterialByIndex(i);
+    if (nullptr == material)
+      return false;
+    PutMaterial(*material, writer);
+  }
+
+  writer.Put(static_cast<uint32_t>(_mesh.SubMeshCount()));
+  for (unsigned int i = 0u; i < _mesh.SubMeshCount(); ++i)
+  {
+    auto subMesh = _mesh.SubMeshByIndex(i).lock();
+    if (nullptr == subMesh)
+      return false;
+
+    writer.PutString(subMesh->Name());
+    writer.Put(static_cast<uint32_t>(subMesh->SubMeshPrimitiveType()));
+    writer.Put(static_cast<uint32_t>(subMesh->MaterialIndex()));
+
+    writer.Put(static_cast<uint64_t>(subMesh->VertexCount()));
+    for (unsigned int j = 0u; j < subMesh->VertexCount(); ++j)
+    {
+      const auto vertex = subMesh->Vertex(j);
+      writer.Put(vertex.X());
+      writer.Put(vertex.Y());
+      writer.Put(vertex.Z());
+    }
+
+    writer.Put(static_cast<uint64_t>(subMesh->NormalCount()));
+    for (unsigned int j = 0u; j < subMesh->NormalCount(); ++j)
+    {
+      const auto normal = subMesh->Normal(j);
+      writer.Put(normal.X());
+      writer.Put(normal.Y());
+      writer.Put(normal.Z());
+    }
+
+    writer.Put(static_cast<uint64_t>(subMesh->TexCoordCount()));
+    for (unsigned int j = 0u; j < subMesh->TexCoordCount(); ++j)
+    {
+      const auto texCoord = subMesh->TexCoord(j);
+      writer.Put(texCoord.X());
+      writer.Put(texCoord.Y());
+    }
+
+    writer.Put(static_cast<uint64_t>(subMesh->IndexCount()));
+    for (unsigned int j = 0u; j < subMesh->IndexCount(); ++j)
+      writer.Put(static_cast<uint32_t>(subMesh->Index(j)));
+  }
+
+  if (!WriteFile(this->Path(_filename, ".mesh"), writer.data))
+  {
+    ignerr << "Failed to cache mesh [" << _filename << "]" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::unordered_map<unsigned int, uint64_t> SceneCache::EntityHashes(
+    const msgs::Scene &_scene)
+{
+  std::unordered_map<unsigned int, uint64_t> hashes;
+  hashes.reserve(_scene.model_size() + _scene.light_size());
+  for (const auto &model : _scene.model())
+    hashes[model.id()] = Hash(model.SerializeAsString());
+  for (const auto &light : _scene.light())
+    hashes[light.id()] = Hash(light.SerializeAsString());
+  return hashes;
+}
+
+/////////////////////////////////////////////////
+uint64_t SceneCache::Hash(const std::string &_data)
+{
+  uint64_t hash = 14695981039346656037ull;
+  for (const char c : _data)
+  {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+/////////////////////////////////////////////////
+bool SceneCache::SourceHash(const std::string &_fullname,
+    const uint64_t _size, const int64_t _mtime, uint64_t &_hash) const
+{
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    auto it = this->sources.find(_fullname);
+    if (it != this->sources.end() && it->second.size == _size &&
+        it->second.mtime == _mtime)
+    {
+      _hash = it->second.hash;
+      return true;
+    }
+  }
+
+  std::string data;
+  if (!ReadFile(_fullname, data) || data.size() != _size)
+    return false;
+  _hash = Hash(data);
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->sources[_fullname] = {_size, _mtime, _hash};
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::string SceneCache::Path(const std::string &_key,
+    const std::string &_extension) const
+{
+  // Keep the end of the key readable, the hash keeps names unique
+  std::string prefix = _key.substr(_key.find_last_of("/\\") + 1);
+  if (prefix.size() > 32u)
+    prefix.erase(0u, prefix.size() - 32u);
+  for (char &c : prefix)
+  {
+    if (!std::isalnum(static_cast<unsigned char>(c)) && c != '_' && c != '-')
+      c = '_';
+  }
+
+  char hash[17];
+  std::snprintf(hash, sizeof(hash), "%016llx",
+      static_cast<unsigned long long>(Hash(_key)));
+  return common::joinPaths(this->directory,
+      prefix + "_" + hash + _extension);
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_TRANSPORTSCENEMANAGER_SCENECACHE_HH_
+#define GZ_GUI_PLUGINS_TRANSPORTSCENEMANAGER_SCENECACHE_HH_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gz/common/Mesh.hh>
+#include <gz/msgs/scene.pb.h>
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  /// \brief On-disk cache of scene msgs and parsed meshes, used to show a
+  /// world right away on startup, before the scene service replies and
+  /// before mesh files are parsed.
+  ///
+  /// Scenes are stored per world name and meshes per file name. Each file
+  /// starts with a magic number and a format version, and files with an
+  /// unknown version are ignored. Meshes also store the size, modification
+  /// time and hash of their source file, so that edited files are parsed
+  /// again. A source whose size and nanosecond modification time match
+  /// isn't read at all. Other sources are hashed at most once per process, and the hash
+  /// is reused for all meshes cached from them, such as levels of detail.
+  /// Files are written to a temporary name and then renamed, so readers
+  /// never see a partial file. Mesh materials are stored whole, including
+  /// their PBR maps, and meshes with skeletons aren't cached.
+  ///
+  /// All functions only touch files, so they can be called from any thread.
+  class SceneCache
+  {
+    /// \brief Current format version of all cache files.
+    public: static constexpr uint32_t kVersion = 3u;
+
+    /// \brief Constructor.
+    /// \param[in] _directory Directory holding the cache files. Empty for
+    /// ~/.ignition/gui/scene_cache.
+    public: explicit SceneCache(const std::string &_directory = "");
+
+    /// \brief Get the cache directory.
+    /// \return Absolute path of the directory.
+    public: const std::string &Directory() const;
+
+    /// \brief Load the cached scene of a world.
+    /// \param[in] _world World name.
+    /// \param[out] _scene Cached scene, without header.
+    /// \return False if there's no valid cached scene for the world.
+    public: bool LoadScene(const std::string &_world,
+        msgs::Scene &_scene) const;
+
+    /// \brief Save a scene, replacing the cached scene of its world.
+    /// \param[in] _world World name.
+    /// \param[in] _scene Scene to cache.
+    /// \return False if the scene couldn't be written.
+    public: bool SaveScene(const std::string &_world,
+        const msgs::Scene &_scene) const;
+
+    /// \brief Save a scene received in pages, replacing the cached scene
+    /// of its world. The pages are written one after the other, which
+    /// loads as if they were merged, without merging them in memory.
+    /// \param[in] _world World name.
+    /// \param[in] _pages Pages of the scene to cache.
+    /// \return False if the scene couldn't be written.
+    public: bool SaveScene(const std::string &_world,
+        const std::vector<std::shared_ptr<const msgs::Scene>> &_pages) const;
+
+    /// \brief Load the cached mesh of a file, if the file didn't change
+    /// since it was cached.
+    /// \param[in] _filename Mesh file name, as given to the mesh loader.
+    /// \param[in] _fullname Resolved path of the mesh file.
+    /// \return Cached mesh, null if there's no valid cached mesh.
+    public: std::unique_ptr<common::Mesh> LoadMesh(
+        const std::string &_filename, const std::string &_fullname) const;
+
+    /// \brief Save a parsed mesh. Meshes with skeletons aren't cached.
+    /// \param[in] _filename Mesh file name, as given to the mesh loader.
+    /// \param[in] _fullname Resolved path of the mesh file.
+    /// \param[in] _mesh Parsed mesh.
+    /// \return False if the mesh wasn't cached.
+    public: bool SaveMesh(const std::string &_filename,
+        const std::string &_fullname, const common::Mesh &_mesh) const;
+
+    /// \brief Hash the contents of the top level models and lights of a
+    /// scene, used to find which of them changed between two scenes.
+    /// \param[in] _scene Scene, or page of a scene.
+    /// \return Hash of each entity, by entity id.
+    public: static std::unordered_map<unsigned int, uint64_t> EntityHashes(
+        const msgs::Scene &_scene);
+
+    /// \brief Hash used to identify content, such as scene entities and
+    /// mesh files.
+    /// \param[in] _data Data to hash.
+    /// \return 64 bit FNV-1a hash.
+    public: static uint64_t Hash(const std::string &_data);
+
+    /// \brief Get the path of a cache file.
+    /// \param[in] _key World or mesh file name.
+    /// \param[in] _extension File extension.
+    /// \return Path made of a readable prefix and a hash of the key.
+    private: std::string Path(const std::string &_key,
+        const std::string &_extension) const;
+
+    /// \brief Get the hash of a mesh source file, reading it only if it
+    /// changed since it was last hashed.
+    /// \param[in] _fullname Path of the source file.
+    /// \param[in] _size Size of the file.
+    /// \param[in] _mtime Modification time of the file, in nanoseconds.
+    /// \param[out] _hash Hash of the file contents.
+    /// \return False if the file couldn't be read.
+    private: bool SourceHash(const std::string &_fullname,
+        const uint64_t _size, const int64_t _mtime, uint64_t &_hash) const;
+
+    /// \brief Cache directory.
+    private: std::string directory;
+
+    /// \brief Size, modification time and hash of a source file.
+    private: struct Source
+    {
+      /// \brief File size in bytes.
+      uint64_t size{0u};
+
+      /// \brief Modification time in nanoseconds.
+      int64_t mtime{0};
+
+      /// \brief Hash of the contents.
+      uint64_t hash{0u};
+    };
+
+    /// \brief Protects sources.
+    private: mutable std::mutex mutex;
+
+    /// \brief Source files hashed so far, by path.
+    private: mutable std::unordered_map<std::string, Source> sources;
+  };
+}
+}
+}
+
+#endif
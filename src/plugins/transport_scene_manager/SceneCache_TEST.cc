@@ -0,0 +1,280 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gz/common/Filesystem.hh>
+#include <gz/common/Material.hh>
+#include <gz/common/Pbr.hh>
+#include <gz/common/SubMesh.hh>
+
+#include "gz/gui/config.hh"
+#include "test_config.h"  // NOLINT(build/include)
+
+#include "SceneCache.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+namespace
+{
+  /// \brief Get an empty directory for a test's cache.
+  /// \param[in] _name Test name.
+  /// \return Directory path.
+  std::string CacheDirectory(const std::string &_name)
+  {
+    const std::string directory = common::joinPaths(
+        std::string(PROJECT_BINARY_PATH), "test", "scene_cache", _name);
+    common::removeAll(directory);
+    return directory;
+  }
+
+  /// \brief Write a whole file.
+  /// \param[in] _path File path.
+  /// \param[in] _data File contents.
+  void WriteFile(const std::string &_path, const std::string &_data)
+  {
+    std::ofstream file(_path, std::ios::binary | std::ios::trunc);
+    file << _data;
+  }
+
+  /// \brief Cut all cache files with an extension in half.
+  /// \param[in] _directory Cache directory.
+  /// \param[in] _extension File extension.
+  /// \return Number of files cut.
+  int Truncate(const std::string &_directory, const std::string &_extension)
+  {
+    std::vector<std::string> paths;
+    for (common::DirIter it(_directory); it != common::DirIter(); ++it)
+    {
+      const std::string path = *it;
+      if (path.size() > _extension.size() &&
+          path.compare(path.size() - _extension.size(), _extension.size(),
+              _extension) == 0)
+      {
+        paths.push_back(path);
+      }
+    }
+
+    for (const auto &path : paths)
+    {
+      std::ifstream file(path, std::ios::binary);
+      std::string data((std::istreambuf_iterator<char>(file)),
+          std::istreambuf_iterator<char>());
+      file.close();
+      WriteFile(path, data.substr(0, data.size() / 2));
+    }
+    return static_cast<int>(paths.size());
+  }
+
+  /// \brief Make a mesh with a textured PBR material and a triangle.
+  /// \return Mesh.
+  common::Mesh Triangle()
+  {
+    common::Mesh mesh;
+    auto material = std::make_shared<common::Material>();
+    material->SetDiffuse(math::Color(0.1f, 0.2f, 0.3f, 1.0f));
+    material->SetTransparency(0.25);
+    material->SetTextureImage("texture.png");
+    material->SetAlphaFromTexture(true, 0.3, false);
+    material->SetDepthWrite(false);
+    common::Pbr pbr;
+    pbr.SetType(common::PbrType::METAL);
+    pbr.SetNormalMap("normal.png", common::NormalMapSpace::OBJECT);
+    pbr.SetRoughness(0.75);
+    material->SetPbrMaterial(pbr);
+    mesh.AddMaterial(material);
+
+    common::SubMesh subMesh("triangle");
+    subMesh.SetPrimitiveType(common::SubMesh::TRIANGLES);
+    subMesh.SetMaterialIndex(0u);
+    subMesh.AddVertex(math::Vector3d(0.0, 0.0, 0.0));
+    subMesh.AddVertex(math::Vector3d(1.0, 0.0, 0.0));
+    subMesh.AddVertex(math::Vector3d(0.0, 1.0, 0.5));
+    for (int i = 0; i < 3; ++i)
+    {
+      subMesh.AddNormal(math::Vector3d(0.0, 0.0, 1.0));
+      subMesh.AddTexCoord(math::Vector2d(0.5 * i, 0.25));
+      subMesh.AddIndex(i);
+    }
+    mesh.AddSubMesh(subMesh);
+    return mesh;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(SceneCacheTest, Scene)
+{
+  SceneCache cache(CacheDirectory("scene"));
+
+  msgs::Scene scene;
+  scene.set_name("world");
+  scene.add_model()->set_id(1u);
+  scene.add_model()->set_name("box");
+  scene.add_light()->set_id(2u);
+
+  msgs::Scene loaded;
+  EXPECT_FALSE(cache.LoadScene("world", loaded));
+
+  ASSERT_TRUE(cache.SaveScene("world", scene));
+  ASSERT_TRUE(cache.LoadScene("world", loaded));
+  EXPECT_EQ(scene.SerializeAsString(), loaded.SerializeAsString());
+  EXPECT_FALSE(cache.LoadScene("other_world", loaded));
+
+  // Saving again replaces the scene
+  scene.clear_light();
+  ASSERT_TRUE(cache.SaveScene("world", scene));
+  ASSERT_TRUE(cache.LoadScene("world", loaded));
+  EXPECT_EQ(0, loaded.light_size());
+
+  // Truncated files are ignored
+  EXPECT_EQ(1, Truncate(cache.Directory(), ".scene"));
+  EXPECT_FALSE(cache.LoadScene("world", loaded));
+
+  common::removeAll(cache.Directory());
+}
+
+/////////////////////////////////////////////////
+TEST(SceneCacheTest, ScenePages)
+{
+  SceneCache cache(CacheDirectory("scene_pages"));
+
+  auto first = std::make_shared<msgs::Scene>();
+  first->set_name("world");
+  first->mutable_header()->mutable_stamp()->set_sec(1);
+  first->add_model()->set_id(1u);
+  first->add_light()->set_id(2u);
+
+  auto second = std::make_shared<msgs::Scene>();
+  second->mutable_header()->mutable_stamp()->set_sec(2);
+  second->add_model()->set_id(3u);
+
+  // Pages load as if they were merged, without their headers
+  ASSERT_TRUE(cache.SaveScene("world", {first, second}));
+  msgs::Scene loaded;
+  ASSERT_TRUE(cache.LoadScene("world", loaded));
+  EXPECT_EQ("world", loaded.name());
+  EXPECT_FALSE(loaded.has_header());
+  ASSERT_EQ(2, loaded.model_size());
+  EXPECT_EQ(1u, loaded.model(0).id());
+  EXPECT_EQ(3u, loaded.model(1).id());
+  EXPECT_EQ(1, loaded.light_size());
+
+  common::removeAll(cache.Directory());
+}
+
+/////////////////////////////////////////////////
+TEST(SceneCacheTest, Mesh)
+{
+  SceneCache cache(CacheDirectory("mesh"));
+  const std::string source =
+      common::joinPaths(cache.Directory(), "triangle.obj");
+  WriteFile(source, "source");
+
+  EXPECT_EQ(nullptr, cache.LoadMesh("triangle.obj", source));
+
+  ASSERT_TRUE(cache.SaveMesh("triangle.obj", source, Triangle()));
+  auto mesh = cache.LoadMesh("triangle.obj", source);
+  ASSERT_NE(nullptr, mesh);
+  EXPECT_EQ("triangle.obj", mesh->Name());
+
+  ASSERT_EQ(1u, mesh->MaterialCount());
+  auto material = mesh->MaterialByIndex(0u);
+  ASSERT_NE(nullptr, material);
+  EXPECT_EQ(math::Color(0.1f, 0.2f, 0.3f, 1.0f), material->Diffuse());
+  EXPECT_DOUBLE_EQ(0.25, material->Transparency());
+  EXPECT_EQ("texture.png", material->TextureImage());
+  EXPECT_TRUE(material->TextureAlphaEnabled());
+  EXPECT_DOUBLE_EQ(0.3, material->AlphaThreshold());
+  EXPECT_FALSE(material->TwoSidedEnabled());
+  EXPECT_FALSE(material->DepthWrite());
+
+  const auto *pbr = material->PbrMaterial();
+  ASSERT_NE(nullptr, pbr);
+  EXPECT_EQ(common::PbrType::METAL, pbr->Type());
+  EXPECT_EQ("normal.png", pbr->NormalMap());
+  EXPECT_EQ(common::NormalMapSpace::OBJECT, pbr->NormalMapType());
+  EXPECT_DOUBLE_EQ(0.75, pbr->Roughness());
+
+  ASSERT_EQ(1u, mesh->SubMeshCount());
+  auto subMesh = mesh->SubMeshByIndex(0u).lock();
+  ASSERT_NE(nullptr, subMesh);
+  EXPECT_EQ("triangle", subMesh->Name());
+  EXPECT_EQ(common::SubMesh::TRIANGLES, subMesh->SubMeshPrimitiveType());
+  EXPECT_EQ(0, subMesh->MaterialIndex());
+  ASSERT_EQ(3u, subMesh->VertexCount());
+  ASSERT_EQ(3u, subMesh->NormalCount());
+  ASSERT_EQ(3u, subMesh->TexCoordCount());
+  ASSERT_EQ(3u, subMesh->IndexCount());
+  EXPECT_EQ(math::Vector3d(0.0, 1.0, 0.5), subMesh->Vertex(2u));
+  EXPECT_EQ(math::Vector3d(0.0, 0.0, 1.0), subMesh->Normal(1u));
+  EXPECT_EQ(math::Vector2d(1.0, 0.25), subMesh->TexCoord(2u));
+  EXPECT_EQ(2, subMesh->Index(2u));
+
+  // Levels of detail are cached under other names from the same source
+  ASSERT_TRUE(cache.SaveMesh("triangle.obj#lod1", source, Triangle()));
+  EXPECT_NE(nullptr, cache.LoadMesh("triangle.obj#lod1", source));
+
+  common::removeAll(cache.Directory());
+}
+
+/////////////////////////////////////////////////
+TEST(SceneCacheTest, StaleSource)
+{
+  SceneCache cache(CacheDirectory("stale"));
+  const std::string source =
+      common::joinPaths(cache.Directory(), "triangle.obj");
+  WriteFile(source, "source");
+  ASSERT_TRUE(cache.SaveMesh("triangle.obj", source, Triangle()));
+  ASSERT_NE(nullptr, cache.LoadMesh("triangle.obj", source));
+
+  // Edited source
+  WriteFile(source, "edited source");
+  EXPECT_EQ(nullptr, cache.LoadMesh("triangle.obj", source));
+
+  // Caching it again makes it valid
+  ASSERT_TRUE(cache.SaveMesh("triangle.obj", source, Triangle()));
+  EXPECT_NE(nullptr, cache.LoadMesh("triangle.obj", source));
+
+  // Missing source
+  common::removeFile(source);
+  EXPECT_EQ(nullptr, cache.LoadMesh("triangle.obj", source));
+  EXPECT_FALSE(cache.SaveMesh("triangle.obj", source, Triangle()));
+
+  common::removeAll(cache.Directory());
+}
+
+/////////////////////////////////////////////////
+TEST(SceneCacheTest, TruncatedMesh)
+{
+  SceneCache cache(CacheDirectory("truncated"));
+  const std::string source =
+      common::joinPaths(cache.Directory(), "triangle.obj");
+  WriteFile(source, "source");
+  ASSERT_TRUE(cache.SaveMesh("triangle.obj", source, Triangle()));
+
+  EXPECT_EQ(1, Truncate(cache.Directory(), ".mesh"));
+  EXPECT_EQ(nullptr, cache.LoadMesh("triangle.obj", source));
+
+  common::removeAll(cache.Directory());
+}
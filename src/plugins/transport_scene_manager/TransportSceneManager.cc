@@ -16,16 +16,21 @@
 */
 
 #include <algorithm>
-#include <map>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <thread>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <QQmlProperty>
 
 #include <gz/common/Console.hh>
-#include <gz/common/MeshManager.hh>
+#include <gz/common/Mesh.hh>
 #include <gz/math/Pose3.hh>
 #include <gz/math/Vector3.hh>
 #include <gz/plugin/Register.hh>
@@ -37,6 +42,7 @@
 #endif
 #include <gz/msgs.hh>
 
+#include <gz/rendering/Camera.hh>
 #include <gz/rendering/Capsule.hh>
 #include <gz/rendering/RenderEngine.hh>
 #include <gz/rendering/RenderingIface.hh>
@@ -53,18 +59,190 @@
 #include "gz/gui/Conversions.hh"
 #include "gz/gui/GuiEvents.hh"
 #include "gz/gui/MainWindow.hh"
-
+#include "gz/gui/PackedPoses.hh"
+#include "gz/gui/PagedScene.hh"
+#include "gz/gui/PoseFrame.hh"
+
+#include "ArenaMessage.hh"
+#include "AsyncMeshLoader.hh"
+#include "IdSlotMap.hh"
+#include "InstanceBatcher.hh"
+#include "MaterialCache.hh"
+#include "PendingQueue.hh"
+#include "PoseBuffer.hh"
+#include "PoseVDecoder.hh"
+#include "SceneCache.hh"
+#include "ServiceWaiter.hh"
 #include "TransportSceneManager.hh"
 
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  /// \brief Everything the scene manager keeps about a single entity. All
+  /// records live contiguously in an IdSlotMap, so that looking up the node
+  /// for a pose is a constant time probe instead of a tree lookup.
+  struct EntityRecord
+  {
+    /// \brief Initial local pose.
+    /// This is currently used to handle the normal vector in plane visuals.
+    /// In general, this can be used to store any local transforms between
+    /// the parent Visual and geometry.
+    math::Pose3d localPose{math::Pose3d::Zero};
+
+    /// \brief Visual of the entity, empty for lights.
+    rendering::VisualPtr::weak_type visual;
+
+    /// \brief Light of the entity, empty for visuals.
+    rendering::LightPtr::weak_type light;
+
+    /// \brief Ids of the links, nested models, visuals and lights loaded
+    /// under this entity. Their nodes are destroyed together with this
+    /// entity's node, so their records are purged with it.
+    std::vector<unsigned int> children;
+
+    /// \brief Id of the entity which lists this one in its children, if
+    /// hasParent is set.
+    unsigned int parent{0u};
+
+    /// \brief True if the entity was loaded under another entity.
+    bool hasParent{false};
+
+    /// \brief File name of the mesh used by the visual's geometry, empty if
+    /// it doesn't hold a reference to a parsed mesh.
+    std::string mesh;
+
+    /// \brief Cached material used by the visual's geometry, null if it
+    /// doesn't hold a reference to a cached material.
+    rendering::MaterialPtr material;
+
+    /// \brief Geometries of the levels of detail of the visual's mesh, from
+    /// the most to the least detailed. Only one of them is attached to the
+    /// visual at a time. Empty if the mesh has no levels of detail.
+    std::vector<rendering::GeometryPtr> lods;
+
+    /// \brief Index in `lods` of the geometry attached to the visual.
+    unsigned int lod{0u};
+
+    /// \brief Radius of the bounding sphere of the mesh, before scaling.
+    double lodRadius{0.0};
+
+    /// \brief Last pose applied to the node, without the local pose.
+    math::Pose3d appliedPose;
+
+    /// \brief True once a pose has been applied from a pose msg.
+    bool hasAppliedPose{false};
+
+    /// \brief Latest two poses received for the entity, oldest first.
+    /// Only used when interpolating.
+    math::Pose3d samplePoses[2];
+
+    /// \brief Stamps of samplePoses, in seconds.
+    double sampleStamps[2]{0.0, 0.0};
+
+    /// \brief Number of valid samples, up to two.
+    unsigned int sampleCount{0u};
+
+    /// \brief True while the interpolated pose still changes.
+    bool interpolating{false};
+  };
+
+  /// \brief Top level model or light of a scene msg which is waiting to be
+  /// loaded.
+  struct PendingEntity
+  {
+    /// \brief Scene msg holding the entity.
+    std::shared_ptr<const msgs::Scene> sceneMsg;
+
+    /// \brief Index of the model or light within the scene msg.
+    int index{0};
+
+    /// \brief True if the entity is a light, false if it's a model.
+    bool isLight{false};
+
+    /// \brief Position of the entity in the world.
+    math::Vector3d position;
+  };
+
+  /// \brief Visual which is waiting for its mesh file to be parsed.
+  struct PendingMeshVisual
+  {
+    /// \brief Visual the mesh will be attached to.
+    rendering::VisualPtr::weak_type visual;
+
+    /// \brief Visual msg, used to create the geometry and material.
+    msgs::Visual msg;
+  };
+}
+}
+}
+
 /// \brief Private data class for TransportSceneManager
 class ignition::gui::plugins::TransportSceneManagerPrivate
 {
-  /// \brief Make the scene service request and populate the scene
-  public: void Request();
+  /// \brief Wait for the scene service and request the scene. Scene and
+  /// deletion msgs held back meanwhile are released once it's done.
+  /// \return False if the wait was cancelled.
+  public: bool Request();
+
+  /// \brief Queue the scene and deletion msgs held back while the scene
+  /// was requested, and stop holding them back.
+  public: void ReleaseHeldMsgs();
 
   /// \brief Update the scene based on pose msgs received
   public: void OnRender();
 
+  /// \brief Queue the cached scene of the world, if there's one, so it's
+  /// shown before the scene service replies
+  public: void LoadCachedScene();
+
+  /// \brief Delete entities created from the cached scene which are
+  /// missing or changed in the live scene, so they're created again from
+  /// the live scene.
+  /// \param[in] _stale Ids of the stale entities
+  public: void DeleteStaleEntities(const std::vector<unsigned int> &_stale);
+
+  /// \brief Apply the latest pose frame to the loaded entities
+  public: void ApplyPoses();
+
+  /// \brief Keep track of how pose stamps advance relative to the local
+  /// clock.
+  /// \param[in] _frame Frame which was just received
+  /// \return Stamp of the frame in seconds. Frames without a stamp use the
+  /// time they were received.
+  public: double UpdateStampClock(const PoseFrame &_frame);
+
+  /// \brief Store a received pose to be interpolated
+  /// \param[in] _record Record of the entity
+  /// \param[in] _pose Pose received
+  /// \param[in] _stamp Stamp of the pose in seconds
+  public: void AddPoseSample(EntityRecord &_record, const math::Pose3d &_pose,
+      const double _stamp);
+
+  /// \brief Set the interpolated poses of all moving entities for the
+  /// current frame
+  public: void Interpolate();
+
+  /// \brief Set the pose of an entity's node
+  /// \param[in] _id Entity id
+  /// \param[in] _record Record of the entity. It's erased if the node no
+  /// longer exists, so it must not be used after this call.
+  /// \param[in] _pose Pose, without the additional local pose
+  public: void SetEntityPose(const unsigned int _id, EntityRecord &_record,
+      const math::Pose3d &_pose);
+
+  /// \brief Release the mesh and material references held by an entity,
+  /// once its geometry is destroyed
+  /// \param[in] _record Entity record
+  public: void ReleaseResources(EntityRecord &_record);
+
+  /// \brief Publish the pose update counts and the resource usage once per
+  /// second
+  /// \return True if new values were published
+  public: bool UpdateStats();
+
   /// \brief Initialize transport, subscribing to the necessary topics.
   /// To be called after a valid scene has been found.
   public: void InitializeTransport();
@@ -73,21 +251,55 @@ class ignition::gui::plugins::TransportSceneManagerPrivate
   /// \param[in] _msg Pose vector msg
   public: void OnPoseVMsg(const msgs::Pose_V &_msg);
 
-  /// \brief Load the scene from a scene msg
+  /// \brief Raw callback function for the pose topic. Decodes the
+  /// serialized msgs::Pose_V without constructing messages, and falls back
+  /// to OnPoseVMsg for payloads the decoder doesn't handle.
+  /// \param[in] _data Serialized pose vector msg
+  /// \param[in] _size Size of the serialized msg
+  /// \param[in] _info Message information
+  public: void OnPoseVRaw(const char *_data, const std::size_t _size,
+      const transport::MessageInfo &_info);
+
+  /// \brief Callback function for the packed pose topic
+  /// \param[in] _msg Poses encoded as described in PackedPoses
+  public: void OnPackedPoseMsg(const msgs::Bytes &_msg);
+
+  /// \brief Queue the models and lights of a scene msg to be loaded
   /// \param[in] _msg Scene msg
-  public: void LoadScene(const msgs::Scene &_msg);
+  public: void QueueScene(const std::shared_ptr<const msgs::Scene> &_msg);
+
+  /// \brief Load queued models and lights, nearest to the user camera first,
+  /// until the per-frame budget is used up. At least one entity is loaded
+  /// per call.
+  public: void LoadPending();
+
+  /// \brief Get the camera used to prioritize loading
+  /// \return The first camera in the scene, null if there's none.
+  public: rendering::CameraPtr UserCamera();
 
   /// \brief Callback function for the request topic
   /// \param[in] _msg Deletion message
   public: void OnDeletionMsg(const msgs::UInt32_V &_msg);
 
-  /// \brief Load the scene from a scene msg
-  /// \param[in] _msg Scene msg
-  public: void OnSceneSrvMsg(const msgs::Scene &_msg, const bool result);
-
-  /// \brief Called when there's an entity is added to the scene
-  /// \param[in] _msg Scene msg
-  public: void OnSceneMsg(const msgs::Scene &_msg);
+  /// \brief Request the whole scene from the scene service into its own
+  /// arena. Cancelled by serviceWaiter.
+  /// \return True if the scene was received
+  public: bool RequestScene();
+
+  /// \brief Queue a scene received from the scene service, or a page of it,
+  /// to be loaded, and reconcile it with the cached scene.
+  /// \param[in] _msg Scene or page of the scene, which isn't copied
+  /// \param[in] _last True if no more pages follow
+  public: void OnScenePage(const std::shared_ptr<msgs::Scene> &_msg,
+      const bool _last);
+
+  /// \brief Called when there's an entity is added to the scene. The
+  /// message is parsed into its own arena and queued without copies.
+  /// \param[in] _data Serialized scene msg
+  /// \param[in] _size Size of the data in bytes
+  /// \param[in] _info Message info
+  public: void OnSceneRaw(const char *_data, const std::size_t _size,
+      const transport::MessageInfo &_info);
 
   /// \brief Load the model from a model msg
   /// \param[in] _msg Model msg
@@ -104,6 +316,30 @@ class ignition::gui::plugins::TransportSceneManagerPrivate
   /// \return Visual visual created from the msg
   public: rendering::VisualPtr LoadVisual(const msgs::Visual &_msg);
 
+  /// \brief Add geometry and material to a visual
+  /// \param[in] _visual Visual created for the msg
+  /// \param[in] _msg Visual msg
+  public: void LoadVisualGeometry(const rendering::VisualPtr &_visual,
+      const msgs::Visual &_msg);
+
+  /// \brief Attach meshes which finished parsing to the visuals waiting for
+  /// them
+  public: void ProcessLoadedMeshes();
+
+  /// \brief Add the levels of detail of meshes which finished building
+  /// to the visuals already using those meshes
+  public: void ProcessLoadedLods();
+
+  /// \brief Create the geometries of the levels of detail of a mesh visual,
+  /// if they're built
+  /// \param[in] _id Entity id
+  /// \param[in] _record Entity record, whose visual has its full mesh
+  public: void AddLods(const unsigned int _id, EntityRecord &_record);
+
+  /// \brief Attach the level of detail of each mesh visual which matches
+  /// its size on screen
+  public: void UpdateLods();
+
   /// \brief Load a geometry from a geometry msg
   /// \param[in] _msg Geometry msg
   /// \param[out] _scale Geometry scale that will be set based on msg param
@@ -113,10 +349,11 @@ class ignition::gui::plugins::TransportSceneManagerPrivate
   public: rendering::GeometryPtr LoadGeometry(const msgs::Geometry &_msg,
       math::Vector3d &_scale, math::Pose3d &_localPose);
 
-  /// \brief Load a material from a material msg
-  /// \param[in] _msg Material msg
-  /// \return Material object created from the msg
-  public: rendering::MaterialPtr LoadMaterial(const msgs::Material &_msg);
+  /// \brief Get the material for a visual msg. Visuals with the same
+  /// material, transparency and shadow settings share a single material.
+  /// \param[in] _msg Visual msg
+  /// \return Shared material, which must not be modified or destroyed
+  public: rendering::MaterialPtr LoadMaterial(const msgs::Visual &_msg);
 
   /// \brief Load a light from a light msg
   /// \param[in] _msg Light msg
@@ -127,49 +364,225 @@ class ignition::gui::plugins::TransportSceneManagerPrivate
   /// \param[in] _entity Entity to delete
   public: void DeleteEntity(const unsigned int _entity);
 
+  /// \brief Record the entity which lists another one in its children
+  /// \param[in] _entity Child entity
+  /// \param[in] _parent Parent entity
+  public: void SetParent(const unsigned int _entity,
+      const unsigned int _parent);
+
   //// \brief gz-transport scene service name
   public: std::string service{"scene"};
 
   //// \brief gz-transport pose topic name
   public: std::string poseTopic{"pose"};
 
+  /// \brief gz-transport packed pose topic name, empty if not used
+  public: std::string packedPoseTopic;
+
   //// \brief gz-transport deletion topic name
   public: std::string deletionTopic{"delete"};
 
   //// \brief gz-transport scene topic name
   public: std::string sceneTopic{"scene"};
 
+  /// \brief Time spent loading queued entities per frame. Zero or negative
+  /// loads everything in one frame.
+  public: std::chrono::duration<double, std::milli> loadBudget{10.0};
+
   //// \brief Pointer to the rendering scene
   public: rendering::ScenePtr scene{nullptr};
 
-  //// \brief Mutex to protect the msgs
+  //// \brief Mutex to protect the scene and deletion msgs
   public: std::mutex msgMutex;
 
-  /// \brief Map of entity id to pose
-  public: std::map<unsigned int, math::Pose3d> poses;
+  /// \brief True until the scene service replied or failed. Topics are
+  /// subscribed before the scene is requested, so that no update is
+  /// missed, and the scene and deletion msgs received meanwhile are held
+  /// back until the scene they update is queued. Protected by msgMutex.
+  public: bool holdMsgs{true};
+
+  /// \brief Scene msgs received while the scene was requested.
+  public: std::vector<std::shared_ptr<const msgs::Scene>> heldSceneMsgs;
+
+  /// \brief Deletions received while the scene was requested.
+  public: std::vector<unsigned int> heldDeletions;
+
+  /// \brief Poses handed from the transport thread to the render thread.
+  /// Frames which arrive faster than they're rendered are merged per
+  /// entity.
+  public: PoseBuffer poseBuffer;
+
+  /// \brief True to interpolate between the two latest poses of each
+  /// entity instead of rendering the latest one.
+  public: bool interpolate{false};
+
+  /// \brief How far behind the latest pose msg entities are rendered when
+  /// interpolating, in seconds.
+  public: double interpolationDelay{0.0};
+
+  /// \brief How far past their newest pose entities keep moving when
+  /// msgs are late, in seconds.
+  public: double extrapolationLimit{0.0};
+
+  /// \brief Stamp of the latest pose frame, in seconds.
+  public: double latestStamp{0.0};
+
+  /// \brief Local time when the latest pose frame was received.
+  public: std::chrono::steady_clock::time_point latestReceived;
+
+  /// \brief Filtered rate at which stamps advance relative to the local
+  /// clock. Below 1 when simulation runs slower than real time, zero while
+  /// paused.
+  public: double stampRate{1.0};
 
-  /// \brief Map of entity id to initial local poses
-  /// This is currently used to handle the normal vector in plane visuals. In
-  /// general, this can be used to store any local transforms between the
-  /// parent Visual and geometry.
-  public: std::map<unsigned int, math::Pose3d> localPoses;
+  /// \brief True once a pose frame has been received.
+  public: bool stampValid{false};
 
-  /// \brief Map of visual id to visual pointers.
-  public: std::map<unsigned int, rendering::VisualPtr::weak_type> visuals;
+  /// \brief Pose updates moving an entity less than this aren't applied,
+  /// in meters.
+  public: double positionEpsilon{1e-6};
 
-  /// \brief Map of light id to light pointers.
-  public: std::map<unsigned int, rendering::LightPtr::weak_type> lights;
+  /// \brief Pose updates rotating an entity less than this aren't applied,
+  /// in radians.
+  public: double rotationEpsilon{1e-6};
+
+  /// \brief Pose updates applied since the counts were last published.
+  /// Only accessed from the render thread.
+  public: int appliedCount{0};
+
+  /// \brief Pose updates skipped since the counts were last published.
+  /// Only accessed from the render thread.
+  public: int skippedCount{0};
+
+  /// \brief When the counts were last published.
+  public: std::chrono::steady_clock::time_point statsStart;
+
+  /// \brief Pose updates applied during the last second, read by the GUI.
+  public: std::atomic<int> appliedPoseUpdates{0};
+
+  /// \brief Pose updates skipped during the last second, read by the GUI.
+  public: std::atomic<int> skippedPoseUpdates{0};
+
+  /// \brief Memory used by parsed meshes in MiB, read by the GUI.
+  public: std::atomic<double> meshMemory{0.0};
+
+  /// \brief Number of cached materials, read by the GUI.
+  public: std::atomic<int> materialCount{0};
+
+  /// \brief Serializes pose callbacks, which gz-transport may run on more
+  /// than one thread, e.g. for intra-process publishers. Only taken by the
+  /// pose callback, never by the render thread.
+  public: std::mutex poseWriterMutex;
+
+  /// \brief Records of all loaded entities, indexed by entity id. Only
+  /// accessed from the render thread.
+  public: IdSlotMap<EntityRecord> entities;
 
   /// Entities to be deleted
   public: std::vector<unsigned int> toDeleteEntities;
 
+  /// \brief World whose scene is cached on disk, empty if caching is
+  /// disabled.
+  public: std::string cacheWorld;
+
+  /// \brief Cache of scenes and meshes on disk, null if disabled.
+  public: std::shared_ptr<SceneCache> sceneCache;
+
+  /// \brief Content hashes of the entities of the cached scene which
+  /// weren't found in the live scene yet. Set before the transport thread
+  /// starts, and then only accessed from it.
+  public: std::unordered_map<unsigned int, uint64_t> cachedHashes;
+
+  /// \brief Pages of the live scene, to be cached once complete. They're
+  /// shared with the render thread rather than merged into a copy. Only
+  /// accessed from the transport thread.
+  public: std::vector<std::shared_ptr<const msgs::Scene>> livePages;
+
+  /// \brief True if an entity of the live scene was added, changed or
+  /// removed compared to the cached scene, so that the cache is rewritten.
+  /// Only accessed from the transport thread.
+  public: bool liveSceneChanged{false};
+
+  /// \brief Writes the live scene to the cache, so that the transport
+  /// thread doesn't wait for the disk.
+  public: std::thread cacheWriter;
+
+  /// \brief Maximum number of models per page requested from the paged
+  /// scene service.
+  public: unsigned int scenePageSize{1000u};
+
+  /// \brief Timeout of each page request in milliseconds.
+  public: unsigned int scenePageTimeout{5000u};
+
+  /// \brief Entities of the cached scene which don't match the live scene,
+  /// to be deleted before the live scene is queued.
+  public: std::vector<unsigned int> staleEntities;
+
   /// \brief Keeps the a list of unprocessed scene messages
-  public: std::vector<msgs::Scene> sceneMsgs;
+  public: std::vector<std::shared_ptr<const msgs::Scene>> sceneMsgs;
+
+  /// \brief Models and lights waiting to be loaded, sorted so that the
+  /// nearest one to the user camera is taken first. Entities deleted
+  /// before being loaded are removed from it.
+  public: PendingQueue<PendingEntity> pending;
+
+  /// \brief True if entities were queued since `pending` was last sorted.
+  public: bool pendingUnsorted{false};
+
+  /// \brief Camera position used when `pending` was last sorted.
+  public: math::Vector3d sortPosition;
+
+  /// \brief Camera used to prioritize loading.
+  public: rendering::CameraPtr::weak_type camera;
+
+  /// \brief Number of threads used to parse mesh files, zero to choose
+  /// based on the hardware.
+  public: unsigned int meshLoaderThreads{0u};
+
+  /// \brief Number of meshes whose levels of detail are kept after their
+  /// last visual is deleted.
+  public: unsigned int meshRetention{64u};
+
+  /// \brief Number of simplified levels of detail built for large meshes,
+  /// zero to disable.
+  public: unsigned int meshLodLevels{0u};
+
+  /// \brief Fewest triangles of meshes which get levels of detail.
+  public: unsigned int meshLodMinTriangles{100000u};
+
+  /// \brief Fraction of the viewport height covered by a mesh below which
+  /// its first level of detail is used. Each following level is used below
+  /// half the size of the previous one, and has a quarter of its triangles.
+  public: static constexpr double kLodScreenSize{0.5};
+
+  /// \brief Ids of the entities with levels of detail.
+  public: std::vector<unsigned int> lodEntities;
+
+  /// \brief Parses mesh files in the background. Created together with
+  /// the scene.
+  public: std::unique_ptr<AsyncMeshLoader> meshLoader;
+
+  /// \brief Materials shared by visuals with the same appearance.
+  public: MaterialCache materialCache;
+
+  /// \brief True to draw repeated primitives in batches.
+  public: bool instancing{false};
+
+  /// \brief Draws repeated primitives when instancing is enabled. Created
+  /// together with the scene.
+  public: std::unique_ptr<InstanceBatcher> instanceBatcher;
+
+  /// \brief Visuals waiting for a mesh file to be parsed, by file name.
+  public: std::unordered_map<std::string, std::vector<PendingMeshVisual>>
+      pendingMeshVisuals;
 
   /// \brief Transport node for making service request and subscribing to
   /// pose topic
   public: gz::transport::Node node;
 
+  /// \brief Waits for the scene service, cancelled on shutdown
+  public: ServiceWaiter serviceWaiter;
+
   /// \brief Thread to wait for transport initialization
   public: std::thread initializeTransport;
 };
@@ -187,8 +600,11 @@ TransportSceneManager::TransportSceneManager()
 /////////////////////////////////////////////////
 TransportSceneManager::~TransportSceneManager()
 {
+  this->dataPtr->serviceWaiter.Cancel();
   if (this->dataPtr->initializeTransport.joinable())
     this->dataPtr->initializeTransport.join();
+  if (this->dataPtr->cacheWriter.joinable())
+    this->dataPtr->cacheWriter.join();
 }
 
 /////////////////////////////////////////////////
@@ -214,6 +630,13 @@ void TransportSceneManager::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
           transport::TopicUtils::AsValidTopic(elem->GetText());
     }
 
+    elem = _pluginElem->FirstChildElement("packed_pose_topic");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      this->dataPtr->packedPoseTopic =
+          transport::TopicUtils::AsValidTopic(elem->GetText());
+    }
+
     elem = _pluginElem->FirstChildElement("deletion_topic");
     if (nullptr != elem && nullptr != elem->GetText())
     {
@@ -227,6 +650,162 @@ void TransportSceneManager::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
       this->dataPtr->sceneTopic =
           transport::TopicUtils::AsValidTopic(elem->GetText());
     }
+
+    elem = _pluginElem->FirstChildElement("mesh_loader_threads");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      if (elem->QueryUnsignedText(&this->dataPtr->meshLoaderThreads) !=
+          tinyxml2::XML_SUCCESS)
+      {
+        ignerr << "Failed to parse <mesh_loader_threads> value: "
+               << elem->GetText() << std::endl;
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("scene_cache");
+    if (nullptr != elem && nullptr != elem->GetText())
+      this->dataPtr->cacheWorld = elem->GetText();
+
+    elem = _pluginElem->FirstChildElement("scene_page_size");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      if (elem->QueryUnsignedText(&this->dataPtr->scenePageSize) !=
+          tinyxml2::XML_SUCCESS)
+      {
+        ignerr << "Failed to parse <scene_page_size> value: "
+               << elem->GetText() << std::endl;
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("scene_page_timeout_ms");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      if (elem->QueryUnsignedText(&this->dataPtr->scenePageTimeout) !=
+          tinyxml2::XML_SUCCESS)
+      {
+        ignerr << "Failed to parse <scene_page_timeout_ms> value: "
+               << elem->GetText() << std::endl;
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("mesh_retention");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      if (elem->QueryUnsignedText(&this->dataPtr->meshRetention) !=
+          tinyxml2::XML_SUCCESS)
+      {
+        ignerr << "Failed to parse <mesh_retention> value: "
+               << elem->GetText() << std::endl;
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("mesh_lod_levels");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      if (elem->QueryUnsignedText(&this->dataPtr->meshLodLevels) !=
+          tinyxml2::XML_SUCCESS)
+      {
+        ignerr << "Failed to parse <mesh_lod_levels> value: "
+               << elem->GetText() << std::endl;
+      }
+      else if (this->dataPtr->meshLodLevels > 3u)
+      {
+        ignwarn << "Clamping <mesh_lod_levels> ["
+                << this->dataPtr->meshLodLevels << "] to 3" << std::endl;
+        this->dataPtr->meshLodLevels = 3u;
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("mesh_lod_min_triangles");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      if (elem->QueryUnsignedText(&this->dataPtr->meshLodMinTriangles) !=
+          tinyxml2::XML_SUCCESS)
+      {
+        ignerr << "Failed to parse <mesh_lod_min_triangles> value: "
+               << elem->GetText() << std::endl;
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("instancing");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      if (elem->QueryBoolText(&this->dataPtr->instancing) !=
+          tinyxml2::XML_SUCCESS)
+      {
+        ignerr << "Failed to parse <instancing> value: "
+               << elem->GetText() << std::endl;
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("interpolation_delay_ms");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      double delay;
+      if (elem->QueryDoubleText(&delay) == tinyxml2::XML_SUCCESS)
+      {
+        this->dataPtr->interpolate = delay >= 0.0;
+        this->dataPtr->interpolationDelay = delay * 1e-3;
+      }
+      else
+      {
+        ignerr << "Failed to parse <interpolation_delay_ms> value: "
+               << elem->GetText() << std::endl;
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("extrapolation_ms");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      double limit;
+      if (elem->QueryDoubleText(&limit) == tinyxml2::XML_SUCCESS)
+      {
+        this->dataPtr->extrapolationLimit = std::max(0.0, limit * 1e-3);
+      }
+      else
+      {
+        ignerr << "Failed to parse <extrapolation_ms> value: "
+               << elem->GetText() << std::endl;
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("position_epsilon");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      if (elem->QueryDoubleText(&this->dataPtr->positionEpsilon) !=
+          tinyxml2::XML_SUCCESS)
+      {
+        ignerr << "Failed to parse <position_epsilon> value: "
+               << elem->GetText() << std::endl;
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("rotation_epsilon");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      if (elem->QueryDoubleText(&this->dataPtr->rotationEpsilon) !=
+          tinyxml2::XML_SUCCESS)
+      {
+        ignerr << "Failed to parse <rotation_epsilon> value: "
+               << elem->GetText() << std::endl;
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("load_budget_ms");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      double budget;
+      if (elem->QueryDoubleText(&budget) == tinyxml2::XML_SUCCESS)
+      {
+        this->dataPtr->loadBudget =
+            std::chrono::duration<double, std::milli>(budget);
+      }
+      else
+      {
+        ignerr << "Failed to parse <load_budget_ms> value: "
+               << elem->GetText() << std::endl;
+      }
+    }
   }
 
   QQmlProperty::write(this->PluginItem(), "service",
@@ -258,10 +837,13 @@ void TransportSceneManager::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 /////////////////////////////////////////////////
 void TransportSceneManagerPrivate::InitializeTransport()
 {
-  this->Request();
-
-  if (!this->node.Subscribe(this->poseTopic,
-      &TransportSceneManagerPrivate::OnPoseVMsg, this))
+  auto poseCb = [this](const char *_data, const std::size_t _size,
+      const transport::MessageInfo &_info)
+  {
+    this->OnPoseVRaw(_data, _size, _info);
+  };
+  if (!this->node.SubscribeRaw(this->poseTopic, poseCb,
+      msgs::Pose_V().GetTypeName()))
   {
     ignerr << "Error subscribing to pose topic: " << this->poseTopic
       << std::endl;
@@ -272,6 +854,21 @@ void TransportSceneManagerPrivate::InitializeTransport()
            << std::endl;
   }
 
+  if (!this->packedPoseTopic.empty())
+  {
+    if (!this->node.Subscribe(this->packedPoseTopic,
+        &TransportSceneManagerPrivate::OnPackedPoseMsg, this))
+    {
+      ignerr << "Error subscribing to packed pose topic: "
+             << this->packedPoseTopic << std::endl;
+    }
+    else
+    {
+      ignmsg << "Listening to packed pose messages on ["
+             << this->packedPoseTopic << "]" << std::endl;
+    }
+  }
+
   if (!this->node.Subscribe(this->deletionTopic,
       &TransportSceneManagerPrivate::OnDeletionMsg, this))
   {
@@ -284,8 +881,13 @@ void TransportSceneManagerPrivate::InitializeTransport()
            << "]" << std::endl;
   }
 
-  if (!this->node.Subscribe(this->sceneTopic,
-      &TransportSceneManagerPrivate::OnSceneMsg, this))
+  auto sceneCb = [this](const char *_data, const std::size_t _size,
+      const transport::MessageInfo &_info)
+  {
+    this->OnSceneRaw(_data, _size, _info);
+  };
+  if (!this->node.SubscribeRaw(this->sceneTopic, sceneCb,
+      msgs::Scene().GetTypeName()))
   {
     ignerr << "Error subscribing to scene topic: " << this->sceneTopic
            << std::endl;
@@ -296,6 +898,9 @@ void TransportSceneManagerPrivate::InitializeTransport()
            << std::endl;
   }
 
+  if (!this->Request())
+    return;
+
   ignmsg << "Transport initialized." << std::endl;
 }
 
@@ -305,6 +910,9 @@ bool TransportSceneManager::eventFilter(QObject *_obj, QEvent *_event)
   if (_event->type() == events::Render::kType)
   {
     this->dataPtr->OnRender();
+
+    if (this->dataPtr->UpdateStats())
+      QMetaObject::invokeMethod(this, "ProcessStats");
   }
 
   // Standard event processing
@@ -312,182 +920,717 @@ bool TransportSceneManager::eventFilter(QObject *_obj, QEvent *_event)
 }
 
 /////////////////////////////////////////////////
-void TransportSceneManagerPrivate::Request()
+void TransportSceneManager::ProcessStats()
+{
+  this->PoseUpdatesChanged();
+  this->ResourcesChanged();
+}
+
+/////////////////////////////////////////////////
+int TransportSceneManager::AppliedPoseUpdates() const
+{
+  return this->dataPtr->appliedPoseUpdates;
+}
+
+/////////////////////////////////////////////////
+int TransportSceneManager::SkippedPoseUpdates() const
+{
+  return this->dataPtr->skippedPoseUpdates;
+}
+
+/////////////////////////////////////////////////
+double TransportSceneManager::MeshMemory() const
+{
+  return this->dataPtr->meshMemory;
+}
+
+/////////////////////////////////////////////////
+int TransportSceneManager::MaterialCount() const
+{
+  return this->dataPtr->materialCount;
+}
+
+/////////////////////////////////////////////////
+bool TransportSceneManagerPrivate::Request()
 {
-  // wait for the service to be advertized
+  // wait for the service to be advertized, preferring the paged one
+  igndbg << "Waiting for service [" << this->service << "]" << std::endl;
+  const std::string pagedService = PagedScene::Service(this->service);
   std::vector<transport::ServicePublisher> publishers;
-  const std::chrono::duration<double> sleepDuration{1.0};
-  const std::size_t tries = 30;
-  for (std::size_t i = 0; i < tries; ++i)
+  bool paged{false};
+  const bool found = this->serviceWaiter.Wait([&]
   {
-    this->node.ServiceInfo(this->service, publishers);
-    if (publishers.size() > 0)
-      break;
-    std::this_thread::sleep_for(sleepDuration);
-    igndbg << "Waiting for service [" << this->service << "]\n";
+    paged = this->node.ServiceInfo(pagedService, publishers) &&
+        !publishers.empty();
+    return paged || (this->node.ServiceInfo(this->service, publishers) &&
+        !publishers.empty());
+  });
+
+  if (this->serviceWaiter.Cancelled())
+    return false;
+
+  if (found && paged)
+  {
+    // Pages are loaded as they arrive, while the next ones are requested
+    const bool complete = PagedScene::Fetch(this->node, pagedService,
+        this->scenePageSize, this->scenePageTimeout,
+        [this](msgs::Scene &&_page, bool _last)
+        {
+          this->OnScenePage(
+              std::make_shared<msgs::Scene>(std::move(_page)), _last);
+          return !this->serviceWaiter.Cancelled();
+        },
+        [this]
+        {
+          return this->serviceWaiter.Cancelled();
+        });
+
+    if (!complete && !this->serviceWaiter.Cancelled())
+    {
+      ignerr << "Error requesting scene pages from [" << pagedService << "]"
+             << std::endl;
+    }
+  }
+  else if (!found || !this->RequestScene())
+  {
+    ignerr << "Error making service request to [" << this->service << "]"
+           << std::endl;
+  }
+
+  // Updates are applied even if the scene couldn't be received
+  this->ReleaseHeldMsgs();
+  return !this->serviceWaiter.Cancelled();
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::ReleaseHeldMsgs()
+{
+  std::lock_guard<std::mutex> lock(this->msgMutex);
+  this->holdMsgs = false;
+  this->sceneMsgs.insert(this->sceneMsgs.end(),
+      this->heldSceneMsgs.begin(), this->heldSceneMsgs.end());
+  this->toDeleteEntities.insert(this->toDeleteEntities.end(),
+      this->heldDeletions.begin(), this->heldDeletions.end());
+  this->heldSceneMsgs.clear();
+  this->heldSceneMsgs.shrink_to_fit();
+  this->heldDeletions.clear();
+  this->heldDeletions.shrink_to_fit();
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::OnPoseVMsg(const msgs::Pose_V &_msg)
+{
+  std::lock_guard<std::mutex> lock(this->poseWriterMutex);
+
+  auto &frame = this->poseBuffer.Back();
+  frame.Clear();
+  frame.Reserve(_msg.pose_size());
+  for (int i = 0; i < _msg.pose_size(); ++i)
+  {
+    const auto &pose = _msg.pose(i);
+
+    // Same defaults as msgs::Convert, a missing orientation is identity
+    if (pose.has_orientation())
+    {
+      frame.Add(pose.id(),
+          pose.position().x(), pose.position().y(), pose.position().z(),
+          pose.orientation().w(), pose.orientation().x(),
+          pose.orientation().y(), pose.orientation().z());
+    }
+    else
+    {
+      frame.Add(pose.id(),
+          pose.position().x(), pose.position().y(), pose.position().z(),
+          1.0, 0.0, 0.0, 0.0);
+    }
+  }
+  if (_msg.has_header() && _msg.header().has_stamp())
+  {
+    frame.hasStamp = true;
+    frame.stamp = std::chrono::seconds(_msg.header().stamp().sec()) +
+        std::chrono::nanoseconds(_msg.header().stamp().nsec());
+  }
+  frame.received = std::chrono::steady_clock::now();
+  this->poseBuffer.Publish();
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::OnPoseVRaw(const char *_data,
+    const std::size_t _size, const transport::MessageInfo &/*_info*/)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->poseWriterMutex);
+    auto &frame = this->poseBuffer.Back();
+    if (PoseVDecoder::Decode(_data, _size, frame))
+    {
+      frame.received = std::chrono::steady_clock::now();
+      this->poseBuffer.Publish();
+      return;
+    }
+  }
+
+  // Fall back to protobuf for payloads with fields the decoder doesn't know
+  msgs::Pose_V msg;
+  if (!msg.ParseFromArray(_data, static_cast<int>(_size)))
+  {
+    ignerr << "Failed to parse pose message on [" << this->poseTopic << "]"
+           << std::endl;
+    return;
+  }
+  this->OnPoseVMsg(msg);
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::OnPackedPoseMsg(const msgs::Bytes &_msg)
+{
+  std::lock_guard<std::mutex> lock(this->poseWriterMutex);
+
+  // Decode straight into the back frame, without per pose messages
+  auto &frame = this->poseBuffer.Back();
+  if (!PackedPoses::Decode(_msg.data().data(), _msg.data().size(), frame))
+  {
+    ignerr << "Dropping malformed packed pose message of ["
+           << _msg.data().size() << "] bytes on [" << this->packedPoseTopic
+           << "]" << std::endl;
+    return;
+  }
+  frame.received = std::chrono::steady_clock::now();
+  this->poseBuffer.Publish();
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::OnDeletionMsg(const msgs::UInt32_V &_msg)
+{
+  std::lock_guard<std::mutex> lock(this->msgMutex);
+  auto &deletions =
+      this->holdMsgs ? this->heldDeletions : this->toDeleteEntities;
+  std::copy(_msg.data().begin(), _msg.data().end(),
+            std::back_inserter(deletions));
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::OnRender()
+{
+  if (nullptr == this->scene)
+  {
+    this->scene = rendering::sceneFromFirstRenderEngine();
+    if (nullptr == this->scene)
+      return;
+
+    if (!this->cacheWorld.empty())
+      this->sceneCache = std::make_shared<SceneCache>();
+
+    this->meshLoader = std::make_unique<AsyncMeshLoader>(
+        this->meshLoaderThreads, this->sceneCache);
+    this->meshLoader->SetRetention(this->meshRetention);
+    this->meshLoader->SetLod(this->meshLodLevels, this->meshLodMinTriangles);
+    if (this->instancing)
+    {
+      this->instanceBatcher = std::make_unique<InstanceBatcher>(this->scene,
+          this->materialCache);
+    }
+
+    this->LoadCachedScene();
+
+    this->initializeTransport = std::thread(
+        &TransportSceneManagerPrivate::InitializeTransport, this);
+  }
+
+  // Only hold the lock to take the queued messages, so that transport
+  // callbacks don't wait for the scene to be loaded
+  std::vector<std::shared_ptr<const msgs::Scene>> newSceneMsgs;
+  std::vector<unsigned int> newDeletions;
+  std::vector<unsigned int> stale;
+  {
+    std::lock_guard<std::mutex> lock(this->msgMutex);
+    newSceneMsgs.swap(this->sceneMsgs);
+    newDeletions.swap(this->toDeleteEntities);
+    stale.swap(this->staleEntities);
+  }
+
+  // The cached scene was queued on an earlier frame, so its stale entities
+  // are removed before the live scene is queued
+  if (!stale.empty())
+    this->DeleteStaleEntities(stale);
+
+  for (const auto &msg : newSceneMsgs)
+  {
+    this->QueueScene(msg);
+  }
+
+  for (const auto &entity : newDeletions)
+  {
+    this->DeleteEntity(entity);
+  }
+
+  this->LoadPending();
+  this->ProcessLoadedMeshes();
+  this->ProcessLoadedLods();
+
+  // Parsed meshes are all acquired by their visuals by now
+  this->meshLoader->Trim();
+
+  if (this->poseBuffer.Consume())
+    this->ApplyPoses();
+
+  if (this->interpolate)
+    this->Interpolate();
+
+  if (!this->lodEntities.empty())
+    this->UpdateLods();
+
+  // Batches are updated last, once new instances are attached to the scene
+  // and have their latest poses
+  if (this->instanceBatcher)
+    this->instanceBatcher->Update();
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::LoadCachedScene()
+{
+  if (nullptr == this->sceneCache)
+    return;
+
+  auto msg = ArenaMessage::Create<msgs::Scene>();
+  if (!this->sceneCache->LoadScene(this->cacheWorld, *msg))
+  {
+    ignmsg << "No cached scene for world [" << this->cacheWorld << "]"
+           << std::endl;
+    return;
+  }
+
+  ignmsg << "Loading cached scene of world [" << this->cacheWorld << "] with "
+         << msg->model_size() << " models" << std::endl;
+  this->cachedHashes = SceneCache::EntityHashes(*msg);
+  this->QueueScene(msg);
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::DeleteStaleEntities(
+    const std::vector<unsigned int> &_stale)
+{
+  igndbg << "Replacing " << _stale.size()
+         << " entities of the cached scene" << std::endl;
+
+  // Queued entities are dropped from the queue too, otherwise the cached
+  // version could be loaded instead of the live one
+  for (const auto id : _stale)
+    this->DeleteEntity(id);
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::ApplyPoses()
+{
+  const auto &frame = this->poseBuffer.Front();
+  double stamp{0.0};
+  if (this->interpolate)
+    stamp = this->UpdateStampClock(frame);
+
+  // Note that poses of entities which haven't been loaded yet are dropped
+  for (std::size_t i = 0; i < frame.Size(); ++i)
+  {
+    const unsigned int id = frame.ids[i];
+    auto record = this->entities.Find(id);
+    if (nullptr == record)
+      continue;
+
+    const double *p = &frame.positions[i * 3];
+    const double *q = &frame.orientations[i * 4];
+    const math::Pose3d pose(p[0], p[1], p[2], q[0], q[1], q[2], q[3]);
+
+    if (this->interpolate)
+      this->AddPoseSample(*record, pose, stamp);
+    else
+      this->SetEntityPose(id, *record, pose);
+  }
+}
+
+/////////////////////////////////////////////////
+double TransportSceneManagerPrivate::UpdateStampClock(const PoseFrame &_frame)
+{
+  const double stamp = _frame.hasStamp ?
+      std::chrono::duration<double>(_frame.stamp).count() :
+      std::chrono::duration<double>(
+          _frame.received.time_since_epoch()).count();
+
+  if (this->stampValid && stamp < this->latestStamp)
+  {
+    // Time went backwards, e.g. the world was reset. Start over instead of
+    // interpolating towards old poses.
+    for (auto &record : this->entities)
+      record.sampleCount = 0u;
+    this->stampRate = 1.0;
+  }
+  else if (this->stampValid)
+  {
+    const double elapsed = std::chrono::duration<double>(
+        _frame.received - this->latestReceived).count();
+    if (elapsed > 1e-3)
+    {
+      const double rate = std::clamp(
+          (stamp - this->latestStamp) / elapsed, 0.0, 10.0);
+      this->stampRate += 0.2 * (rate - this->stampRate);
+    }
+  }
+
+  this->latestStamp = stamp;
+  this->latestReceived = _frame.received;
+  this->stampValid = true;
+  return stamp;
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::AddPoseSample(EntityRecord &_record,
+    const math::Pose3d &_pose, const double _stamp)
+{
+  if (_record.sampleCount > 0u && _stamp <= _record.sampleStamps[1])
+  {
+    // Drop poses older than the newest one, replace poses with its stamp
+    if (_stamp < _record.sampleStamps[1])
+      return;
+    _record.samplePoses[1] = _pose;
+  }
+  else
+  {
+    _record.samplePoses[0] = _record.samplePoses[1];
+    _record.sampleStamps[0] = _record.sampleStamps[1];
+    _record.samplePoses[1] = _pose;
+    _record.sampleStamps[1] = _stamp;
+    _record.sampleCount = std::min(_record.sampleCount + 1u, 2u);
   }
+  _record.interpolating = true;
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::Interpolate()
+{
+  if (!this->stampValid)
+    return;
+
+  // Stamp being rendered, mapped from the local clock
+  const double elapsed = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - this->latestReceived).count();
+  const double renderStamp = this->latestStamp +
+      (elapsed - this->interpolationDelay) * this->stampRate;
+
+  // Iterate backwards, because SetEntityPose may erase the current record,
+  // which moves the last record into its slot
+  for (std::size_t i = this->entities.Size(); i-- > 0u;)
+  {
+    auto &record = this->entities.ValueAt(i);
+    if (!record.interpolating)
+      continue;
+
+    math::Pose3d pose = record.samplePoses[1];
+    const double interval = record.sampleStamps[1] - record.sampleStamps[0];
+    if (record.sampleCount < 2u || interval <= 0.0)
+    {
+      record.interpolating = false;
+    }
+    else
+    {
+      double alpha = (renderStamp - record.sampleStamps[0]) / interval;
+      const double maxAlpha =
+          1.0 + this->extrapolationLimit * this->stampRate / interval;
+      if (alpha >= maxAlpha)
+      {
+        // Stop until the next pose arrives
+        alpha = maxAlpha;
+        record.interpolating = false;
+      }
+      alpha = std::max(alpha, 0.0);
 
-  if (publishers.empty() || !this->node.Request(this->service,
-      &TransportSceneManagerPrivate::OnSceneSrvMsg, this))
-  {
-    ignerr << "Error making service request to [" << this->service << "]"
-           << std::endl;
+      const auto &from = record.samplePoses[0];
+      const auto &to = record.samplePoses[1];
+      pose.Pos() = from.Pos() + (to.Pos() - from.Pos()) * alpha;
+      pose.Rot() = math::Quaterniond::Slerp(alpha, from.Rot(), to.Rot(),
+          true);
+    }
+
+    this->SetEntityPose(this->entities.IdAt(i), record, pose);
   }
 }
 
 /////////////////////////////////////////////////
-void TransportSceneManagerPrivate::OnPoseVMsg(const msgs::Pose_V &_msg)
+void TransportSceneManagerPrivate::SetEntityPose(const unsigned int _id,
+    EntityRecord &_record, const math::Pose3d &_pose)
 {
-  std::lock_guard<std::mutex> lock(this->msgMutex);
-  for (int i = 0; i < _msg.pose_size(); ++i)
+  // Skip entities which didn't move, so that their nodes aren't dirtied
+  if (_record.hasAppliedPose)
   {
-    math::Pose3d pose = msgs::Convert(_msg.pose(i));
-
-    // apply additional local poses if available
-    const auto it = this->localPoses.find(_msg.pose(i).id());
-    if (it != this->localPoses.end())
+    const double distance2 =
+        (_pose.Pos() - _record.appliedPose.Pos()).SquaredLength();
+    const auto &q0 = _pose.Rot();
+    const auto &q1 = _record.appliedPose.Rot();
+    const double dot = std::abs(q0.W() * q1.W() + q0.X() * q1.X() +
+        q0.Y() * q1.Y() + q0.Z() * q1.Z());
+    if (distance2 <= this->positionEpsilon * this->positionEpsilon &&
+        dot >= std::cos(this->rotationEpsilon * 0.5))
     {
-      pose = pose * it->second;
+      ++this->skippedCount;
+      return;
     }
+  }
+  _record.appliedPose = _pose;
+  _record.hasAppliedPose = true;
+  ++this->appliedCount;
 
-    this->poses[_msg.pose(i).id()] = pose;
+  // apply additional local poses
+  const math::Pose3d pose = _pose * _record.localPose;
+
+  if (auto visual = _record.visual.lock())
+  {
+    visual->SetLocalPose(pose);
+    if (this->instanceBatcher)
+      this->instanceBatcher->MarkDirty(visual->Id());
+  }
+  else if (auto light = _record.light.lock())
+  {
+    light->SetLocalPose(pose);
+  }
+  else
+  {
+    // The node was destroyed together with an ancestor
+    this->ReleaseResources(_record);
+    this->entities.Erase(_id);
   }
 }
 
 /////////////////////////////////////////////////
-void TransportSceneManagerPrivate::OnDeletionMsg(const msgs::UInt32_V &_msg)
+bool TransportSceneManagerPrivate::UpdateStats()
 {
-  std::lock_guard<std::mutex> lock(this->msgMutex);
-  std::copy(_msg.data().begin(), _msg.data().end(),
-            std::back_inserter(this->toDeleteEntities));
+  const auto now = std::chrono::steady_clock::now();
+  if (now - this->statsStart < std::chrono::seconds(1))
+    return false;
+
+  this->appliedPoseUpdates = this->appliedCount;
+  this->skippedPoseUpdates = this->skippedCount;
+  if (this->meshLoader)
+  {
+    this->meshMemory =
+        static_cast<double>(this->meshLoader->MemoryUsage()) / (1 << 20);
+  }
+  this->materialCount = static_cast<int>(this->materialCache.Size());
+  this->appliedCount = 0;
+  this->skippedCount = 0;
+  this->statsStart = now;
+  return true;
 }
 
 /////////////////////////////////////////////////
-void TransportSceneManagerPrivate::OnRender()
+void TransportSceneManagerPrivate::OnSceneRaw(const char *_data,
+    const std::size_t _size, const transport::MessageInfo &/*_info*/)
 {
-  if (nullptr == this->scene)
+  auto msg = ArenaMessage::Parse<msgs::Scene>(_data, _size);
+  if (nullptr == msg)
   {
-    this->scene = rendering::sceneFromFirstRenderEngine();
-    if (nullptr == this->scene)
-      return;
-
-    this->initializeTransport = std::thread(
-        &TransportSceneManagerPrivate::InitializeTransport, this);
+    ignerr << "Dropping malformed scene message of [" << _size
+           << "] bytes on [" << this->sceneTopic << "]" << std::endl;
+    return;
   }
 
   std::lock_guard<std::mutex> lock(this->msgMutex);
+  if (this->holdMsgs)
+    this->heldSceneMsgs.push_back(std::move(msg));
+  else
+    this->sceneMsgs.push_back(std::move(msg));
+}
 
-  for (const auto &msg : this->sceneMsgs)
+/////////////////////////////////////////////////
+bool TransportSceneManagerPrivate::RequestScene()
+{
+  // The reply is copied straight into an arena. The request is made
+  // asynchronously, so that a newer request or shutdown cancels it right
+  // away instead of waiting for the reply or the timeout.
+  const unsigned int timeout{30000u};
+  auto msg = ArenaMessage::Create<msgs::Scene>();
+  if (!PagedScene::FetchWhole(this->node, this->service, timeout, msg,
+      [this] { return this->serviceWaiter.Cancelled(); }))
   {
-    this->LoadScene(msg);
+    return false;
   }
-  this->sceneMsgs.clear();
 
-  for (const auto &entity : this->toDeleteEntities)
-  {
-    this->DeleteEntity(entity);
-  }
-  this->toDeleteEntities.clear();
+  this->OnScenePage(msg, true);
+  return true;
+}
 
-  for (auto pIt = this->poses.begin(); pIt != this->poses.end();)
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::OnScenePage(
+    const std::shared_ptr<msgs::Scene> &_msg, const bool _last)
+{
+  std::vector<unsigned int> stale;
+  if (this->sceneCache)
   {
-    auto vIt = this->visuals.find(pIt->first);
-    if (vIt != this->visuals.end())
+    // Cached entities which changed are recreated. Those which are left
+    // once the whole scene is received were removed from the world.
+    for (const auto &entity : SceneCache::EntityHashes(*_msg))
     {
-      auto visual = vIt->second.lock();
-      if (visual)
+      auto it = this->cachedHashes.find(entity.first);
+      if (it == this->cachedHashes.end())
       {
-        visual->SetLocalPose(pIt->second);
+        this->liveSceneChanged = true;
+        continue;
       }
-      else
+      if (it->second != entity.second)
       {
-        this->visuals.erase(vIt);
+        stale.push_back(entity.first);
+        this->liveSceneChanged = true;
       }
-      this->poses.erase(pIt++);
+      this->cachedHashes.erase(it);
     }
-    else
+
+    this->livePages.push_back(_msg);
+    if (_last)
     {
-      auto lIt = this->lights.find(pIt->first);
-      if (lIt != this->lights.end())
+      for (const auto &entity : this->cachedHashes)
+        stale.push_back(entity.first);
+      this->liveSceneChanged |= !this->cachedHashes.empty();
+      this->cachedHashes.clear();
+
+      // The cached scene is only rewritten if its entities changed
+      std::vector<std::shared_ptr<const msgs::Scene>> pages;
+      pages.swap(this->livePages);
+      if (this->liveSceneChanged)
       {
-        auto light = lIt->second.lock();
-        if (light)
-        {
-          light->SetLocalPose(pIt->second);
-        }
-        else
-        {
-          this->lights.erase(lIt);
-        }
-        this->poses.erase(pIt++);
-      }
-      else
-      {
-        ++pIt;
+        if (this->cacheWriter.joinable())
+          this->cacheWriter.join();
+        this->cacheWriter = std::thread(
+            [cache = this->sceneCache, world = this->cacheWorld,
+             pages = std::move(pages)]
+            {
+              cache->SaveScene(world, pages);
+            });
       }
+      this->liveSceneChanged = false;
     }
   }
 
-  // Note we are clearing the pose msgs here but later on we may need to
-  // consider the case where pose msgs arrive before scene/visual msgs
-  this->poses.clear();
-}
-
-/////////////////////////////////////////////////
-void TransportSceneManagerPrivate::OnSceneMsg(const msgs::Scene &_msg)
-{
-  std::lock_guard<std::mutex> lock(this->msgMutex);
-  this->sceneMsgs.push_back(_msg);
+  {
+    std::lock_guard<std::mutex> lock(this->msgMutex);
+    this->staleEntities.insert(this->staleEntities.end(), stale.begin(),
+        stale.end());
+    this->sceneMsgs.push_back(_msg);
+  }
 }
 
 /////////////////////////////////////////////////
-void TransportSceneManagerPrivate::OnSceneSrvMsg(const msgs::Scene &_msg,
-    const bool result)
+void TransportSceneManagerPrivate::QueueScene(
+    const std::shared_ptr<const msgs::Scene> &_msg)
 {
-  if (!result)
+  // Only add entities which aren't already loaded or queued
+  for (int i = 0; i < _msg->model_size(); ++i)
   {
-    ignerr << "Error making service request to " << this->service
-           << std::endl;
-    return;
+    const auto &model = _msg->model(i);
+    if (this->entities.Contains(model.id()) ||
+        this->pending.Contains(model.id()))
+    {
+      continue;
+    }
+
+    PendingEntity entity;
+    entity.sceneMsg = _msg;
+    entity.index = i;
+    if (model.has_pose())
+      entity.position = msgs::Convert(model.pose().position());
+    this->pending.Push(model.id(), std::move(entity));
   }
 
+  for (int i = 0; i < _msg->light_size(); ++i)
   {
-    std::lock_guard<std::mutex> lock(this->msgMutex);
-    this->sceneMsgs.push_back(_msg);
+    const auto &light = _msg->light(i);
+    if (this->entities.Contains(light.id()) ||
+        this->pending.Contains(light.id()))
+    {
+      continue;
+    }
+
+    PendingEntity entity;
+    entity.sceneMsg = _msg;
+    entity.index = i;
+    entity.isLight = true;
+    this->pending.Push(light.id(), std::move(entity));
   }
+
+  this->pendingUnsorted = true;
 }
 
 /////////////////////////////////////////////////
-void TransportSceneManagerPrivate::LoadScene(const msgs::Scene &_msg)
+void TransportSceneManagerPrivate::LoadPending()
 {
-  rendering::VisualPtr rootVis = this->scene->RootVisual();
+  if (this->pending.Empty())
+    return;
 
-  // load models
-  for (int i = 0; i < _msg.model_size(); ++i)
+  const auto start = std::chrono::steady_clock::now();
+
+  // Sort so the entities closest to the camera are loaded first. Lights are
+  // cheap and affect the whole view, so they go before everything else.
+  math::Vector3d cameraPos;
+  auto cam = this->UserCamera();
+  if (cam)
+    cameraPos = cam->WorldPosition();
+
+  if (this->pendingUnsorted || cameraPos.Distance(this->sortPosition) > 1.0)
   {
-    // Only add if it's not already loaded
-    if (this->visuals.find(_msg.model(i).id()) == this->visuals.end())
+    this->pending.Sort([&cameraPos](const PendingEntity &_entity)
     {
-      rendering::VisualPtr modelVis = this->LoadModel(_msg.model(i));
+      return _entity.isLight ? -1.0 :
+          (_entity.position - cameraPos).SquaredLength();
+    });
+    this->sortPosition = cameraPos;
+    this->pendingUnsorted = false;
+  }
+
+  rendering::VisualPtr rootVis = this->scene->RootVisual();
+  PendingEntity entity;
+  while (this->pending.Pop(entity))
+  {
+    if (entity.isLight)
+    {
+      const auto &msg = entity.sceneMsg->light(entity.index);
+      rendering::LightPtr light = this->LoadLight(msg);
+      if (light)
+        rootVis->AddChild(light);
+      else
+        ignerr << "Failed to load light: " << msg.name() << std::endl;
+    }
+    else
+    {
+      const auto &msg = entity.sceneMsg->model(entity.index);
+      rendering::VisualPtr modelVis = this->LoadModel(msg);
       if (modelVis)
         rootVis->AddChild(modelVis);
       else
-        ignerr << "Failed to load model: " << _msg.model(i).name() << std::endl;
+        ignerr << "Failed to load model: " << msg.name() << std::endl;
+    }
+
+    if (this->loadBudget.count() > 0.0 &&
+        std::chrono::steady_clock::now() - start >= this->loadBudget)
+    {
+      break;
     }
   }
 
-  // load lights
-  for (int i = 0; i < _msg.light_size(); ++i)
+  this->pending.ShrinkToFit();
+}
+
+/////////////////////////////////////////////////
+rendering::CameraPtr TransportSceneManagerPrivate::UserCamera()
+{
+  auto cam = this->camera.lock();
+  if (cam)
+    return cam;
+
+  for (unsigned int i = 0; i < this->scene->NodeCount(); ++i)
   {
-    if (this->lights.find(_msg.light(i).id()) == this->lights.end())
+    cam = std::dynamic_pointer_cast<rendering::Camera>(
+        this->scene->NodeByIndex(i));
+    if (cam)
     {
-      rendering::LightPtr light = this->LoadLight(_msg.light(i));
-      if (light)
-        rootVis->AddChild(light);
-      else
-        ignerr << "Failed to load light: " << _msg.light(i).name() << std::endl;
+      this->camera = cam;
+      break;
     }
   }
+  return cam;
 }
 
 /////////////////////////////////////////////////
@@ -506,16 +1649,24 @@ rendering::VisualPtr TransportSceneManagerPrivate::LoadModel(
 
   if (_msg.has_pose())
     modelVis->SetLocalPose(msgs::Convert(_msg.pose()));
-  this->visuals[_msg.id()] = modelVis;
+  this->entities[_msg.id()].visual = modelVis;
+
+  std::vector<unsigned int> children;
 
   // load links
   for (int i = 0; i < _msg.link_size(); ++i)
   {
     rendering::VisualPtr linkVis = this->LoadLink(_msg.link(i));
     if (linkVis)
+    {
       modelVis->AddChild(linkVis);
+      children.push_back(_msg.link(i).id());
+      this->SetParent(_msg.link(i).id(), _msg.id());
+    }
     else
+    {
       ignerr << "Failed to load link: " << _msg.link(i).name() << std::endl;
+    }
   }
 
   // load nested models
@@ -523,12 +1674,21 @@ rendering::VisualPtr TransportSceneManagerPrivate::LoadModel(
   {
     rendering::VisualPtr nestedModelVis = this->LoadModel(_msg.model(i));
     if (nestedModelVis)
+    {
       modelVis->AddChild(nestedModelVis);
+      children.push_back(_msg.model(i).id());
+      this->SetParent(_msg.model(i).id(), _msg.id());
+    }
     else
+    {
       ignerr << "Failed to load nested model: " << _msg.model(i).name()
              << std::endl;
+    }
   }
 
+  // Looked up again, since loading children may have moved the record
+  this->entities[_msg.id()].children = std::move(children);
+
   return modelVis;
 }
 
@@ -548,16 +1708,24 @@ rendering::VisualPtr TransportSceneManagerPrivate::LoadLink(
 
   if (_msg.has_pose())
     linkVis->SetLocalPose(msgs::Convert(_msg.pose()));
-  this->visuals[_msg.id()] = linkVis;
+  this->entities[_msg.id()].visual = linkVis;
+
+  std::vector<unsigned int> children;
 
   // load visuals
   for (int i = 0; i < _msg.visual_size(); ++i)
   {
     rendering::VisualPtr visualVis = this->LoadVisual(_msg.visual(i));
     if (visualVis)
+    {
       linkVis->AddChild(visualVis);
+      children.push_back(_msg.visual(i).id());
+      this->SetParent(_msg.visual(i).id(), _msg.id());
+    }
     else
+    {
       ignerr << "Failed to load visual: " << _msg.visual(i).name() << std::endl;
+    }
   }
 
   // load lights
@@ -565,11 +1733,20 @@ rendering::VisualPtr TransportSceneManagerPrivate::LoadLink(
   {
     rendering::LightPtr light = this->LoadLight(_msg.light(i));
     if (light)
+    {
       linkVis->AddChild(light);
+      children.push_back(_msg.light(i).id());
+      this->SetParent(_msg.light(i).id(), _msg.id());
+    }
     else
+    {
       ignerr << "Failed to load light: " << _msg.light(i).name() << std::endl;
+    }
   }
 
+  // Looked up again, since loading children may have moved the record
+  this->entities[_msg.id()].children = std::move(children);
+
   return linkVis;
 }
 
@@ -590,48 +1767,89 @@ rendering::VisualPtr TransportSceneManagerPrivate::LoadVisual(
     visualVis = this->scene->CreateVisual();
   }
 
-  this->visuals[_msg.id()] = visualVis;
+  this->entities[_msg.id()].visual = visualVis;
+
+  const auto &filename = _msg.geometry().mesh().filename();
+  if (_msg.geometry().has_mesh() && !filename.empty())
+  {
+    // Meshes have no additional local pose
+    if (_msg.has_pose())
+      visualVis->SetLocalPose(msgs::Convert(_msg.pose()));
+
+    // Mesh files are parsed in the background. Until then, the visual is an
+    // empty placeholder which can already be posed and deleted.
+    std::shared_ptr<common::Mesh> mesh;
+    if (!this->meshLoader->Request(filename, mesh))
+    {
+      this->pendingMeshVisuals[filename].push_back({visualVis, _msg});
+      return visualVis;
+    }
+  }
+
+  this->LoadVisualGeometry(visualVis, _msg);
+  return visualVis;
+}
 
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::LoadVisualGeometry(
+    const rendering::VisualPtr &_visual, const msgs::Visual &_msg)
+{
   math::Vector3d scale = math::Vector3d::One;
+  std::string unitMesh;
+  if (this->instanceBatcher &&
+      InstanceBatcher::Supports(_msg.geometry(), unitMesh, scale))
+  {
+    // Transparent instances can't be sorted within a batch, so they keep
+    // their own geometry
+    auto material = this->LoadMaterial(_msg);
+    if (material->Transparency() <= 0.0)
+    {
+      if (_msg.has_pose())
+        _visual->SetLocalPose(msgs::Convert(_msg.pose()));
+      this->instanceBatcher->Add(_visual, unitMesh, scale, material);
+      return;
+    }
+  }
+
   math::Pose3d localPose;
   rendering::GeometryPtr geom =
       this->LoadGeometry(_msg.geometry(), scale, localPose);
 
-  if (_msg.has_pose())
-    visualVis->SetLocalPose(msgs::Convert(_msg.pose()) * localPose);
-  else
-    visualVis->SetLocalPose(localPose);
+  // The pose of mesh visuals is set by LoadVisual, because they may have
+  // been posed while waiting for the mesh to be parsed
+  if (!_msg.geometry().has_mesh() || _msg.geometry().mesh().filename().empty())
+  {
+    if (_msg.has_pose())
+      _visual->SetLocalPose(msgs::Convert(_msg.pose()) * localPose);
+    else
+      _visual->SetLocalPose(localPose);
+  }
 
   if (geom)
   {
-    // store the local pose
-    this->localPoses[_msg.id()] = localPose;
+    // store the local pose and the resources used by the geometry
+    auto &record = this->entities[_msg.id()];
+    record.localPose = localPose;
+    if (_msg.geometry().has_mesh())
+    {
+      record.mesh = _msg.geometry().mesh().filename();
+      this->meshLoader->Acquire(record.mesh);
+    }
 
-    visualVis->AddGeometry(geom);
-    visualVis->SetLocalScale(scale);
+    _visual->AddGeometry(geom);
+    _visual->SetLocalScale(scale);
 
     // set material
-    rendering::MaterialPtr material{nullptr};
-    if (_msg.has_material())
-    {
-      material = this->LoadMaterial(_msg.material());
-    }
     // Don't set a default material for meshes because they
     // may have their own
     // TODO(anyone) support overriding mesh material
-    else if (!_msg.geometry().has_mesh())
+    if (_msg.has_material() || !_msg.geometry().has_mesh())
     {
-      // create default material
-      material = this->scene->Material("ign-grey");
-      if (!material)
-      {
-        material = this->scene->CreateMaterial("ign-grey");
-        material->SetAmbient(0.3, 0.3, 0.3);
-        material->SetDiffuse(0.7, 0.7, 0.7);
-        material->SetSpecular(1.0, 1.0, 1.0);
-        material->SetRoughness(0.2f);
-        material->SetMetalness(1.0f);
-      }
+      // The material is shared with other visuals that look the same, so
+      // don't let the geometry clone it
+      record.material = this->LoadMaterial(_msg);
+      this->materialCache.Acquire(record.material);
+      geom->SetMaterial(record.material, false);
     }
     else
     {
@@ -652,29 +1870,170 @@ rendering::VisualPtr TransportSceneManagerPrivate::LoadVisual(
       }
     }
 
-    if (material)
+    if (!record.mesh.empty())
+      this->AddLods(_msg.id(), record);
+  }
+  else
+  {
+    ignerr << "Failed to load geometry for visual: " << _msg.name()
+           << std::endl;
+  }
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::ProcessLoadedMeshes()
+{
+  for (const auto &filename : this->meshLoader->TakeFinished())
+  {
+    auto it = this->pendingMeshVisuals.find(filename);
+    if (it == this->pendingMeshVisuals.end())
+      continue;
+
+    auto waiting = std::move(it->second);
+    this->pendingMeshVisuals.erase(it);
+
+    for (const auto &pendingVisual : waiting)
+    {
+      // Skip visuals deleted while the mesh was being parsed
+      auto visual = pendingVisual.visual.lock();
+      if (visual)
+        this->LoadVisualGeometry(visual, pendingVisual.msg);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::ProcessLoadedLods()
+{
+  for (const auto &filename : this->meshLoader->TakeFinishedLods())
+  {
+    // Levels of detail of a mesh are built once, so scanning all entities
+    // is rare
+    for (std::size_t slot = 0u; slot < this->entities.Size(); ++slot)
     {
-      // set transparency
-      material->SetTransparency(_msg.transparency());
+      auto &record = this->entities.ValueAt(slot);
+      if (record.mesh == filename && record.lods.empty())
+        this->AddLods(this->entities.IdAt(slot), record);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::AddLods(const unsigned int _id,
+    EntityRecord &_record)
+{
+  auto meshes = this->meshLoader->Lods(_record.mesh);
+  auto visual = _record.visual.lock();
+  if (meshes.empty() || nullptr == visual || visual->GeometryCount() == 0u)
+    return;
+
+  auto full = std::dynamic_pointer_cast<rendering::Mesh>(
+      visual->GeometryByIndex(0u));
+  if (nullptr == full)
+    return;
 
-      // cast shadows
-      material->SetCastShadows(_msg.cast_shadows());
+  // `meshes` keeps the levels of detail alive while descriptors point to
+  // them, even if they're trimmed meanwhile
+  _record.lods.push_back(full);
+  for (const auto &mesh : meshes)
+  {
+    rendering::MeshDescriptor descriptor;
+    descriptor.meshName = mesh->Name();
+    descriptor.mesh = mesh.get();
+    auto geom = this->scene->CreateMesh(descriptor);
+    if (nullptr == geom)
+      break;
 
-      geom->SetMaterial(material);
-      // todo(anyone) SetMaterial function clones the input material.
-      // but does not take ownership of it so we need to destroy it here.
-      // This is not ideal. We should let gz-rendering handle the lifetime
-      // of this material
-      this->scene->DestroyMaterial(material);
+    // Simplified meshes have the same submeshes as the full mesh. Shared
+    // materials are shared, the ones owned by the full mesh are cloned.
+    if (_record.material)
+    {
+      geom->SetMaterial(_record.material, false);
+    }
+    else
+    {
+      const unsigned int count =
+          std::min(geom->SubMeshCount(), full->SubMeshCount());
+      for (unsigned int i = 0u; i < count; ++i)
+      {
+        auto material = full->SubMeshByIndex(i)->Material();
+        if (material)
+          geom->SubMeshByIndex(i)->SetMaterial(material);
+      }
     }
+    _record.lods.push_back(geom);
   }
-  else
+
+  if (_record.lods.size() < 2u)
   {
-    ignerr << "Failed to load geometry for visual: " << _msg.name()
-           << std::endl;
+    _record.lods.clear();
+    return;
   }
 
-  return visualVis;
+  const auto &mesh = meshes.front();
+  _record.lodRadius = (mesh->Max() - mesh->Min()).Length() * 0.5;
+  _record.lod = 0u;
+  this->lodEntities.push_back(_id);
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::UpdateLods()
+{
+  auto cam = this->UserCamera();
+  if (nullptr == cam)
+    return;
+
+  const math::Vector3d eye = cam->WorldPosition();
+  const double tanHalfFov =
+      std::tan(cam->HFOV().Radian() * 0.5) / cam->AspectRatio();
+
+  // Level used for a fraction of the viewport height
+  auto level = [](const double _size, const std::size_t _count)
+  {
+    unsigned int result{0u};
+    double threshold = kLodScreenSize;
+    while (result + 1u < _count && _size < threshold)
+    {
+      ++result;
+      threshold *= 0.5;
+    }
+    return result;
+  };
+
+  auto it = this->lodEntities.begin();
+  while (it != this->lodEntities.end())
+  {
+    auto record = this->entities.Find(*it);
+    auto visual = record ? record->visual.lock() : nullptr;
+    if (nullptr == visual || record->lods.empty())
+    {
+      it = this->lodEntities.erase(it);
+      continue;
+    }
+    ++it;
+
+    const double distance =
+        std::max((visual->WorldPosition() - eye).Length(), 1e-6);
+    const double size = record->lodRadius * visual->WorldScale().Max() /
+        (distance * tanHalfFov);
+
+    // Sizes close to a threshold keep the current level, so that levels
+    // don't flicker while the camera moves
+    const std::size_t count = record->lods.size();
+    unsigned int lod = record->lod;
+    const unsigned int coarser = level(size * 1.1, count);
+    const unsigned int finer = level(size * 0.9, count);
+    if (coarser > lod)
+      lod = coarser;
+    else if (finer < lod)
+      lod = finer;
+    if (lod == record->lod)
+      continue;
+
+    visual->RemoveGeometry(record->lods[record->lod]);
+    visual->AddGeometry(record->lods[lod]);
+    record->lod = lod;
+  }
 }
 
 /////////////////////////////////////////////////
@@ -749,14 +2108,16 @@ rendering::GeometryPtr TransportSceneManagerPrivate::LoadGeometry(
       ignerr << "Mesh geometry missing filename" << std::endl;
       return geom;
     }
-    rendering::MeshDescriptor descriptor;
+    // The mesh has already been parsed by the mesh loader
+    std::shared_ptr<common::Mesh> mesh;
+    this->meshLoader->Request(_msg.mesh().filename(), mesh);
+    if (nullptr == mesh)
+      return geom;
 
-    // Assume absolute path to mesh file
+    // `mesh` keeps the parsed mesh alive while the descriptor points to it
+    rendering::MeshDescriptor descriptor;
     descriptor.meshName = _msg.mesh().filename();
-
-    gz::common::MeshManager* meshManager =
-        gz::common::MeshManager::Instance();
-    descriptor.mesh = meshManager->Load(descriptor.meshName);
+    descriptor.mesh = mesh.get();
     geom = this->scene->CreateMesh(descriptor);
 
     scale = msgs::Convert(_msg.mesh().scale());
@@ -772,26 +2133,57 @@ rendering::GeometryPtr TransportSceneManagerPrivate::LoadGeometry(
 
 /////////////////////////////////////////////////
 rendering::MaterialPtr TransportSceneManagerPrivate::LoadMaterial(
-    const msgs::Material &_msg)
+    const msgs::Visual &_msg)
 {
-  rendering::MaterialPtr material = this->scene->CreateMaterial();
-  if (_msg.has_ambient())
+  // Unset colors keep the material defaults, so they're part of the key too
+  const msgs::Material &matMsg = _msg.material();
+  MaterialKey key;
+  key.Add(_msg.has_material())
+     .Add(_msg.transparency())
+     .Add(_msg.cast_shadows());
+  if (_msg.has_material())
   {
-    material->SetAmbient(msgs::Convert(_msg.ambient()));
+    key.Add(matMsg.has_ambient()).Add(matMsg.ambient())
+       .Add(matMsg.has_diffuse()).Add(matMsg.diffuse())
+       .Add(matMsg.has_specular()).Add(matMsg.specular())
+       .Add(matMsg.has_emissive()).Add(matMsg.emissive());
   }
-  if (_msg.has_diffuse())
+
+  rendering::MaterialPtr material = this->materialCache.Find(this->scene,
+      key);
+  if (material)
+    return material;
+
+  material = this->scene->CreateMaterial();
+  if (!_msg.has_material())
   {
-    material->SetDiffuse(msgs::Convert(_msg.diffuse()));
+    // default material
+    material->SetAmbient(0.3, 0.3, 0.3);
+    material->SetDiffuse(0.7, 0.7, 0.7);
+    material->SetSpecular(1.0, 1.0, 1.0);
+    material->SetRoughness(0.2f);
+    material->SetMetalness(1.0f);
   }
-  if (_msg.has_specular())
+  if (matMsg.has_ambient())
+  {
+    material->SetAmbient(msgs::Convert(matMsg.ambient()));
+  }
+  if (matMsg.has_diffuse())
+  {
+    material->SetDiffuse(msgs::Convert(matMsg.diffuse()));
+  }
+  if (matMsg.has_specular())
   {
-    material->SetDiffuse(msgs::Convert(_msg.specular()));
+    material->SetSpecular(msgs::Convert(matMsg.specular()));
   }
-  if (_msg.has_emissive())
+  if (matMsg.has_emissive())
   {
-    material->SetEmissive(msgs::Convert(_msg.emissive()));
+    material->SetEmissive(msgs::Convert(matMsg.emissive()));
   }
+  material->SetTransparency(_msg.transparency());
+  material->SetCastShadows(_msg.cast_shadows());
 
+  this->materialCache.Insert(key, material);
   return material;
 }
 
@@ -847,30 +2239,102 @@ rendering::LightPtr TransportSceneManagerPrivate::LoadLight(
 
   light->SetCastShadows(_msg.cast_shadows());
 
-  this->lights[_msg.id()] = light;
+  this->entities[_msg.id()].light = light;
   return light;
 }
 
 /////////////////////////////////////////////////
 void TransportSceneManagerPrivate::DeleteEntity(const unsigned int _entity)
 {
-  if (this->visuals.find(_entity) != this->visuals.end())
+  // Entities which are still queued are just dropped from the queue, so
+  // that they aren't loaded if they're queued again
+  if (this->pending.Remove(_entity))
+    return;
+
+  auto record = this->entities.Find(_entity);
+  if (nullptr == record)
+    return;
+
+  if (auto visual = record->visual.lock())
+  {
+    if (this->instanceBatcher)
+      this->instanceBatcher->MarkDirty(visual->Id());
+    this->scene->DestroyVisual(visual, true);
+  }
+  else if (auto light = record->light.lock())
+  {
+    this->scene->DestroyLight(light, true);
+  }
+
+  // Stop listing it in its parent, in case the parent is deleted later
+  if (record->hasParent)
   {
-    auto visual = this->visuals[_entity].lock();
-    if (visual)
+    if (auto parent = this->entities.Find(record->parent))
     {
-      this->scene->DestroyVisual(visual, true);
+      auto &siblings = parent->children;
+      siblings.erase(std::remove(siblings.begin(), siblings.end(), _entity),
+          siblings.end());
     }
-    this->visuals.erase(_entity);
   }
-  else if (this->lights.find(_entity) != this->lights.end())
+
+  // The whole subtree was destroyed recursively, purge all of its records.
+  // Children whose id was reused by an entity loaded elsewhere are skipped.
+  std::vector<std::pair<unsigned int, unsigned int>> subtree;
+  for (const auto child : record->children)
+    subtree.emplace_back(child, _entity);
+  this->ReleaseResources(*record);
+  this->entities.Erase(_entity);
+
+  while (!subtree.empty())
   {
-    auto light = this->lights[_entity].lock();
-    if (light)
+    const unsigned int id = subtree.back().first;
+    const unsigned int parent = subtree.back().second;
+    subtree.pop_back();
+
+    auto subRecord = this->entities.Find(id);
+    if (nullptr == subRecord || !subRecord->hasParent ||
+        subRecord->parent != parent)
     {
-      this->scene->DestroyLight(light, true);
+      continue;
     }
-    this->lights.erase(_entity);
+
+    for (const auto child : subRecord->children)
+      subtree.emplace_back(child, id);
+    this->ReleaseResources(*subRecord);
+    this->entities.Erase(id);
+  }
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::SetParent(const unsigned int _entity,
+    const unsigned int _parent)
+{
+  auto &record = this->entities[_entity];
+  record.parent = _parent;
+  record.hasParent = true;
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::ReleaseResources(EntityRecord &_record)
+{
+  // The attached level of detail is destroyed with the visual, the others
+  // are destroyed here
+  for (std::size_t i = 0u; i < _record.lods.size(); ++i)
+  {
+    if (i != _record.lod)
+      _record.lods[i]->Destroy();
+  }
+  _record.lods.clear();
+
+  if (!_record.mesh.empty())
+  {
+    this->meshLoader->Release(_record.mesh);
+    _record.mesh.clear();
+  }
+  if (_record.material)
+  {
+    this->materialCache.Release(this->scene, _record.material);
+    _record.material.reset();
   }
 }
 
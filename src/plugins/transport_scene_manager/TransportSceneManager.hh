@@ -36,17 +36,121 @@ namespace plugins
   /// ## Configuration
   ///
   /// * \<service\> : Name of service where this system will request a scene
-  ///                 message. Optional, defaults to "/scene".
+  ///                 message. If a paged version of it, described in
+  ///                 PagedScene.hh, is advertised as "<service>/paged",
+  ///                 the scene is requested in pages instead, which are
+  ///                 loaded as they arrive. Topics are subscribed first,
+  ///                 and scene and deletion msgs received before the scene
+  ///                 are applied after it. Optional, defaults to "/scene".
+  /// * \<scene_page_size\> : Maximum number of models per page requested
+  ///                         from the paged scene service. Optional,
+  ///                         defaults to 1000.
+  /// * \<scene_page_timeout_ms\> : Time in milliseconds to wait for each
+  ///                               page of the paged scene service.
+  ///                               Optional, defaults to 5000.
   /// * \<pose_topic\> : Name of topic to subscribe to receive pose updates.
   ///                    Optional, defaults to "/pose".
+  /// * \<packed_pose_topic\> : Name of topic to subscribe to receive pose
+  ///                           updates packed into a msgs::Bytes, as
+  ///                           described in PackedPoses.hh. Much cheaper to
+  ///                           decode than Pose_V for large worlds.
+  ///                           Optional, not subscribed by default.
+  /// * \<interpolation_delay_ms\> : Enables pose interpolation. Entities are
+  ///                                rendered this far behind the latest
+  ///                                pose msg, blending their two latest
+  ///                                poses by the msg header stamps, so they
+  ///                                move smoothly at any frame rate. Set it
+  ///                                to the publishing period. Optional,
+  ///                                interpolation is disabled by default.
+  /// * \<extrapolation_ms\> : When interpolating, how far past their newest
+  ///                          pose entities keep moving if msgs are late.
+  ///                          Optional, defaults to 0.
+  /// * \<position_epsilon\> : Pose updates which move an entity less than
+  ///                          this many meters, and rotate it less than
+  ///                          <rotation_epsilon>, are not applied.
+  ///                          Optional, defaults to 1e-6.
+  /// * \<rotation_epsilon\> : Rotation in radians below which pose updates
+  ///                          are not applied. Optional, defaults to 1e-6.
   /// * \<deletion_topic\> : Name of topic to request entity deletions.
   ///                        Optional, defaults to "/delete".
   /// * \<scene_topic\> : Name of topic to receive scene updates. Optional,
   ///                     defaults to "/scene".
+  /// * \<load_budget_ms\> : Time in milliseconds spent creating entities of
+  ///                        newly received scenes on each frame. Entities
+  ///                        closest to the user camera are created first and
+  ///                        the rest are created on the following frames.
+  ///                        Zero or negative creates everything at once.
+  ///                        Optional, defaults to 10.
+  /// * \<mesh_loader_threads\> : Number of background threads used to parse
+  ///                             mesh files. Visuals are empty until their
+  ///                             mesh is parsed. Optional, defaults to a
+  ///                             number based on the available cores.
+  /// * \<mesh_retention\> : Number of meshes whose levels of detail are
+  ///                        kept in memory after the last visual using them
+  ///                        is deleted, so that they aren't simplified again
+  ///                        if entities using them are spawned again. Older
+  ///                        ones are freed first. Parsed meshes themselves
+  ///                        are shared through the gz-common mesh manager,
+  ///                        which keeps them. Optional, defaults to 64.
+  /// * \<mesh_lod_levels\> : Number of simplified levels of detail built
+  ///                         for large meshes, up to 3. Each level has a
+  ///                         quarter of the triangles of the previous one,
+  ///                         and is shown once the mesh covers less than
+  ///                         half the screen height, a quarter, and so on.
+  ///                         Levels are built in the background and cached
+  ///                         with \<scene_cache\>. Optional, defaults to 0,
+  ///                         which disables levels of detail.
+  /// * \<mesh_lod_min_triangles\> : Meshes with fewer triangles don't get
+  ///                                levels of detail. Optional, defaults
+  ///                                to 100000.
+  /// * \<scene_cache\> : Name of the world to cache on disk, under
+  ///                     ~/.ignition/gui/scene_cache. On startup, the
+  ///                     cached scene is shown right away, then only the
+  ///                     models and lights which differ from the scene
+  ///                     service reply are recreated. The cached scene is
+  ///                     rewritten in the background when they differ.
+  ///                     Parsed meshes are cached too, along with their
+  ///                     materials. Optional, disabled by default.
+  /// * \<instancing\> : True to draw opaque boxes, cylinders, spheres and
+  ///                    ellipsoids which share a material in batches, with
+  ///                    one draw call per batch. Instances keep their own
+  ///                    visuals, so they can be posed and deleted by id,
+  ///                    and picking them returns a child of their visual.
+  ///                    Optional, defaults to false.
   class TransportSceneManager : public Plugin
   {
     Q_OBJECT
 
+    /// \brief Number of pose updates applied to the scene during the last
+    /// second
+    Q_PROPERTY(
+      int appliedPoseUpdates
+      READ AppliedPoseUpdates
+      NOTIFY PoseUpdatesChanged
+    )
+
+    /// \brief Number of pose updates skipped during the last second because
+    /// the entity didn't move
+    Q_PROPERTY(
+      int skippedPoseUpdates
+      READ SkippedPoseUpdates
+      NOTIFY PoseUpdatesChanged
+    )
+
+    /// \brief Memory used by parsed meshes, in MiB
+    Q_PROPERTY(
+      double meshMemory
+      READ MeshMemory
+      NOTIFY ResourcesChanged
+    )
+
+    /// \brief Number of materials shared by the visuals
+    Q_PROPERTY(
+      int materialCount
+      READ MaterialCount
+      NOTIFY ResourcesChanged
+    )
+
     /// \brief Constructor
     public: TransportSceneManager();
 
@@ -57,6 +161,32 @@ namespace plugins
     public: virtual void LoadConfig(const tinyxml2::XMLElement *_pluginElem)
         override;
 
+    /// \brief Get the number of pose updates applied during the last second
+    /// \return Number of applied updates
+    public: Q_INVOKABLE int AppliedPoseUpdates() const;
+
+    /// \brief Get the number of pose updates skipped during the last second
+    /// \return Number of skipped updates
+    public: Q_INVOKABLE int SkippedPoseUpdates() const;
+
+    /// \brief Get the memory used by parsed meshes
+    /// \return Memory in MiB
+    public: Q_INVOKABLE double MeshMemory() const;
+
+    /// \brief Get the number of materials shared by the visuals
+    /// \return Number of materials
+    public: Q_INVOKABLE int MaterialCount() const;
+
+    /// \brief Notify that the pose update counts have changed
+    signals: void PoseUpdatesChanged();
+
+    /// \brief Notify that the resource usage has changed
+    signals: void ResourcesChanged();
+
+    /// \brief Callback in main thread when new pose update counts and
+    /// resource usage are available
+    public slots: void ProcessStats();
+
     // Documentation inherited
     private: bool eventFilter(QObject *_obj, QEvent *_event) override;
 
@@ -42,6 +42,24 @@ GridLayout {
           "<br><b>Scene topic</b>: /" + sceneTopic
   }
 
+  Label {
+    Layout.columnSpan: 1
+    Layout.fillWidth: true
+    wrapMode: Text.WordWrap
+    text: "<b>Pose updates per second</b>: " +
+          TransportSceneManager.appliedPoseUpdates + " applied, " +
+          TransportSceneManager.skippedPoseUpdates + " skipped"
+  }
+
+  Label {
+    Layout.columnSpan: 1
+    Layout.fillWidth: true
+    wrapMode: Text.WordWrap
+    text: "<b>Mesh memory</b>: " +
+          TransportSceneManager.meshMemory.toFixed(1) + " MiB" +
+          "<br><b>Materials</b>: " + TransportSceneManager.materialCount
+  }
+
 
   Item {
     Layout.columnSpan: 1
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_TRANSPORTSCENEMANAGER_TRIPLEBUFFER_HH_
+#define GZ_GUI_PLUGINS_TRANSPORTSCENEMANAGER_TRIPLEBUFFER_HH_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  /// \brief Lock-free, latest-wins handoff of values from one writer thread
+  /// to one reader thread.
+  ///
+  /// The writer fills the back buffer and publishes it, which atomically
+  /// swaps it with the middle buffer. The reader atomically swaps the middle
+  /// buffer with its front buffer whenever a new value has been published.
+  /// Neither side ever waits for the other. If the writer publishes several
+  /// values before the reader consumes, only the latest one is seen by the
+  /// reader and the others are dropped.
+  ///
+  /// Buffers are recycled, so values which own heap memory, such as vectors,
+  /// keep their capacity across frames.
+  /// \tparam T Buffered value type.
+  template <typename T>
+  class TripleBuffer
+  {
+    /// \brief Get the buffer to be filled by the writer. Only to be called
+    /// from the writer thread.
+    /// \return Back buffer.
+    public: T &Back()
+    {
+      return this->buffers[this->back];
+    }
+
+    /// \brief Make the back buffer available to the reader. Only to be called
+    /// from the writer thread. After this, Back() returns a recycled buffer
+    /// holding stale data.
+    public: void Publish()
+    {
+      const uint8_t previous = this->middle.exchange(
+          static_cast<uint8_t>(this->back | kFresh), std::memory_order_acq_rel);
+      this->back = previous & kIndexMask;
+      if (previous & kFresh)
+        this->dropped.fetch_add(1u, std::memory_order_relaxed);
+    }
+
+    /// \brief Whether the last published buffer is still waiting for the
+    /// reader. Only to be called from the writer thread.
+    /// \return True if the reader hasn't consumed the last published
+    /// buffer yet, false if it has or nothing was published.
+    public: bool Pending() const
+    {
+      return (this->middle.load(std::memory_order_acquire) & kFresh) != 0u;
+    }
+
+    /// \brief Swap in the latest published buffer, if there is one. Only to
+    /// be called from the reader thread.
+    /// \return True if a new buffer was swapped in and is available through
+    /// Front(), false if nothing was published since the last call.
+    public: bool Consume()
+    {
+      if (!(this->middle.load(std::memory_order_relaxed) & kFresh))
+        return false;
+
+      const uint8_t previous =
+          this->middle.exchange(this->front, std::memory_order_acq_rel);
+      this->front = previous & kIndexMask;
+      return true;
+    }
+
+    /// \brief Get the buffer last swapped in by Consume(). Only to be called
+    /// from the reader thread.
+    /// \return Front buffer.
+    public: T &Front()
+    {
+      return this->buffers[this->front];
+    }
+
+    /// \brief Number of published buffers which were replaced by a newer one
+    /// before the reader consumed them.
+    /// \return Number of dropped buffers.
+    public: uint64_t Dropped() const
+    {
+      return this->dropped.load(std::memory_order_relaxed);
+    }
+
+    /// \brief Flag set on the middle index when it holds an unread buffer.
+    private: static constexpr uint8_t kFresh = 0x4;
+
+    /// \brief Mask to extract a buffer index.
+    private: static constexpr uint8_t kIndexMask = 0x3;
+
+    /// \brief The three buffers.
+    private: std::array<T, 3> buffers;
+
+    /// \brief Index of the buffer owned by the writer.
+    private: uint8_t back{0u};
+
+    /// \brief Index of the buffer in transit, plus the kFresh flag.
+    private: std::atomic<uint8_t> middle{1u};
+
+    /// \brief Index of the buffer owned by the reader.
+    private: uint8_t front{2u};
+
+    /// \brief Number of dropped buffers.
+    private: std::atomic<uint64_t> dropped{0u};
+  };
+}
+}
+}
+
+#endif
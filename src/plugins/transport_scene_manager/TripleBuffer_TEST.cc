@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "gz/gui/config.hh"
+
+#include "TripleBuffer.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+TEST(TripleBufferTest, LatestWins)
+{
+  TripleBuffer<int> buffer;
+  EXPECT_FALSE(buffer.Consume());
+  EXPECT_FALSE(buffer.Pending());
+
+  buffer.Back() = 1;
+  buffer.Publish();
+  EXPECT_TRUE(buffer.Pending());
+  EXPECT_TRUE(buffer.Consume());
+  EXPECT_FALSE(buffer.Pending());
+  EXPECT_EQ(1, buffer.Front());
+  EXPECT_FALSE(buffer.Consume());
+  EXPECT_EQ(1, buffer.Front());
+
+  // Intermediate values are dropped
+  for (int i = 2; i <= 5; ++i)
+  {
+    buffer.Back() = i;
+    buffer.Publish();
+  }
+  EXPECT_EQ(3u, buffer.Dropped());
+  EXPECT_TRUE(buffer.Consume());
+  EXPECT_EQ(5, buffer.Front());
+  EXPECT_FALSE(buffer.Consume());
+}
+
+/////////////////////////////////////////////////
+TEST(TripleBufferTest, Threads)
+{
+  // The writer fills every element of a vector with the frame number, the
+  // reader checks that it never sees a partially written frame and that
+  // frames never go back in time.
+  TripleBuffer<std::vector<int>> buffer;
+  const int frames = 20000;
+
+  std::thread writer([&]()
+  {
+    for (int f = 1; f <= frames; ++f)
+    {
+      auto &back = buffer.Back();
+      back.assign(64, f);
+      buffer.Publish();
+    }
+  });
+
+  int last = 0;
+  while (last < frames)
+  {
+    if (!buffer.Consume())
+      continue;
+
+    const auto &front = buffer.Front();
+    ASSERT_EQ(64u, front.size());
+    for (auto v : front)
+      ASSERT_EQ(front[0], v);
+    ASSERT_GT(front[0], last);
+    last = front[0];
+  }
+  writer.join();
+  EXPECT_EQ(frames, last);
+}